@@ -0,0 +1,235 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#include "cmdbatch.hpp"
+#include "cmdindex.hpp"
+#include "cmdtoken.hpp"
+#include "format.hpp"
+
+#include <string.h>
+
+CmdBatch::CmdBatch(Stream &io, bool keepGoing, const char *endMark)
+{
+    begin(io, keepGoing, endMark);
+}
+
+CmdBatch::CmdBatch(void) : io(nullptr), keepGoing(false), endMark(nullptr),
+    done(true), len(0), overflow(false), afterCr(false), skip(false), lines(0), 
+    commands(0), failed(0), failLine(0), result(0), start(0), stop(0)
+{
+    line[0] = '\0';
+}
+
+void CmdBatch::begin(Stream &io, bool keepGoing, const char *endMark)
+{
+    this->io = &io;
+    this->keepGoing = keepGoing;
+    this->endMark = endMark;
+    done = false;
+    line[0] = '\0';
+    len = 0;
+    overflow = false;
+    afterCr = false;
+    skip = false;
+    lines = 0;
+    commands = 0;
+    failed = 0;
+    failLine = 0;
+    result = 0;
+    start = 0;
+    stop = 0;
+}
+
+size_t CmdBatch::feed(const char *data, size_t len)
+{
+    size_t n = 0;
+
+    if (done)
+    {
+        return 0;
+    }
+
+    if (lines == 0 && this->len == 0)
+    {
+        start = micros();
+    }
+
+    while (n < len)
+    {
+        char c = data[n++];
+
+        if (c == '\r' || c == '\n')
+        {
+            /* CR LF is a single line end. */
+            if (c == '\n' && afterCr)
+            {
+                afterCr = false;
+                continue;
+            }
+
+            afterCr = c == '\r';
+            run();
+            return n;
+        }
+
+        afterCr = false;
+
+        if (this->len < sizeof(line) - 1)
+        {
+            line[this->len++] = c;
+        }
+        else
+        {
+            overflow = true;
+        }
+    }
+
+    return n;
+}
+
+void CmdBatch::end(void)
+{
+    if (!done && len > 0)
+    {
+        run();
+    }
+
+    done = true;
+}
+
+bool CmdBatch::isDone(void) const
+{
+    return done;
+}
+
+uint32_t CmdBatch::getLines(void) const
+{
+    return lines;
+}
+
+uint32_t CmdBatch::getCommands(void) const
+{
+    return commands;
+}
+
+uint32_t CmdBatch::getFailed(void) const
+{
+    return failed;
+}
+
+int8_t CmdBatch::getResult(void) const
+{
+    return result;
+}
+
+void CmdBatch::summary(Stream &ioStream) const
+{
+    uint32_t us = stop - start;
+
+    FMT_PRINT(ioStream, "Batch: %lu lines, %lu commands, %lu failed", 
+        (unsigned long) lines, (unsigned long) commands, 
+        (unsigned long) failed);
+    if (result != 0 && !keepGoing)
+    {
+        FMT_PRINT(ioStream, ", stopped at line %lu", (unsigned long) failLine);
+    }
+    FMT_PRINT(ioStream, ", %lu us", (unsigned long) us);
+    if (us > 0)
+    {
+        FMT_PRINT(ioStream, ", %lu lines/s", 
+            (unsigned long) ((uint64_t) lines * 1000000 / us));
+    }
+    FMT_PRINT(ioStream, "\n");
+}
+
+void CmdBatch::run(void)
+{
+    const char *argv[CMDTOKEN_ARGVSIZ];
+    CmdTokens tokens;
+    const char *pStart = nullptr;
+    size_t argc = 0;
+    int8_t ret = 0;
+
+    line[len] = '\0';
+    len = 0;
+    stop = micros();
+
+    if (!overflow && endMark != nullptr && strcmp(line, endMark) == 0)
+    {
+        done = true;
+        return;
+    }
+
+    lines++;
+
+    if (skip)
+    {
+        overflow = false;
+        return;
+    }
+
+    /* Comments are skipped before splitting, they may contain quotes. */
+    pStart = &line[strspn(line, " \t")];
+    if (overflow)
+    {
+        overflow = false;
+        FMT_PRINT(*io, "Line %lu: too long\n", (unsigned long) lines);
+        ret = -1;
+    }
+    else if (*pStart == '\0' || *pStart == '#')
+    {
+        return;
+    }
+    else if (tokens.split(line) != 0)
+    {
+        FMT_PRINT(*io, "Line %lu: unterminated quote\n", (unsigned long) lines);
+        ret = -1;
+    }
+    else if ((argc = tokens.toArgv(argv, CMDTOKEN_ARGVSIZ)) > CMDTOKEN_ARGVSIZ)
+    {
+        FMT_PRINT(*io, "Line %lu: too many arguments\n", (unsigned long) lines);
+        ret = -1;
+    }
+    else
+    {
+        commands++;
+        ret = CmdIndex::exec(*io, tokens.first(), argv, argc);
+    }
+
+    stop = micros();
+    if (ret != 0)
+    {
+        if (failed++ == 0)
+        {
+            failLine = lines;
+            result = ret;
+        }
+        FMT_PRINT(*io, "Line %lu: Error: %d\n", (unsigned long) lines, ret);
+
+        /* The rest of a pasted script is still coming in, it is read up to 
+         * the end mark so that it does not end up in the Cli. */
+        skip = !keepGoing;
+        done = skip && endMark == nullptr;
+    }
+}
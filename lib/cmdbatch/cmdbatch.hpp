@@ -0,0 +1,154 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CMDBATCH_HPP_
+#define _CMDBATCH_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+/**
+ * @brief Runs a script of commands, line by line, straight through the 
+ * command index.
+ * 
+ * Pasting a script into the Cli costs an echo of every key, a prompt per line
+ * and a history entry per command. A CmdBatch is fed the script text in any 
+ * pieces and runs each complete line by CmdIndex::exec(), nothing is echoed 
+ * and the history is not touched. Empty lines and lines starting with '#' are
+ * skipped. Lines are split by CmdTokens, so arguments may be quoted and up to
+ * CMDTOKEN_ARGVSIZ of them are passed. The batch stops at the first command 
+ * failing, unless keepGoing is set, and summary() prints one line for the 
+ * whole script. With an end mark the lines after a failed command are still 
+ * read up to the mark, but not run.
+ */
+class CmdBatch
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param io        The stream passed to the commands.
+         * @param keepGoing Run the remaining lines after a failed command.
+         * @param endMark   Optional line which ends the script, e.g. "." for
+         *                  scripts pasted into the console.
+         */
+        CmdBatch(Stream &io, bool keepGoing = false, 
+            const char *endMark = nullptr);
+
+        /**
+         * @brief Constructor for static instances, begin() must be called 
+         * before use.
+         */
+        CmdBatch(void);
+
+        /**
+         * @brief Starts a new script, see the constructor for the arguments.
+         */
+        void begin(Stream &io, bool keepGoing = false, 
+            const char *endMark = nullptr);
+
+        /**
+         * @brief Feeds script text up to the end of the first complete line
+         * and runs that line.
+         * @return The number of bytes consumed, less than len if a line has 
+         * been run, 0 once the batch is done.
+         */
+        size_t feed(const char *data, size_t len);
+
+        /**
+         * @brief Ends the script, runs a last line without line end.
+         */
+        void end(void);
+
+        /**
+         * @brief Tells if the script has ended, the end mark has been read or
+         * a command failed in a script without end mark.
+         */
+        bool isDone(void) const;
+
+        /**
+         * @brief Returns the number of script lines, including skipped ones 
+         * but not the end mark.
+         */
+        uint32_t getLines(void) const;
+
+        /**
+         * @brief Returns the number of commands run.
+         */
+        uint32_t getCommands(void) const;
+
+        /**
+         * @brief Returns the number of failed commands.
+         */
+        uint32_t getFailed(void) const;
+
+        /**
+         * @brief Returns the result of the batch: 0 or the return value of 
+         * the first failed command.
+         */
+        int8_t getResult(void) const;
+
+        /**
+         * @brief Prints the number of lines, commands and failures, where the
+         * batch stopped and the rate.
+         */
+        void summary(Stream &ioStream) const;
+
+    private:
+
+        /**
+         * @brief Runs the collected line.
+         */
+        void run(void);
+
+        Stream *io;
+        bool keepGoing;
+        const char *endMark;
+        bool done;
+
+        char line[CLI_COMMANDSIZ];
+        size_t len;
+        bool overflow;
+        bool afterCr;
+
+        /**
+         * @brief Set after a failed command, the remaining lines are read 
+         * but not run.
+         */
+        bool skip;
+
+        uint32_t lines;
+        uint32_t commands;
+        uint32_t failed;
+        uint32_t failLine;
+        int8_t result;
+
+        /**
+         * @brief The time of the first and the last line in us.
+         */
+        uint32_t start;
+        uint32_t stop;
+};
+
+#endif /* _CMDBATCH_HPP_ */
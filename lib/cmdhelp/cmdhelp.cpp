@@ -0,0 +1,274 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#include "cmdhelp.hpp"
+#include "cmdindex.hpp"
+#include "format.hpp"
+
+#include <string.h>
+
+CmdHelp *CmdHelp::pFirst = nullptr;
+CmdHelp *CmdHelp::pLast = nullptr;
+
+/**
+ * @brief Writes a string from flash, up to its end or the first line end.
+ * @return The number of characters written.
+ */
+static size_t cmdHelpWrite(Print &io, const char *pStr, bool firstLine)
+{
+    char buf[32];
+    size_t total = 0;
+    size_t n = 0;
+
+    while (true)
+    {
+        char c = (char) pgm_read_byte(pStr++);
+
+        if (c == '\0' || (firstLine && c == '\n') || n == sizeof(buf))
+        {
+            io.write((const uint8_t *) buf, n);
+            total += n;
+            n = 0;
+        }
+
+        if (c == '\0' || (firstLine && c == '\n'))
+        {
+            return total;
+        }
+
+        buf[n++] = c;
+    }
+}
+
+/**
+ * @brief Compares a string in flash with one in RAM.
+ */
+static bool cmdHelpEqual(const char *pFlash, const char *pStr)
+{
+    while (true)
+    {
+        char a = (char) pgm_read_byte(pFlash++);
+        char b = *pStr++;
+
+        if (a != b)
+        {
+            return false;
+        }
+
+        if (a == '\0')
+        {
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Compares two strings in flash like strcmp().
+ */
+static int cmdHelpCompare(const char *pA, const char *pB)
+{
+    while (true)
+    {
+        uint8_t a = pgm_read_byte(pA++);
+        uint8_t b = pgm_read_byte(pB++);
+
+        if (a != b || a == '\0')
+        {
+            return (int) a - (int) b;
+        }
+    }
+}
+
+CmdHelp::CmdHelp(const cmdHelp_t *pHelp) : pHelp(pHelp), pNext(nullptr)
+{
+    if (pLast == nullptr)
+    {
+        pFirst = this;
+    }
+    else
+    {
+        pLast->pNext = this;
+    }
+    pLast = this;
+}
+
+const cmdHelp_t* CmdHelp::find(const char *name)
+{
+    CmdHelp *pEntry = lookup(name);
+
+    return pEntry != nullptr ? pEntry->pHelp : nullptr;
+}
+
+void CmdHelp::printAll(Print &io)
+{
+    const char *pGroup = nullptr;
+    size_t undocumented = 0;
+
+    /* Groups and the commands in them are sorted by name, the order of the
+     * registration depends on the link order. */
+    while ((pGroup = nextGroup(pGroup)) != nullptr)
+    {
+        io.print("\n");
+        cmdHelpWrite(io, pGroup, false);
+        io.print(":\n");
+        for (size_t i = 0; i < CmdIndex::getCnt(); i++)
+        {
+            CmdHelp *pEntry = lookup(CmdIndex::at(i)->name);
+            cmdHelp_t help;
+
+            if (pEntry == nullptr)
+            {
+                continue;
+            }
+
+            pEntry->load(help);
+            if (cmdHelpCompare(help.group, pGroup) == 0)
+            {
+                pEntry->printLine(io);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < CliCommand::getCmdCnt(); i++)
+    {
+        if (find(CliCommand::getTable()[i].name) == nullptr)
+        {
+            undocumented++;
+        }
+    }
+
+    if (undocumented > 0)
+    {
+        FMT_PRINT(io, "\n%lu more commands without help, see 'list'.\n", 
+            (unsigned long) undocumented);
+    }
+}
+
+CmdHelp* CmdHelp::lookup(const char *name)
+{
+    for (CmdHelp *pCur = pFirst; pCur != nullptr; pCur = pCur->pNext)
+    {
+        cmdHelp_t help;
+
+        pCur->load(help);
+        if (cmdHelpEqual(help.name, name))
+        {
+            return pCur;
+        }
+    }
+
+    return nullptr;
+}
+
+const char* CmdHelp::nextGroup(const char *pAfter)
+{
+    const char *pNext = nullptr;
+
+    for (size_t i = 0; i < CmdIndex::getCnt(); i++)
+    {
+        CmdHelp *pEntry = lookup(CmdIndex::at(i)->name);
+        cmdHelp_t help;
+
+        if (pEntry == nullptr)
+        {
+            continue;
+        }
+
+        pEntry->load(help);
+        if ((pAfter == nullptr || cmdHelpCompare(help.group, pAfter) > 0) &&
+            (pNext == nullptr || cmdHelpCompare(help.group, pNext) < 0))
+        {
+            pNext = help.group;
+        }
+    }
+
+    return pNext;
+}
+
+int8_t CmdHelp::print(Print &io, const char *name)
+{
+    const cmdHelp_t *pFound = find(name);
+    cmdHelp_t help;
+
+    if (CmdIndex::find(name) == nullptr)
+    {
+        FMT_PRINT(io, "help: unknown command %s\n", name);
+        return -1;
+    }
+
+    if (pFound == nullptr)
+    {
+        FMT_PRINT(io, "help: no help for %s\n", name);
+        return -2;
+    }
+
+    memcpy_P(&help, pFound, sizeof(help));
+    FMT_PRINT(io, "Usage: %s", name);
+    if (pgm_read_byte(help.usage) != '\0')
+    {
+        io.print(" ");
+        cmdHelpWrite(io, help.usage, false);
+    }
+    io.print("\n");
+    cmdHelpWrite(io, help.text, false);
+    io.print("\n");
+
+    return 0;
+}
+
+void CmdHelp::load(cmdHelp_t &help) const
+{
+    memcpy_P(&help, pHelp, sizeof(help));
+}
+
+void CmdHelp::printLine(Print &io) const
+{
+    cmdHelp_t help;
+    size_t n = 2;
+
+    load(help);
+    io.print("  ");
+    n += cmdHelpWrite(io, help.name, false);
+    if (pgm_read_byte(help.usage) != '\0')
+    {
+        io.print(" ");
+        n += 1 + cmdHelpWrite(io, help.usage, false);
+    }
+
+    /* Long usages get the description on a line of its own. */
+    if (n + 1 >= CMDHELP_COLUMN)
+    {
+        io.print("\n");
+        n = 0;
+    }
+
+    do
+    {
+        io.print(" ");
+    }
+    while (++n < CMDHELP_COLUMN);
+
+    cmdHelpWrite(io, help.text, true);
+    io.print("\n");
+}
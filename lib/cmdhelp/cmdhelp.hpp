@@ -0,0 +1,139 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CMDHELP_HPP_
+#define _CMDHELP_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+/**
+ * @brief The column the description starts at in the help overview.
+ */
+#ifndef CMDHELP_COLUMN
+#define CMDHELP_COLUMN          31
+#endif
+
+/**
+ * @brief The help of a command, kept in flash together with its strings.
+ */
+typedef struct
+{
+    const char *name;
+    const char *group;
+    const char *usage;
+    const char *text;
+
+} cmdHelp_t;
+
+/**
+ * @brief Adds help to a command, put it next to CLI_COMMAND(). All strings
+ * are stored in flash (PROGMEM), only the registration takes RAM.
+ * @param _name   The name of the command, as given to CLI_COMMAND().
+ * @param _group  The title of the group the command is listed in.
+ * @param _usage  The arguments, e.g. "0|1|b", may be empty.
+ * @param _text   The description, the first line is shown in the overview, 
+ *                all of it by "help <cmd>".
+ */
+#define CLI_HELP(_name, _group, _usage, _text)                              \
+    static const char cmdHelpName_##_name[] PROGMEM = #_name;               \
+    static const char cmdHelpGroup_##_name[] PROGMEM = _group;              \
+    static const char cmdHelpUsage_##_name[] PROGMEM = _usage;              \
+    static const char cmdHelpText_##_name[] PROGMEM = _text;                \
+    static const cmdHelp_t cmdHelpData_##_name PROGMEM = {                  \
+        cmdHelpName_##_name, cmdHelpGroup_##_name, cmdHelpUsage_##_name,    \
+        cmdHelpText_##_name};                                               \
+    static CmdHelp cmdHelp_##_name(&cmdHelpData_##_name)
+
+/**
+ * @brief Registers the help of a command and prints it, streamed from flash
+ * in small pieces.
+ * 
+ * Help is listed for the commands registered in the command table only, so 
+ * the output always matches the real command set. Commands without help are
+ * counted in the overview.
+ */
+class CmdHelp
+{
+    public:
+
+        /**
+         * @brief Registers the help, used by CLI_HELP().
+         */
+        CmdHelp(const cmdHelp_t *pHelp);
+
+        /**
+         * @brief Returns the help of the given command.
+         * @return The help in flash or nullptr if there is none.
+         */
+        static const cmdHelp_t* find(const char *name);
+
+        /**
+         * @brief Prints all registered commands with help, by group with 
+         * the first line of the text. Groups and commands are sorted by 
+         * name.
+         */
+        static void printAll(Print &io);
+
+        /**
+         * @brief Prints the usage and the full text of the given command.
+         * @return 0, -1 for an unknown command, -2 if it has no help.
+         */
+        static int8_t print(Print &io, const char *name);
+
+    private:
+
+        /**
+         * @brief Copies the help from flash.
+         */
+        void load(cmdHelp_t &help) const;
+
+        /**
+         * @brief Returns the registration of the given command's help, 
+         * nullptr if there is none.
+         */
+        static CmdHelp* lookup(const char *name);
+
+        /**
+         * @brief Returns the group following pAfter by name, among the 
+         * commands in the command table, nullptr after the last one.
+         */
+        static const char* nextGroup(const char *pAfter);
+
+        /**
+         * @brief Prints the overview line of the command.
+         */
+        void printLine(Print &io) const;
+
+        const cmdHelp_t *pHelp;
+        CmdHelp *pNext;
+
+        /**
+         * @brief The list in the order of registration.
+         */
+        static CmdHelp *pFirst;
+        static CmdHelp *pLast;
+};
+
+#endif /* _CMDHELP_HPP_ */
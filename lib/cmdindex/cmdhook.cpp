@@ -0,0 +1,126 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#include "cmdhook.hpp"
+
+cliCmdFunc_t CmdHook::orig[CLI_COMMANDS_MAX];
+const char *CmdHook::names[CLI_COMMANDS_MAX];
+size_t CmdHook::cnt = 0;
+cmdHookFunc_t CmdHook::hooks[CMDHOOK_MAX];
+size_t CmdHook::hookCnt = 0;
+
+/**
+ * @brief The wrapper of the n-th command.
+ */
+template<size_t N>
+static int8_t cmdHookWrapper(Stream &ioStream, size_t argc, 
+    const char *argv[])
+{
+    return CmdHook::next(N, 0, ioStream, argc, argv);
+}
+
+/* A compile time list of 0 .. CLI_COMMANDS_MAX - 1, C++11 has no 
+ * std::index_sequence yet. */
+template<size_t... I>
+struct CmdHookSeq {};
+
+template<size_t N, size_t... I>
+struct CmdHookMakeSeq : CmdHookMakeSeq<N - 1, N - 1, I...> {};
+
+template<size_t... I>
+struct CmdHookMakeSeq<0, I...>
+{
+    typedef CmdHookSeq<I...> type;
+};
+
+/**
+ * @brief Returns the table of all wrappers, which is constant and therefore 
+ * stays in flash.
+ */
+template<size_t... I>
+static const cliCmdFunc_t* cmdHookWrappers(CmdHookSeq<I...>)
+{
+    static const cliCmdFunc_t wrappers[] = {&cmdHookWrapper<I>...};
+    return wrappers;
+}
+
+static const cliCmdFunc_t* cmdHookWrappers(void)
+{
+    return cmdHookWrappers(typename CmdHookMakeSeq<CLI_COMMANDS_MAX>::type());
+}
+
+bool CmdHook::add(cmdHookFunc_t func)
+{
+    const cliCmdFunc_t *pWrappers = cmdHookWrappers();
+    cliCmd_t *pTab = CliCommand::getTable();
+    size_t n = CliCommand::getCmdCnt();
+
+    if (hookCnt == CMDHOOK_MAX || func == nullptr)
+    {
+        return false;
+    }
+
+    hooks[hookCnt++] = func;
+
+    for (size_t i = 0; i < n && cnt < CLI_COMMANDS_MAX; i++)
+    {
+        bool wrapped = false;
+
+        for (size_t j = 0; j < cnt && !wrapped; j++)
+        {
+            wrapped = pTab[i].pfunc == pWrappers[j];
+        }
+
+        if (!wrapped)
+        {
+            orig[cnt] = pTab[i].pfunc;
+            names[cnt] = pTab[i].name;
+            pTab[i].pfunc = pWrappers[cnt];
+            cnt++;
+        }
+    }
+
+    return true;
+}
+
+size_t CmdHook::getCnt(void)
+{
+    return cnt;
+}
+
+const char* CmdHook::getName(size_t cmd)
+{
+    return cmd < cnt ? names[cmd] : nullptr;
+}
+
+int8_t CmdHook::next(size_t cmd, size_t stage, Stream &ioStream, 
+    size_t argc, const char *argv[])
+{
+    if (stage < hookCnt)
+    {
+        return hooks[stage](cmd, stage, ioStream, argc, argv);
+    }
+
+    return orig[cmd](ioStream, argc, argv);
+}
@@ -0,0 +1,99 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CMDHOOK_HPP_
+#define _CMDHOOK_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+/**
+ * @brief The maximum number of hooks.
+ */
+#ifndef CMDHOOK_MAX
+#define CMDHOOK_MAX             4
+#endif
+
+/**
+ * @brief A hook run instead of a command, it must run the command by calling
+ * CmdHook::next() with stage + 1, usually with its own stream or arguments.
+ * @param cmd       The slot of the command, see CmdHook::getName().
+ * @param stage     The position of the hook in the chain.
+ */
+typedef int8_t (*cmdHookFunc_t)(size_t cmd, size_t stage, Stream &ioStream, 
+    size_t argc, const char *argv[]);
+
+/**
+ * @brief Puts a chain of hooks in front of every command.
+ * 
+ * libCli dispatches through the function pointer in the command table, so 
+ * the pointers are replaced by wrappers generated at compile time, one per 
+ * slot of the table. A wrapper runs the hooks in the order they have been 
+ * added, the last one calls the original function. This catches commands run
+ * from the Cli as well as those run by CmdIndex::exec(). Everything is kept 
+ * in static arrays with CLI_COMMANDS_MAX entries, nothing is allocated.
+ */
+class CmdHook
+{
+    public:
+
+        /**
+         * @brief Adds a hook and installs the wrappers on all commands of the
+         * table which do not have one yet, to be called in setup().
+         * @return false if the hook could not be added.
+         */
+        static bool add(cmdHookFunc_t func);
+
+        /**
+         * @brief Returns the number of wrapped commands.
+         */
+        static size_t getCnt(void);
+
+        /**
+         * @brief Returns the name of the command in the given slot, slots are
+         * numbered in the order the wrappers have been installed.
+         */
+        static const char* getName(size_t cmd);
+
+        /**
+         * @brief Runs the hook of the given stage or, after the last one, 
+         * the command itself.
+         */
+        static int8_t next(size_t cmd, size_t stage, Stream &ioStream, 
+            size_t argc, const char *argv[]);
+
+    private:
+
+        /**
+         * @brief The original functions and names of the wrapped commands.
+         */
+        static cliCmdFunc_t orig[CLI_COMMANDS_MAX];
+        static const char *names[CLI_COMMANDS_MAX];
+        static size_t cnt;
+
+        static cmdHookFunc_t hooks[CMDHOOK_MAX];
+        static size_t hookCnt;
+};
+
+#endif /* _CMDHOOK_HPP_ */
@@ -0,0 +1,197 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#include "cmdindex.hpp"
+#include "format.hpp"
+
+#include <string.h>
+
+cmdidx_t CmdIndex::order[CLI_COMMANDS_MAX];
+size_t CmdIndex::cnt = 0;
+
+void CmdIndex::build(void)
+{
+    cliCmd_t *pTab = CliCommand::getTable();
+    size_t n = CliCommand::getCmdCnt();
+
+    /* Insertion sort, runs once and is presorted if libcli sorts the table. */
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t j = i;
+
+        while (j > 0 && strcmp(pTab[order[j - 1]].name, pTab[i].name) > 0)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = (cmdidx_t) i;
+    }
+
+    cnt = n;
+}
+
+const cliCmd_t* CmdIndex::find(const char *name)
+{
+    cliCmd_t *pTab = CliCommand::getTable();
+    size_t lo = 0;
+    size_t hi = 0;
+
+    if (name == nullptr)
+    {
+        return nullptr;
+    }
+
+    update();
+    hi = cnt;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(name, pTab[order[mid]].name);
+
+        if (cmp == 0)
+        {
+            return &pTab[order[mid]];
+        }
+
+        if (cmp < 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    return nullptr;
+}
+
+int8_t CmdIndex::exec(Stream &ioStream, const char *name, 
+    const char *argv[], size_t argc)
+{
+    const cliCmd_t *pCmd = find(name);
+
+    if (pCmd == nullptr)
+    {
+        FMT_PRINT(ioStream, "Unknown command: %s\n", name ? name : "");
+        return -1;
+    }
+
+    return pCmd->pfunc(ioStream, argc, argv);
+}
+
+size_t CmdIndex::bound(const char *prefix, size_t len, bool upper)
+{
+    cliCmd_t *pTab = CliCommand::getTable();
+    size_t lo = 0;
+    size_t hi = cnt;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strncmp(pTab[order[mid]].name, prefix, len);
+
+        if (cmp < 0 || (upper && cmp == 0))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+size_t CmdIndex::prefixRange(const char *prefix, size_t len, size_t *pFirst)
+{
+    size_t first = 0;
+    size_t last = 0;
+
+    if (prefix == nullptr)
+    {
+        len = 0;
+        prefix = "";
+    }
+
+    update();
+    first = bound(prefix, len, false);
+    last = bound(prefix, len, true);
+
+    if (pFirst != nullptr)
+    {
+        *pFirst = first;
+    }
+
+    return last - first;
+}
+
+size_t CmdIndex::commonPrefix(const char *prefix, size_t len, size_t *pCnt)
+{
+    size_t first = 0;
+    size_t n = prefixRange(prefix, len, &first);
+    const char *pFirst = nullptr;
+    const char *pLast = nullptr;
+
+    if (prefix == nullptr)
+    {
+        len = 0;
+    }
+
+    if (pCnt != nullptr)
+    {
+        *pCnt = n;
+    }
+
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    pFirst = at(first)->name;
+    pLast = at(first + n - 1)->name;
+    while (pFirst[len] != '\0' && pFirst[len] == pLast[len])
+    {
+        len++;
+    }
+
+    return len;
+}
+
+size_t CmdIndex::getCnt(void)
+{
+    update();
+    return cnt;
+}
+
+const cliCmd_t* CmdIndex::at(size_t n)
+{
+    update();
+    if (n >= cnt)
+    {
+        return nullptr;
+    }
+
+    return &CliCommand::getTable()[order[n]];
+}
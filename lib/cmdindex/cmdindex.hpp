@@ -0,0 +1,152 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _CMDINDEX_HPP_
+#define _CMDINDEX_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+/**
+ * @brief The type used to store positions in the command table, one byte is
+ * enough for the usual number of commands.
+ */
+#if CLI_COMMANDS_MAX <= 0xFF
+typedef uint8_t cmdidx_t;
+#else
+typedef uint16_t cmdidx_t;
+#endif
+
+/**
+ * @brief A sorted index over the command table of libcli.
+ * 
+ * CliCommand::exec() finds a command by comparing the name with every entry 
+ * of the table. The index keeps the table positions sorted by name, so a 
+ * lookup takes O(log n) string compares. Commands register themselves during
+ * static initialization, therefore the index is built on first use and built 
+ * again whenever the number of registered commands changed.
+ */
+class CmdIndex
+{
+    public:
+
+        /**
+         * @brief Returns the table entry of the given command.
+         * @param name   The name of the command.
+         * @return The entry or nullptr if there is no such command.
+         */
+        static const cliCmd_t* find(const char *name);
+
+        /**
+         * @brief Executes the given command, same as CliCommand::exec().
+         * @param ioStream  The stream to use for input and output.
+         * @param name      The name of the command.
+         * @param argv      The arguments, may be nullptr if argc is 0.
+         * @param argc      The number of arguments.
+         * @return The return value of the command, -1 if it is not found.
+         */
+        static int8_t exec(Stream &ioStream, const char *name, 
+            const char *argv[], size_t argc);
+
+        /**
+         * @brief Finds all commands starting with the given prefix.
+         * 
+         * As the index is sorted, all matches are next to each other. Two 
+         * binary searches find the borders of that range, so the cost does 
+         * not depend on the size of the command table. Use at() to get the 
+         * candidates.
+         * 
+         * @param prefix  The prefix, an empty prefix matches all commands.
+         * @param len     The length of the prefix.
+         * @param pFirst  Returns the index of the first match.
+         * @return The number of matching commands.
+         */
+        static size_t prefixRange(const char *prefix, size_t len, 
+            size_t *pFirst);
+
+        /**
+         * @brief Returns the longest common prefix of all commands starting 
+         * with the given prefix, which is what tab completion should extend 
+         * the input to. 
+         * 
+         * Only the first and the last command of the range have to be 
+         * compared as the range is sorted.
+         * 
+         * @param prefix  The prefix as typed by the user.
+         * @param len     The length of the prefix.
+         * @param pCnt    Returns the number of candidates, may be nullptr.
+         * @return The length of the common prefix, which is at least len if
+         * there is a candidate and 0 if there is none. The characters are 
+         * the first ones of at(first)->name.
+         */
+        static size_t commonPrefix(const char *prefix, size_t len, 
+            size_t *pCnt);
+
+        /**
+         * @brief Returns the number of entries in the index.
+         */
+        static size_t getCnt(void);
+
+        /**
+         * @brief Returns the n-th entry in alphabetical order.
+         * @return The entry or nullptr if n is out of range.
+         */
+        static const cliCmd_t* at(size_t n);
+
+        /**
+         * @brief Builds the index, not needed to be called by the user.
+         */
+        static void build(void);
+
+    private:
+
+        /**
+         * @brief Returns the first position in the index for which the name
+         * compares larger than the prefix, or larger or equal if @p upper is
+         * false.
+         */
+        static size_t bound(const char *prefix, size_t len, bool upper);
+
+        /**
+         * @brief Builds the index if the command table has changed.
+         */
+        static void update(void)
+        {
+            if (cnt != CliCommand::getCmdCnt())
+            {
+                build();
+            }
+        }
+
+        /**
+         * @brief Positions in the command table, sorted by command name.
+         */
+        static cmdidx_t order[CLI_COMMANDS_MAX];
+
+        /**
+         * @brief The number of commands in the index.
+         */
+        static size_t cnt;
+};
+
+#endif /* _CMDINDEX_HPP_ */
@@ -0,0 +1,205 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#include "cmdstats.hpp"
+
+#if CMDSTATS
+
+#include <string.h>
+
+cmdStats_t CmdStats::stats[CLI_COMMANDS_MAX];
+bool CmdStats::attached = false;
+
+/**
+ * @brief Passes everything on to the stream of the caller and counts the
+ * bytes written.
+ */
+class CmdStatsStream : public Stream
+{
+    public:
+
+        CmdStatsStream(Stream &io, CmdStatsStream *pPrev, size_t n) : 
+            io(&io), pPrev(pPrev), n(n), bytes(0) {}
+
+        int available(void) override
+        {
+            return io->available();
+        }
+
+        int read(void) override
+        {
+            return io->read();
+        }
+
+        int peek(void) override
+        {
+            return io->peek();
+        }
+
+        void flush(void) override
+        {
+            io->flush();
+        }
+
+        size_t write(uint8_t c) override
+        {
+            bytes++;
+            return io->write(c);
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) override
+        {
+            bytes += size;
+            return io->write(buffer, size);
+        }
+
+        using Print::write;
+
+        Stream *io;
+
+        /**
+         * @brief The stream of the calling command when commands are nested.
+         */
+        CmdStatsStream *pPrev;
+
+        /**
+         * @brief The slot of the command.
+         */
+        size_t n;
+
+        uint32_t bytes;
+};
+
+/**
+ * @brief The innermost counting stream of the commands running right now.
+ */
+static CmdStatsStream *pActive = nullptr;
+
+void CmdStats::attach(void)
+{
+    if (!attached)
+    {
+        attached = CmdHook::add(hook);
+    }
+}
+
+size_t CmdStats::getCnt(void)
+{
+    return attached ? CmdHook::getCnt() : 0;
+}
+
+const cmdStats_t* CmdStats::get(size_t n)
+{
+    if (n >= getCnt())
+    {
+        return nullptr;
+    }
+
+    stats[n].name = CmdHook::getName(n);
+    return &stats[n];
+}
+
+void CmdStats::reset(void)
+{
+    for (size_t i = 0; i < CLI_COMMANDS_MAX; i++)
+    {
+        const char *name = stats[i].name;
+
+        memset(&stats[i], 0, sizeof(stats[i]));
+        stats[i].name = name;
+    }
+}
+
+Stream& CmdStats::stream(Stream &io)
+{
+    Stream *p = &io;
+
+    for (CmdStatsStream *pWrap = pActive; pWrap != nullptr; 
+        pWrap = pWrap->pPrev)
+    {
+        if (p == pWrap)
+        {
+            p = pWrap->io;
+        }
+    }
+
+    return *p;
+}
+
+size_t CmdStats::current(void)
+{
+    return pActive != nullptr ? pActive->n : SIZE_MAX;
+}
+
+int8_t CmdStats::resume(size_t n, Stream &ioStream, cmdStatsFunc_t func,
+    void *pArg)
+{
+    CmdStatsStream io(ioStream, pActive, n);
+    uint32_t start = 0;
+    uint32_t cost = 0;
+    int8_t ret = 0;
+
+    if (n >= getCnt())
+    {
+        return func(ioStream, pArg);
+    }
+
+    pActive = &io;
+    start = CMDSTATS_NOW();
+    ret = func(io, pArg);
+    cost = CMDSTATS_NOW() - start;
+    pActive = io.pPrev;
+
+    record(n, cost, io.bytes);
+
+    return ret;
+}
+
+void CmdStats::record(size_t n, uint32_t cost, uint32_t bytes)
+{
+    stats[n].total += cost;
+    stats[n].max = cost > stats[n].max ? cost : stats[n].max;
+    stats[n].bytes += bytes;
+}
+
+int8_t CmdStats::hook(size_t n, size_t stage, Stream &ioStream, 
+    size_t argc, const char *argv[])
+{
+    CmdStatsStream io(ioStream, pActive, n);
+    uint32_t start = 0;
+    uint32_t cost = 0;
+    int8_t ret = 0;
+
+    pActive = &io;
+    start = CMDSTATS_NOW();
+    ret = CmdHook::next(n, stage + 1, io, argc, argv);
+    cost = CMDSTATS_NOW() - start;
+    pActive = io.pPrev;
+
+    stats[n].calls++;
+    record(n, cost, io.bytes);
+
+    return ret;
+}
+
+#endif /* CMDSTATS */
@@ -0,0 +1,171 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _CMDSTATS_HPP_
+#define _CMDSTATS_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+#include "cmdhook.hpp"
+
+/**
+ * @brief Enables the per command profiler, off by default so that the 
+ * resource usage is the same as without it.
+ */
+#ifndef CMDSTATS
+#define CMDSTATS                0
+#endif
+
+#if CMDSTATS
+
+/**
+ * @brief The time base of the profiler, CPU cycles where the core provides a
+ * cycle counter, micro seconds otherwise. Cycles wrap after 2^32, so a single
+ * run longer than that (~18 s at 240 MHz) is not measured correctly.
+ */
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+#define CMDSTATS_NOW()          ESP.getCycleCount()
+#define CMDSTATS_UNIT           "cycles"
+#else
+#define CMDSTATS_NOW()          micros()
+#define CMDSTATS_UNIT           "us"
+#endif
+
+/**
+ * @brief The profile of a single command.
+ */
+typedef struct {
+
+    /**
+     * @brief The name of the command.
+     */
+    const char *name;
+
+    /**
+     * @brief The number of invocations.
+     */
+    uint32_t calls;
+
+    /**
+     * @brief The longest run or resumed step, see CMDSTATS_UNIT.
+     */
+    uint32_t max;
+
+    /**
+     * @brief The sum of all runs and resumed steps, see CMDSTATS_UNIT.
+     */
+    uint64_t total;
+
+    /**
+     * @brief The number of bytes written by all runs.
+     */
+    uint32_t bytes;
+
+} cmdStats_t;
+
+/**
+ * @brief A further step of a command, see CmdStats::resume().
+ */
+typedef int8_t (*cmdStatsFunc_t)(Stream &ioStream, void *pArg);
+
+/**
+ * @brief Counts invocations, execution time and output of every command.
+ * 
+ * attach() adds a CmdHook which measures the command and counts its output.
+ * This catches commands run from the Cli as well as those run by 
+ * CmdIndex::exec(). The counters are kept in a static array with 
+ * CLI_COMMANDS_MAX entries, nothing is allocated.
+ * 
+ * A command continuing after it returned, e.g. a CmdJob, takes current() 
+ * and runs its later steps through resume(), so that they are added to it.
+ */
+class CmdStats
+{
+    public:
+
+        /**
+         * @brief Adds the profiler to all commands, to be called in setup().
+         */
+        static void attach(void);
+
+        /**
+         * @brief Returns the number of profiled commands.
+         */
+        static size_t getCnt(void);
+
+        /**
+         * @brief Returns the profile of the command in slot n, see 
+         * CmdHook::getName().
+         */
+        static const cmdStats_t* get(size_t n);
+
+        /**
+         * @brief Clears all counters.
+         */
+        static void reset(void);
+
+        /**
+         * @brief Commands get a counting stream wrapped around the stream of
+         * the Cli, this returns the stream of the Cli for it. Any other 
+         * stream is returned as it is.
+         */
+        static Stream& stream(Stream &io);
+
+        /**
+         * @brief Returns the slot of the innermost command running right 
+         * now, SIZE_MAX if there is none.
+         */
+        static size_t current(void);
+
+        /**
+         * @brief Runs a further step of the command in slot n and adds its 
+         * time and output to that command, without counting a call. Any 
+         * other n just runs the step.
+         */
+        static int8_t resume(size_t n, Stream &ioStream, cmdStatsFunc_t func,
+            void *pArg);
+
+    private:
+
+        /**
+         * @brief Runs the command in slot n and records it.
+         */
+        static int8_t hook(size_t n, size_t stage, Stream &ioStream, 
+            size_t argc, const char *argv[]);
+
+        /**
+         * @brief Adds a run or step to the profile of slot n.
+         */
+        static void record(size_t n, uint32_t cost, uint32_t bytes);
+
+        /**
+         * @brief The profiles.
+         */
+        static cmdStats_t stats[CLI_COMMANDS_MAX];
+
+        static bool attached;
+};
+
+#endif /* CMDSTATS */
+
+#endif /* _CMDSTATS_HPP_ */
@@ -0,0 +1,416 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#include "cmdjob.hpp"
+#include "cmdstats.hpp"
+#include "format.hpp"
+
+#include <string.h>
+
+CmdJob *CmdJob::pFirst = nullptr;
+
+CmdJob::CmdJob(Stream &io) : CmdJob()
+{
+    this->io = &io;
+}
+
+CmdJob::CmdJob(void) : io(nullptr), func(nullptr), pArg(nullptr), step(0), 
+    stats(SIZE_MAX), input(false), ctrlC(false), in(*this), holdLen(0), 
+    aheadLen(0), aheadPos(0), pNext(pFirst)
+{
+    pFirst = this;
+}
+
+CmdJob::~CmdJob()
+{
+    CmdJob **ppJob = &pFirst;
+
+    while (*ppJob != nullptr && *ppJob != this)
+    {
+        ppJob = &(*ppJob)->pNext;
+    }
+
+    if (*ppJob == this)
+    {
+        *ppJob = pNext;
+    }
+}
+
+void CmdJob::setStream(Stream &io)
+{
+    abort();
+    this->io = &io;
+}
+
+int8_t CmdJob::start(Stream &ioStream, cmdJobFunc_t func, void *pArg, 
+    bool input)
+{
+    CmdJob *pJob = find(ioStream);
+    uint32_t step = 0;
+    int8_t ret = 0;
+
+    if (pJob != nullptr)
+    {
+        /* The first step runs inside the command, so its output goes 
+         * through the stream of the command. */
+        pJob->input = input;
+        ret = func(input ? (Stream&) pJob->in : ioStream, 0, pArg);
+        if (ret == CMDJOB_MORE)
+        {
+            pJob->func = func;
+            pJob->pArg = pArg;
+            pJob->step = 1;
+#if CMDSTATS
+            pJob->stats = CmdStats::current();
+#endif
+            ret = 0;
+
+            if (pJob->ctrlC)
+            {
+                pJob->interrupt();
+            }
+        }
+        else
+        {
+            pJob->input = false;
+            pJob->ctrlC = false;
+        }
+
+        return ret;
+    }
+
+    if (input)
+    {
+        return CMDJOB_NOCONSOLE;
+    }
+
+    do
+    {
+        ret = func(ioStream, step++, pArg);
+    } 
+    while (ret == CMDJOB_MORE);
+
+    return ret;
+}
+
+bool CmdJob::isConsole(Stream &ioStream)
+{
+    return find(ioStream) != nullptr;
+}
+
+bool CmdJob::isBusy(void) const
+{
+    return func != nullptr;
+}
+
+bool CmdJob::isReading(void) const
+{
+    return input;
+}
+
+bool CmdJob::isAnyBusy(void)
+{
+    for (CmdJob *pJob = pFirst; pJob != nullptr; pJob = pJob->pNext)
+    {
+        if (pJob->isBusy())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CmdJob::cancel(void)
+{
+    if (func != nullptr)
+    {
+        step = CMDJOB_CANCEL;
+        run(*io);
+        finish(0);
+    }
+}
+
+void CmdJob::abort(void)
+{
+    holdLen = 0;
+    aheadLen = 0;
+    aheadPos = 0;
+    cancel();
+}
+
+int CmdJob::available(void)
+{
+    if (func != nullptr)
+    {
+        resume();
+        if (func != nullptr)
+        {
+            return 0;
+        }
+    }
+
+    return (int) (aheadLen - aheadPos) + io->available();
+}
+
+int CmdJob::read(void)
+{
+    if (func != nullptr)
+    {
+        return -1;
+    }
+
+    return take();
+}
+
+int CmdJob::peek(void)
+{
+    if (func != nullptr)
+    {
+        return -1;
+    }
+
+    return aheadPos < aheadLen ? ahead[aheadPos] : io->peek();
+}
+
+size_t CmdJob::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t CmdJob::write(const uint8_t *data, size_t size)
+{
+    if (func == nullptr)
+    {
+        return io->write(data, size);
+    }
+
+    if (holdLen + size > sizeof(hold))
+    {
+        /* Does not fit, keep the order and let it through. */
+        io->write(hold, holdLen);
+        holdLen = 0;
+        return io->write(data, size);
+    }
+
+    memcpy(&hold[holdLen], data, size);
+    holdLen += size;
+
+    return size;
+}
+
+void CmdJob::flush(void)
+{
+    io->flush();
+}
+
+CmdJob* CmdJob::find(Stream &ioStream)
+{
+    Stream *pIo = &ioStream;
+
+#if CMDSTATS
+    pIo = &CmdStats::stream(ioStream);
+#endif
+
+    for (CmdJob *pJob = pFirst; pJob != nullptr; pJob = pJob->pNext)
+    {
+        if (pJob == pIo && pJob->func == nullptr)
+        {
+            return pJob;
+        }
+    }
+
+    return nullptr;
+}
+
+Stream& CmdJob::jobStream(void)
+{
+    return input ? (Stream&) in : *io;
+}
+
+int CmdJob::take(void)
+{
+    int c = -1;
+
+    if (aheadPos == aheadLen)
+    {
+        return io->read();
+    }
+
+    c = ahead[aheadPos++];
+    if (aheadPos == aheadLen)
+    {
+        aheadLen = 0;
+        aheadPos = 0;
+    }
+
+    return c;
+}
+
+int8_t CmdJob::run(Stream &ioStream)
+{
+#if CMDSTATS
+    return CmdStats::resume(stats, ioStream, runStep, this);
+#else
+    return func(ioStream, step, pArg);
+#endif
+}
+
+int8_t CmdJob::runStep(Stream &ioStream, void *pJob)
+{
+    CmdJob *p = (CmdJob*) pJob;
+
+    return p->func(ioStream, p->step, p->pArg);
+}
+
+void CmdJob::resume(void)
+{
+    int8_t ret = 0;
+
+    /* Ctrl-C may follow other keys, which must not block it. Once the 
+     * buffer is full the input is left where it is, nothing is lost. A job
+     * reading the console gets its input through Input instead. */
+    while (!input && aheadLen < sizeof(ahead) && io->available() > 0)
+    {
+        int c = io->read();
+
+        if (c == CMDJOB_CTRL_C)
+        {
+            interrupt();
+            return;
+        }
+
+        if (c >= 0)
+        {
+            ahead[aheadLen++] = (uint8_t) c;
+        }
+    }
+
+    ret = run(jobStream());
+    step++;
+    if (ret != CMDJOB_MORE)
+    {
+        finish(ret);
+    }
+    else if (ctrlC)
+    {
+        interrupt();
+    }
+}
+
+void CmdJob::interrupt(void)
+{
+    aheadLen = 0;
+    aheadPos = 0;
+    io->print("^C\n");
+    cancel();
+}
+
+void CmdJob::finish(int8_t ret)
+{
+    func = nullptr;
+    pArg = nullptr;
+    stats = SIZE_MAX;
+    input = false;
+    ctrlC = false;
+
+    if (ret != 0)
+    {
+        FMT_PRINT(*io, "Error: %d\n", ret);
+    }
+
+    if (holdLen > 0)
+    {
+        io->write(hold, holdLen);
+        holdLen = 0;
+    }
+}
+
+CmdJob::Input::Input(CmdJob &job) : job(job)
+{
+
+}
+
+int CmdJob::Input::available(void)
+{
+    if (job.ctrlC)
+    {
+        return 0;
+    }
+
+    return (int) (job.aheadLen - job.aheadPos) + job.io->available();
+}
+
+int CmdJob::Input::read(void)
+{
+    int c = job.ctrlC ? -1 : job.take();
+
+    if (c == CMDJOB_CTRL_C)
+    {
+        job.ctrlC = true;
+        c = -1;
+    }
+
+    return c;
+}
+
+int CmdJob::Input::peek(void)
+{
+    int c = -1;
+
+    if (job.ctrlC)
+    {
+        return -1;
+    }
+
+    if (job.aheadPos < job.aheadLen)
+    {
+        return job.ahead[job.aheadPos];
+    }
+
+    c = job.io->peek();
+    if (c == CMDJOB_CTRL_C)
+    {
+        job.io->read();
+        job.ctrlC = true;
+        c = -1;
+    }
+
+    return c;
+}
+
+size_t CmdJob::Input::write(uint8_t c)
+{
+    return job.io->write(c);
+}
+
+size_t CmdJob::Input::write(const uint8_t *data, size_t size)
+{
+    return job.io->write(data, size);
+}
+
+void CmdJob::Input::flush(void)
+{
+    job.io->flush();
+}
@@ -0,0 +1,285 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CMDJOB_HPP_
+#define _CMDJOB_HPP_
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @brief Returned by a job step to be called again on the next Cli::loop().
+ */
+#define CMDJOB_MORE             INT8_MIN
+
+/**
+ * @brief The step passed to a job when it is cancelled, so that it can clean
+ * up. Its return value is ignored.
+ */
+#define CMDJOB_CANCEL           UINT32_MAX
+
+/**
+ * @brief The key cancelling a job.
+ */
+#define CMDJOB_CTRL_C           0x03
+
+/**
+ * @brief Returned by CmdJob::start() for a job reading the console if there is
+ * no CmdJob to run it on.
+ */
+#define CMDJOB_NOCONSOLE        (INT8_MIN + 1)
+
+/**
+ * @brief The size of the buffer holding the output of the Cli, i.e. the 
+ * prompt, while a job runs.
+ */
+#ifndef CMDJOB_HOLDSIZ
+#define CMDJOB_HOLDSIZ          64
+#endif
+
+/**
+ * @brief The size of the buffer holding the keys typed while a job runs. 
+ * Further keys stay in the underlying stream, a Ctrl-C behind them is seen 
+ * once the job is done. Not used by jobs reading the console themselves.
+ */
+#ifndef CMDJOB_AHEADSIZ
+#define CMDJOB_AHEADSIZ         16
+#endif
+
+/**
+ * @brief A step of a resumable command.
+ * @param ioStream  The stream of the console.
+ * @param step      0 on the first call, counting up on every further one, 
+ *                  CMDJOB_CANCEL if the job has been cancelled.
+ * @param pArg      The argument passed to CmdJob::start().
+ * @return CMDJOB_MORE to be called again, else the result of the command.
+ */
+typedef int8_t (*cmdJobFunc_t)(Stream &ioStream, uint32_t step, void *pArg);
+
+/**
+ * @brief Runs long commands in steps, one per Cli::loop(), so that they do not
+ * block the main loop.
+ * 
+ * libCli runs a command to completion inside Cli::loop(). A CmdJob is put 
+ * between the Cli and the stream of a console. A command hands its work to 
+ * start() and returns, the Cli then asks the CmdJob for input on every 
+ * Cli::loop(). While a job is running, available() runs the next step instead
+ * and reports no input, so the Cli does nothing else. The input is read 
+ * before each step: Ctrl-C cancels the job and drops the keys typed before, 
+ * any other key is kept for the Cli until the job is done. What the Cli 
+ * prints in the meantime, i.e. the prompt, is held back as well.
+ * 
+ * A job reading the console itself, e.g. a pasted script, is started with 
+ * input set. Its input is not read before the steps, the job reads it through
+ * the stream passed to it instead. That stream ends at Ctrl-C, which cancels
+ * the job after the step.
+ * 
+ * Commands not calling start() are not affected.
+ */
+class CmdJob : public Stream
+{
+    public:
+
+        CmdJob(Stream &io);
+
+        /**
+         * @brief Constructor for members, setStream() must be called before
+         * use.
+         */
+        CmdJob(void);
+
+        ~CmdJob();
+
+        /**
+         * @brief Sets the underlying stream, a running job is aborted.
+         */
+        void setStream(Stream &io);
+
+        /**
+         * @brief Starts a job on the console of the given command stream and 
+         * runs its first step. Without a CmdJob on that stream, e.g. when 
+         * called by CmdIndex::exec(), the job is run to completion.
+         * @param input true if the job reads the console, see CmdJob. Such
+         *              a job is refused without a CmdJob, e.g. in a pipe or
+         *              in rpc mode, as nothing would end its wait for input.
+         * @return The result of the job if it is done, 0 if it continues,
+         *         CMDJOB_NOCONSOLE if the job has been refused.
+         */
+        static int8_t start(Stream &ioStream, cmdJobFunc_t func, 
+            void *pArg = nullptr, bool input = false);
+
+        /**
+         * @brief Tells if there is a CmdJob on the console of the given 
+         * command stream, i.e. if a job started on it runs in steps.
+         */
+        static bool isConsole(Stream &ioStream);
+
+        /**
+         * @brief Tells if a job is running.
+         */
+        bool isBusy(void) const;
+
+        /**
+         * @brief Tells if the running job reads the console, see start().
+         */
+        bool isReading(void) const;
+
+        /**
+         * @brief Tells if a job is running on any console.
+         */
+        static bool isAnyBusy(void);
+
+        /**
+         * @brief Cancels the running job.
+         */
+        void cancel(void);
+
+        /**
+         * @brief Cancels the running job and drops the output held back and
+         * the keys typed ahead, for a console which has gone away.
+         */
+        void abort(void);
+
+        int available(void) override;
+        int read(void) override;
+        int peek(void) override;
+
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t *data, size_t size) override;
+        using Print::write;
+
+        void flush(void) override;
+
+    private:
+
+        /**
+         * @brief The stream passed to a job reading the console. It reads 
+         * through the type-ahead buffer and ends at Ctrl-C.
+         */
+        class Input : public Stream
+        {
+            public:
+
+                Input(CmdJob &job);
+
+                int available(void) override;
+                int read(void) override;
+                int peek(void) override;
+
+                size_t write(uint8_t c) override;
+                size_t write(const uint8_t *data, size_t size) override;
+                using Print::write;
+
+                void flush(void) override;
+
+            private:
+
+                CmdJob &job;
+        };
+
+        /**
+         * @brief Returns the CmdJob of the given command stream, nullptr if
+         * there is none.
+         */
+        static CmdJob* find(Stream &ioStream);
+
+        /**
+         * @brief Returns the stream passed to the steps of the job.
+         */
+        Stream& jobStream(void);
+
+        /**
+         * @brief Reads the next key, from the type-ahead buffer first.
+         */
+        int take(void);
+
+        /**
+         * @brief Runs the current step, on CmdStats if enabled so that it is
+         * added to the command which started the job.
+         */
+        int8_t run(Stream &ioStream);
+
+        /**
+         * @brief Runs the current step of the given CmdJob, see run().
+         */
+        static int8_t runStep(Stream &ioStream, void *pJob);
+
+        /**
+         * @brief Runs the next step or cancels the job on Ctrl-C.
+         */
+        void resume(void);
+
+        /**
+         * @brief Cancels the job on Ctrl-C and drops the keys typed before.
+         */
+        void interrupt(void);
+
+        /**
+         * @brief Ends the job and passes the held output on.
+         */
+        void finish(int8_t ret);
+
+        Stream *io;
+        cmdJobFunc_t func;
+        void *pArg;
+        uint32_t step;
+
+        /**
+         * @brief The CmdStats slot of the command which started the job, 
+         * SIZE_MAX if there is none.
+         */
+        size_t stats;
+
+        /**
+         * @brief Set if the job reads the console, see start().
+         */
+        bool input;
+
+        /**
+         * @brief Set once a job reading the console got Ctrl-C.
+         */
+        bool ctrlC;
+        Input in;
+
+        /**
+         * @brief Output of the Cli held back while a job is running.
+         */
+        uint8_t hold[CMDJOB_HOLDSIZ];
+        size_t holdLen;
+
+        /**
+         * @brief Keys typed while a job is running, read by the Cli after it.
+         */
+        uint8_t ahead[CMDJOB_AHEADSIZ];
+        size_t aheadLen;
+        size_t aheadPos;
+
+        /**
+         * @brief All CmdJob instances, to find the one of a command stream.
+         */
+        CmdJob *pNext;
+        static CmdJob *pFirst;
+};
+
+#endif /* _CMDJOB_HPP_ */
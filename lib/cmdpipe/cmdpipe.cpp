@@ -0,0 +1,368 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#include "cmdpipe.hpp"
+#include "cmdhook.hpp"
+#include "format.hpp"
+
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+/**
+ * @brief Tells if the pattern is found in the first len bytes of text.
+ */
+static bool cmdPipeMatch(const char *text, size_t len, const char *pattern, 
+    bool nocase)
+{
+    size_t plen = strlen(pattern);
+
+    for (size_t i = 0; i + plen <= len; i++)
+    {
+        size_t k = 0;
+
+        while (k < plen && (nocase ? 
+            tolower((uint8_t) text[i + k]) == tolower((uint8_t) pattern[k]) :
+            text[i + k] == pattern[k]))
+        {
+            k++;
+        }
+
+        if (k == plen)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+CmdFilter::CmdFilter(void) : kind(grep), pNext(nullptr), pPattern(""), 
+    invert(false), nocase(false), limit(CMDPIPE_LINES), lines(0), 
+    pass(false), len(0), first(true), ringHead(0), ringUsed(0), ringLines(0)
+{
+}
+
+bool CmdFilter::begin(Stream &next, size_t argc, const char *argv[])
+{
+    size_t i = 1;
+
+    pNext = &next;
+    if (argc == 0)
+    {
+        return false;
+    }
+
+    if (strcmp(argv[0], "grep") == 0)
+    {
+        kind = grep;
+        for (; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+        {
+            if (strcmp(argv[i], "-v") == 0)
+            {
+                invert = true;
+            }
+            else if (strcmp(argv[i], "-i") == 0)
+            {
+                nocase = true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if (i + 1 != argc)
+        {
+            return false;
+        }
+        pPattern = argv[i];
+
+        return true;
+    }
+
+    if (strcmp(argv[0], "head") == 0 || strcmp(argv[0], "tail") == 0)
+    {
+        kind = argv[0][0] == 'h' ? head : tail;
+        if (argc == 2)
+        {
+            char *pEnd = nullptr;
+
+            limit = strtoul(argv[1], &pEnd, 10);
+            return *pEnd == '\0' && limit > 0;
+        }
+
+        return argc == 1;
+    }
+
+    if (strcmp(argv[0], "count") == 0)
+    {
+        kind = count;
+        return argc == 1;
+    }
+
+    return false;
+}
+
+void CmdFilter::end(void)
+{
+    if (len > 0 || !first)
+    {
+        piece(true);
+    }
+
+    if (kind == tail)
+    {
+        size_t start = (ringHead + CMDPIPE_TAILSIZ - ringUsed) % CMDPIPE_TAILSIZ;
+        size_t n = CMDPIPE_TAILSIZ - start < ringUsed ? 
+            CMDPIPE_TAILSIZ - start : ringUsed;
+
+        pNext->write((const uint8_t *) &ring[start], n);
+        pNext->write((const uint8_t *) &ring[0], ringUsed - n);
+        ringUsed = 0;
+    }
+    else if (kind == count)
+    {
+        FMT_PRINT(*pNext, "%lu\n", (unsigned long) lines);
+    }
+}
+
+int CmdFilter::available(void)
+{
+    return pNext->available();
+}
+
+int CmdFilter::read(void)
+{
+    return pNext->read();
+}
+
+int CmdFilter::peek(void)
+{
+    return pNext->peek();
+}
+
+size_t CmdFilter::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        piece(true);
+        return 1;
+    }
+
+    line[len++] = (char) c;
+    if (len == sizeof(line))
+    {
+        piece(false);
+    }
+
+    return 1;
+}
+
+size_t CmdFilter::write(const uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        write(data[i]);
+    }
+
+    return size;
+}
+
+void CmdFilter::flush(void)
+{
+    pNext->flush();
+}
+
+void CmdFilter::piece(bool last)
+{
+    switch (kind)
+    {
+        case grep:
+            if (first)
+            {
+                pass = cmdPipeMatch(line, len, pPattern, nocase) != invert;
+            }
+            if (pass)
+            {
+                pNext->write((const uint8_t *) line, len);
+                if (last)
+                {
+                    pNext->write('\n');
+                }
+            }
+            break;
+
+        case head:
+            if (lines < limit)
+            {
+                pNext->write((const uint8_t *) line, len);
+                if (last)
+                {
+                    pNext->write('\n');
+                }
+            }
+            break;
+
+        case tail:
+            tailPush(line, len, last);
+            break;
+
+        case count:
+            break;
+    }
+
+    if (last)
+    {
+        lines++;
+    }
+    len = 0;
+    first = last;
+}
+
+void CmdFilter::tailPush(const char *data, size_t len, bool last)
+{
+    size_t need = len + (last ? 1 : 0);
+
+    if (need > CMDPIPE_TAILSIZ)
+    {
+        data += need - CMDPIPE_TAILSIZ;
+        len -= need - CMDPIPE_TAILSIZ;
+        need = CMDPIPE_TAILSIZ;
+    }
+
+    while (ringUsed + need > CMDPIPE_TAILSIZ)
+    {
+        tailDrop();
+    }
+
+    for (size_t i = 0; i < need; i++)
+    {
+        ring[ringHead] = i < len ? data[i] : '\n';
+        ringHead = (ringHead + 1) % CMDPIPE_TAILSIZ;
+    }
+    ringUsed += need;
+
+    if (last)
+    {
+        ringLines++;
+        while (ringLines > limit)
+        {
+            tailDrop();
+        }
+    }
+}
+
+void CmdFilter::tailDrop(void)
+{
+    size_t pos = (ringHead + CMDPIPE_TAILSIZ - ringUsed) % CMDPIPE_TAILSIZ;
+
+    while (ringUsed > 0)
+    {
+        char c = ring[pos];
+
+        pos = (pos + 1) % CMDPIPE_TAILSIZ;
+        ringUsed--;
+        if (c == '\n')
+        {
+            ringLines--;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Runs a command with its output passed through the filters, kept 
+ * apart from the hook so that the filters only take stack space when used.
+ * @param pos   The position of the first "|" in argv.
+ */
+static int8_t __attribute__((noinline)) cmdPipeRun(size_t n, size_t stage, 
+    Stream &ioStream, size_t argc, const char *argv[], size_t pos)
+{
+    CmdFilter filters[CMDPIPE_STAGES];
+    Stream *pOut = &ioStream;
+    size_t cnt = 0;
+    size_t end = argc;
+    int8_t ret = 0;
+
+    /* Set up from the last filter to the first, each one writes to the one
+     * after it. */
+    for (size_t i = argc; i-- > pos;)
+    {
+        if (strcmp(argv[i], "|") != 0)
+        {
+            continue;
+        }
+
+        if (cnt == CMDPIPE_STAGES)
+        {
+            FMT_PRINT(ioStream, "At most %u filters\n", 
+                (unsigned int) CMDPIPE_STAGES);
+            return -1;
+        }
+
+        if (!filters[cnt].begin(*pOut, end - i - 1, &argv[i + 1]))
+        {
+            FMT_PRINT(ioStream, "Bad filter: %s\n", 
+                i + 1 < end ? argv[i + 1] : "");
+            return -1;
+        }
+
+        pOut = &filters[cnt++];
+        end = i;
+    }
+
+    ret = CmdHook::next(n, stage + 1, *pOut, pos, argv);
+
+    for (size_t i = cnt; i-- > 0;)
+    {
+        filters[i].end();
+    }
+
+    return ret;
+}
+
+void CmdPipe::attach(void)
+{
+    static bool attached = false;
+
+    if (!attached)
+    {
+        attached = CmdHook::add(hook);
+    }
+}
+
+int8_t CmdPipe::hook(size_t n, size_t stage, Stream &ioStream, size_t argc,
+    const char *argv[])
+{
+    for (size_t i = 0; i < argc; i++)
+    {
+        if (strcmp(argv[i], "|") == 0)
+        {
+            return cmdPipeRun(n, stage, ioStream, argc, argv, i);
+        }
+    }
+
+    return CmdHook::next(n, stage + 1, ioStream, argc, argv);
+}
@@ -0,0 +1,187 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CMDPIPE_HPP_
+#define _CMDPIPE_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+/**
+ * @brief The maximum number of filters after a command.
+ */
+#ifndef CMDPIPE_STAGES
+#define CMDPIPE_STAGES          2
+#endif
+
+/**
+ * @brief The line buffer of a filter, grep only looks at the first 
+ * CMDPIPE_LINESIZ - 1 characters of a line.
+ */
+#ifndef CMDPIPE_LINESIZ
+#define CMDPIPE_LINESIZ         80
+#endif
+
+/**
+ * @brief The buffer of tail, older lines are dropped if the last lines do not 
+ * fit.
+ */
+#ifndef CMDPIPE_TAILSIZ
+#define CMDPIPE_TAILSIZ         256
+#endif
+
+/**
+ * @brief The number of lines of head and tail without argument.
+ */
+#define CMDPIPE_LINES           10
+
+/**
+ * @brief A Stream which filters the output of a command line by line and 
+ * passes the result on to another stream. Input passes through unchanged.
+ * 
+ * Output is collected in a line buffer of CMDPIPE_LINESIZ bytes and handled
+ * once the line is complete. Longer lines are handled in pieces, the first 
+ * piece decides on grep. Only tail keeps more than a line, in a ring of 
+ * CMDPIPE_TAILSIZ bytes.
+ */
+class CmdFilter : public Stream
+{
+    public:
+
+        CmdFilter(void);
+
+        /**
+         * @brief Sets up the filter from its arguments.
+         * @param next  The stream to pass the result to.
+         * @return false if the filter is unknown or the arguments are wrong.
+         */
+        bool begin(Stream &next, size_t argc, const char *argv[]);
+
+        /**
+         * @brief Handles a last line without line end and prints what the 
+         * filter has kept back, to be called once the command is done.
+         */
+        void end(void);
+
+        int available(void) override;
+        int read(void) override;
+        int peek(void) override;
+
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t *data, size_t size) override;
+        using Print::write;
+
+        void flush(void) override;
+
+    private:
+
+        /**
+         * @brief Handles the collected piece of a line.
+         * @param last  The piece ends the line.
+         */
+        void piece(bool last);
+
+        /**
+         * @brief Appends a piece to the tail ring, dropping the oldest lines 
+         * if needed.
+         */
+        void tailPush(const char *data, size_t len, bool last);
+
+        /**
+         * @brief Drops the oldest line from the tail ring.
+         */
+        void tailDrop(void);
+
+        enum {
+            grep = 0,
+            head,
+            tail,
+            count
+        } kind;
+
+        Stream *pNext;
+
+        /**
+         * @brief The grep pattern and options.
+         */
+        const char *pPattern;
+        bool invert;
+        bool nocase;
+
+        /**
+         * @brief The number of lines of head and tail.
+         */
+        uint32_t limit;
+
+        /**
+         * @brief The number of complete lines seen.
+         */
+        uint32_t lines;
+
+        /**
+         * @brief Tells if the rest of a long line is passed on.
+         */
+        bool pass;
+
+        char line[CMDPIPE_LINESIZ];
+        size_t len;
+        bool first;
+
+        /**
+         * @brief The ring of tail and the number of complete lines in it.
+         */
+        char ring[CMDPIPE_TAILSIZ];
+        size_t ringHead;
+        size_t ringUsed;
+        uint32_t ringLines;
+};
+
+/**
+ * @brief Adds the pipe operator to all commands: "cmd args | filter args" 
+ * runs cmd with its output passed through the filter. The filters are
+ * grep [-v] [-i] pattern, head [n], tail [n] and count, up to CMDPIPE_STAGES 
+ * of them can be chained. Commands do not know that they are filtered, 
+ * resumable commands run to completion.
+ */
+class CmdPipe
+{
+    public:
+
+        /**
+         * @brief Adds the pipe operator to all commands, to be called in 
+         * setup().
+         */
+        static void attach(void);
+
+    private:
+
+        /**
+         * @brief Splits the arguments at "|" and runs the command with its 
+         * output passed through the filters.
+         */
+        static int8_t hook(size_t n, size_t stage, Stream &ioStream, 
+            size_t argc, const char *argv[]);
+};
+
+#endif /* _CMDPIPE_HPP_ */
@@ -0,0 +1,403 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#include "cmdrpc.hpp"
+#include "cmdtoken.hpp"
+
+#include <string.h>
+
+static_assert(CMDRPC_CHUNK + 4 <= 254, "CMDRPC_CHUNK exceeds a COBS block");
+
+/**
+ * @brief COBS encodes len bytes, which are at most 254.
+ * @return The length of the encoded data, len + 1.
+ */
+static size_t cmdRpcEncode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    uint8_t *pCode = dst;
+    uint8_t *pDst = dst + 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        if (src[i] == 0)
+        {
+            *pCode = code;
+            pCode = pDst++;
+            code = 1;
+        }
+        else
+        {
+            *pDst++ = src[i];
+            code++;
+        }
+    }
+    *pCode = code;
+
+    return pDst - dst;
+}
+
+/**
+ * @brief Decodes COBS data in place.
+ * @return The length of the decoded data, 0 if it is broken.
+ */
+static size_t cmdRpcDecode(uint8_t *data, size_t len)
+{
+    size_t r = 0;
+    size_t w = 0;
+
+    while (r < len)
+    {
+        uint8_t code = data[r++];
+
+        if (code == 0 || r + code - 1 > len)
+        {
+            return 0;
+        }
+
+        for (uint8_t k = 1; k < code; k++)
+        {
+            data[w++] = data[r++];
+        }
+
+        if (code != 0xFF && r < len)
+        {
+            data[w++] = 0;
+        }
+    }
+
+    return w;
+}
+
+CmdRpc::CmdRpc(Stream &io) : io(&io), active(false), rxLen(0), 
+    rxOverflow(false), out(*this), frames(0), errors(0)
+{
+}
+
+void CmdRpc::setStream(Stream &io)
+{
+    this->io = &io;
+    active = false;
+}
+
+void CmdRpc::begin(void)
+{
+    active = true;
+    rxLen = 0;
+    rxOverflow = false;
+    io->write((uint8_t) 0);
+}
+
+bool CmdRpc::isActive(void) const
+{
+    return active;
+}
+
+uint32_t CmdRpc::getFrames(void) const
+{
+    return frames;
+}
+
+uint32_t CmdRpc::getErrors(void) const
+{
+    return errors;
+}
+
+size_t CmdRpc::pack(uint8_t *frame, size_t len, uint8_t *dst)
+{
+    uint16_t crc = crc16(frame, len);
+    size_t n = 0;
+
+    frame[len] = (uint8_t) crc;
+    frame[len + 1] = (uint8_t) (crc >> 8);
+    n = cmdRpcEncode(frame, len + 2, dst);
+    dst[n++] = 0;
+
+    return n;
+}
+
+size_t CmdRpc::unpack(uint8_t *frame, size_t len)
+{
+    size_t n = cmdRpcDecode(frame, len);
+    uint16_t crc = 0;
+
+    if (n < 4)
+    {
+        return 0;
+    }
+
+    n -= 2;
+    crc = frame[n] | (uint16_t) frame[n + 1] << 8;
+
+    return crc == crc16(frame, n) ? n : 0;
+}
+
+uint16_t CmdRpc::crc16(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (len-- > 0)
+    {
+        crc ^= (uint16_t) *data++ << 8;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+
+    return crc;
+}
+
+int CmdRpc::available(void)
+{
+    if (!active)
+    {
+        return io->available();
+    }
+
+    while (active && io->available() > 0)
+    {
+        int c = io->read();
+
+        if (c < 0)
+        {
+            break;
+        }
+
+        if (c != 0)
+        {
+            if (rxLen < sizeof(rx))
+            {
+                rx[rxLen++] = (uint8_t) c;
+            }
+            else
+            {
+                rxOverflow = true;
+            }
+        }
+        else if (rxLen > 0 || rxOverflow)
+        {
+            handle();
+            rxLen = 0;
+            rxOverflow = false;
+            break;
+        }
+    }
+
+    return 0;
+}
+
+int CmdRpc::read(void)
+{
+    return active ? -1 : io->read();
+}
+
+int CmdRpc::peek(void)
+{
+    return active ? -1 : io->peek();
+}
+
+size_t CmdRpc::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t CmdRpc::write(const uint8_t *data, size_t size)
+{
+    return active ? size : io->write(data, size);
+}
+
+void CmdRpc::flush(void)
+{
+    io->flush();
+}
+
+void CmdRpc::handle(void)
+{
+    size_t len = rxOverflow ? 0 : unpack(rx, rxLen);
+    uint8_t seq = 0;
+
+    frames++;
+    if (len < 2)
+    {
+        errors++;
+        reply(CMDRPC_ERROR, 0, CMDRPC_EFRAME);
+        return;
+    }
+
+    seq = rx[1];
+    switch (rx[0])
+    {
+        case CMDRPC_CALL:
+            call(seq, &rx[2], len - 2);
+            break;
+
+        case CMDRPC_LIST:
+            out.begin(seq);
+            for (size_t i = 0; i < CliCommand::getCmdCnt(); i++)
+            {
+                out.print(CliCommand::getTable()[i].name);
+                out.write('\n');
+            }
+            out.end(0);
+            break;
+
+        case CMDRPC_EXIT:
+            reply(CMDRPC_RESULT, seq, 0);
+            active = false;
+            break;
+
+        default:
+            errors++;
+            reply(CMDRPC_ERROR, seq, CMDRPC_ETYPE);
+            break;
+    }
+}
+
+void CmdRpc::call(uint8_t seq, const uint8_t *payload, size_t len)
+{
+    const char *argv[CMDTOKEN_ARGVSIZ];
+    size_t argc = 0;
+    size_t idx = 0;
+    size_t pos = 3;
+
+    if (len < 3)
+    {
+        errors++;
+        reply(CMDRPC_ERROR, seq, CMDRPC_EFRAME);
+        return;
+    }
+
+    idx = payload[0] | (size_t) payload[1] << 8;
+    argc = payload[2];
+    if (idx >= CliCommand::getCmdCnt())
+    {
+        errors++;
+        reply(CMDRPC_ERROR, seq, CMDRPC_EINDEX);
+        return;
+    }
+
+    if (argc > CMDTOKEN_ARGVSIZ)
+    {
+        errors++;
+        reply(CMDRPC_ERROR, seq, CMDRPC_EARGS);
+        return;
+    }
+
+    /* The arguments are used in place, each has to end within the frame. */
+    for (size_t i = 0; i < argc; i++)
+    {
+        const uint8_t *pEnd = pos < len ? 
+            (const uint8_t *) memchr(&payload[pos], 0, len - pos) : nullptr;
+
+        if (pEnd == nullptr)
+        {
+            errors++;
+            reply(CMDRPC_ERROR, seq, CMDRPC_EARGS);
+            return;
+        }
+
+        argv[i] = (const char *) &payload[pos];
+        pos = pEnd - payload + 1;
+    }
+
+    out.begin(seq);
+    out.end(CliCommand::getTable()[idx].pfunc(out, argc, argv));
+}
+
+void CmdRpc::reply(uint8_t type, uint8_t seq, uint8_t value)
+{
+    uint8_t frame[5] = {type, seq, value};
+
+    send(frame, 3);
+}
+
+void CmdRpc::send(uint8_t *frame, size_t len)
+{
+    io->write(tx, pack(frame, len, tx));
+}
+
+void CmdRpc::Output::begin(uint8_t seq)
+{
+    this->seq = seq;
+    len = 0;
+}
+
+void CmdRpc::Output::end(int8_t ret)
+{
+    flush();
+    rpc.reply(CMDRPC_RESULT, seq, (uint8_t) ret);
+}
+
+int CmdRpc::Output::available(void)
+{
+    return 0;
+}
+
+int CmdRpc::Output::read(void)
+{
+    return -1;
+}
+
+int CmdRpc::Output::peek(void)
+{
+    return -1;
+}
+
+size_t CmdRpc::Output::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t CmdRpc::Output::write(const uint8_t *data, size_t size)
+{
+    size_t n = size;
+
+    while (n > 0)
+    {
+        size_t chunk = CMDRPC_CHUNK - len < n ? CMDRPC_CHUNK - len : n;
+
+        memcpy(&frame[2 + len], data, chunk);
+        len += chunk;
+        data += chunk;
+        n -= chunk;
+        if (len == CMDRPC_CHUNK)
+        {
+            flush();
+        }
+    }
+
+    return size;
+}
+
+void CmdRpc::Output::flush(void)
+{
+    if (len > 0)
+    {
+        frame[0] = CMDRPC_OUTPUT;
+        frame[1] = seq;
+        rpc.send(frame, 2 + len);
+        len = 0;
+    }
+}
@@ -0,0 +1,236 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CMDRPC_HPP_
+#define _CMDRPC_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+/**
+ * @brief The largest number of output bytes sent in one frame.
+ */
+#ifndef CMDRPC_CHUNK
+#define CMDRPC_CHUNK            128
+#endif
+
+/**
+ * @brief The receive buffer, large enough for a request carrying a full 
+ * command line.
+ */
+#define CMDRPC_RXSIZ            (CLI_COMMANDSIZ + 16)
+
+/**
+ * @brief The transmit buffer, large enough for an encoded output frame.
+ */
+#define CMDRPC_TXSIZ            (CMDRPC_CHUNK + 8)
+
+/**
+ * @brief The frame types, the first byte of every frame.
+ */
+#define CMDRPC_CALL             'C'
+#define CMDRPC_LIST             'L'
+#define CMDRPC_EXIT             'X'
+#define CMDRPC_OUTPUT           'O'
+#define CMDRPC_RESULT           'R'
+#define CMDRPC_ERROR            'E'
+
+/**
+ * @brief The error codes of an error frame.
+ */
+#define CMDRPC_EFRAME           1
+#define CMDRPC_ETYPE            2
+#define CMDRPC_EINDEX           3
+#define CMDRPC_EARGS            4
+
+/**
+ * @brief A Stream placed between the terminal stream and the Cli, or its 
+ * SearchStream, which adds a binary machine mode to the console.
+ * 
+ * In text mode all data passes through unchanged. begin() switches to 
+ * machine mode: then the Cli gets no input and its output, i.e. echo and 
+ * prompt, is dropped. Requests are decoded and run by this stream, straight 
+ * through the command table, with nothing parsed, echoed or drawn.
+ * 
+ * Every frame is COBS encoded and ends with a 0x00, the decoded frame is
+ * [type][seq][payload][crc16 lo][crc16 hi], the CRC-16/CCITT-FALSE over type,
+ * seq and payload. Requests:
+ *   - CMDRPC_CALL: [index lo][index hi][argc][argv[0] NUL]...[argv[n] NUL], 
+ *     index is the position in CliCommand::getTable().
+ *   - CMDRPC_LIST: no payload, the output lists the names of the table, one
+ *     per line, the line number is the index.
+ *   - CMDRPC_EXIT: no payload, back to text mode after the result.
+ * 
+ * Responses carry the seq of the request:
+ *   - CMDRPC_OUTPUT: up to CMDRPC_CHUNK bytes of output of the command.
+ *   - CMDRPC_RESULT: [ret], the return value of the command, always last.
+ *   - CMDRPC_ERROR: [code], if the request has not been run.
+ * 
+ * The host discards all bytes up to the first 0x00 after switching, begin()
+ * sends one, and frames which fail the CRC. A request is run when its frame
+ * is complete, one per Cli::loop().
+ */
+class CmdRpc : public Stream
+{
+    public:
+
+        CmdRpc(Stream &io);
+
+        /**
+         * @brief Sets the terminal stream, used by sessions which get their
+         * client when connected. Switches to text mode.
+         */
+        void setStream(Stream &io);
+
+        /**
+         * @brief Switches to machine mode.
+         */
+        void begin(void);
+
+        /**
+         * @brief Tells if the stream is in machine mode.
+         */
+        bool isActive(void) const;
+
+        /**
+         * @brief Returns the number of frames received in machine mode and
+         * how many of them have been rejected.
+         */
+        uint32_t getFrames(void) const;
+        uint32_t getErrors(void) const;
+
+        /**
+         * @brief Appends the CRC to a frame and COBS encodes it, the 0x00 
+         * ending the frame included.
+         * @param frame The decoded frame, with room for 2 more bytes.
+         * @param len   The length of the frame without CRC, at most 252.
+         * @param dst   The buffer for the encoded frame, len + 4 bytes.
+         * @return The length of the encoded frame.
+         */
+        static size_t pack(uint8_t *frame, size_t len, uint8_t *dst);
+
+        /**
+         * @brief Decodes a frame in place and checks its CRC.
+         * @param frame The encoded frame without the 0x00.
+         * @param len   The length of the encoded frame.
+         * @return The length of the decoded frame without CRC, 0 if it is 
+         * broken.
+         */
+        static size_t unpack(uint8_t *frame, size_t len);
+
+        /**
+         * @brief Returns the CRC-16/CCITT-FALSE of the given data.
+         */
+        static uint16_t crc16(const uint8_t *data, size_t len);
+
+        int available(void) override;
+        int read(void) override;
+        int peek(void) override;
+
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t *data, size_t size) override;
+        using Print::write;
+
+        void flush(void) override;
+
+    private:
+
+        /**
+         * @brief The stream passed to the commands, it sends their output in
+         * frames of CMDRPC_CHUNK bytes.
+         */
+        class Output : public Stream
+        {
+            public:
+
+                Output(CmdRpc &rpc) : rpc(rpc), seq(0), len(0) {}
+
+                /**
+                 * @brief Starts collecting the output of a request.
+                 */
+                void begin(uint8_t seq);
+
+                /**
+                 * @brief Sends the pending output and the result.
+                 */
+                void end(int8_t ret);
+
+                int available(void) override;
+                int read(void) override;
+                int peek(void) override;
+
+                size_t write(uint8_t c) override;
+                size_t write(const uint8_t *data, size_t size) override;
+                using Print::write;
+
+                void flush(void) override;
+
+            private:
+
+                CmdRpc &rpc;
+                uint8_t seq;
+
+                /**
+                 * @brief The frame being filled, type and seq first and room 
+                 * for the CRC.
+                 */
+                uint8_t frame[CMDRPC_CHUNK + 4];
+                size_t len;
+        };
+
+        /**
+         * @brief Runs a complete request.
+         */
+        void handle(void);
+
+        /**
+         * @brief Runs a CMDRPC_CALL request.
+         */
+        void call(uint8_t seq, const uint8_t *payload, size_t len);
+
+        /**
+         * @brief Sends a frame with a one byte payload.
+         */
+        void reply(uint8_t type, uint8_t seq, uint8_t value);
+
+        /**
+         * @brief Encodes a frame and sends it with a single write.
+         */
+        void send(uint8_t *frame, size_t len);
+
+        Stream *io;
+        bool active;
+
+        uint8_t rx[CMDRPC_RXSIZ];
+        size_t rxLen;
+        bool rxOverflow;
+
+        uint8_t tx[CMDRPC_TXSIZ];
+        Output out;
+
+        uint32_t frames;
+        uint32_t errors;
+};
+
+#endif /* _CMDRPC_HPP_ */
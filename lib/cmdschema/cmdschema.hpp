@@ -0,0 +1,468 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CMDSCHEMA_HPP_
+#define _CMDSCHEMA_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+#include "format.hpp"
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+
+/**
+ * @brief The result of a command called with wrong arguments.
+ */
+#define CMDSCHEMA_ERROR         -1
+
+/**
+ * @brief Defines a command with typed arguments. The arguments are checked 
+ * and converted before the handler is called, which gets one value per 
+ * argument type instead of argc and argv:
+ * 
+ *   CMDSCHEMA_ENUM(LedMode, "0", "1", "b");
+ * 
+ *   CLI_COMMAND_ARGS(led, LedMode)(Stream &ioStream, uint8_t mode) {
+ *       ...
+ *   }
+ * 
+ * A wrong number of arguments or a value which does not convert prints a 
+ * uniform message and returns CMDSCHEMA_ERROR without calling the handler.
+ * The command is registered by CLI_COMMAND, so hooks and CmdIndex work as 
+ * for any other command.
+ */
+#define CLI_COMMAND_ARGS(_name, ...)                                        \
+    static CmdSchema<__VA_ARGS__>::handler_t args_##_name;                  \
+    CLI_COMMAND(_name) {                                                    \
+        return CmdSchema<__VA_ARGS__>::run(ioStream, #_name, argc, argv,    \
+            args_##_name);                                                  \
+    }                                                                       \
+    static int8_t args_##_name
+
+/**
+ * @brief Defines an argument type which is one of the given words, the 
+ * handler gets its index as uint8_t. Use it in the source file of the 
+ * command, e.g. CMDSCHEMA_ENUM(OnOff, "on", "off") and compare with 
+ * CMDSCHEMA_OF(OnOff, "on").
+ */
+#define CMDSCHEMA_ENUM(_name, ...)                                          \
+    struct _name : ArgEnum<_name>                                           \
+    {                                                                       \
+        static constexpr const char *const names[] = {__VA_ARGS__};         \
+    };                                                                      \
+    constexpr const char *const _name::names[]
+
+/**
+ * @brief Returns the index of a word of an enum defined by CMDSCHEMA_ENUM. It
+ * is always evaluated at compile time, so a word which is not in the list 
+ * fails to compile.
+ */
+#define CMDSCHEMA_OF(_enum, _word)                                          \
+    (std::integral_constant<_enum::type, _enum::of(_word)>::value)
+
+/**
+ * @brief Helpers of the argument types.
+ */
+namespace CmdSchemaUtil
+{
+    /**
+     * @brief The FNV-1a hash of a string, evaluated at compile time for the
+     * choices of an enum.
+     */
+    constexpr uint32_t hash(const char *s, uint32_t h = 2166136261u)
+    {
+        return *s == '\0' ? h : hash(s + 1, (h ^ (uint8_t) *s) * 16777619u);
+    }
+
+    /**
+     * @brief Compares two strings at compile time.
+     */
+    constexpr bool equal(const char *a, const char *b)
+    {
+        return *a == *b && (*a == '\0' || equal(a + 1, b + 1));
+    }
+
+    /**
+     * @brief Not constexpr, reached at compile time by a word which is not
+     * a choice of the enum.
+     */
+    uint8_t noSuchChoice(void);
+
+    /**
+     * @brief Prints the message for a wrong argument.
+     */
+    void invalid(Print &io, const char *cmd, size_t n, const char *arg);
+
+    template<size_t... I>
+    struct Seq {};
+
+    template<size_t N, size_t... I>
+    struct MakeSeq : MakeSeq<N - 1, N - 1, I...> {};
+
+    template<size_t... I>
+    struct MakeSeq<0, I...>
+    {
+        typedef Seq<I...> type;
+    };
+
+    /**
+     * @brief The hashes of all choices of an enum, as constant table.
+     */
+    template<class E, class S = typename MakeSeq<E::cnt()>::type>
+    struct Hashes;
+
+    template<class E, size_t... I>
+    struct Hashes<E, Seq<I...>>
+    {
+        static constexpr uint32_t value[] = {hash(E::names[I])...};
+    };
+
+    template<class E, size_t... I>
+    constexpr uint32_t Hashes<E, Seq<I...>>::value[];
+
+    /**
+     * @brief Tells if hash i differs from all hashes after it, and so on.
+     */
+    constexpr bool unique(const uint32_t *h, size_t n, size_t i = 0, 
+        size_t k = 1)
+    {
+        return i + 1 >= n ? true :
+            k >= n ? unique(h, n, i + 1, i + 2) :
+            h[i] != h[k] && unique(h, n, i, k + 1);
+    }
+}
+
+/**
+ * @brief An integer argument in the range MIN to MAX, decimal or with 0x 
+ * prefix. The handler gets a long.
+ */
+template<long MIN, long MAX>
+struct ArgInt
+{
+    static_assert(MIN <= MAX, "empty range");
+
+    typedef long type;
+
+    static bool parse(const char *s, type &v)
+    {
+        char *pEnd = nullptr;
+
+        v = strtol(s, &pEnd, 0);
+        return *s != '\0' && *pEnd == '\0' && v >= MIN && v <= MAX;
+    }
+
+    static void describe(Print &io)
+    {
+        FMT_PRINT(io, "%ld..%ld", MIN, MAX);
+    }
+};
+
+/**
+ * @brief A text argument, the handler gets the pointer to it.
+ */
+struct ArgStr
+{
+    typedef const char *type;
+
+    static bool parse(const char *s, type &v)
+    {
+        v = s;
+        return true;
+    }
+
+    static type missing(void)
+    {
+        return nullptr;
+    }
+
+    static void describe(Print &io)
+    {
+        io.print("text");
+    }
+};
+
+/**
+ * @brief The base of the types defined by CMDSCHEMA_ENUM. 
+ * 
+ * The input is hashed once and looked up in the table of hashes, which the
+ * compiler builds from the choices, so only a matching hash is confirmed by 
+ * a single string compare. Choices with the same hash are rejected at 
+ * compile time.
+ */
+template<class E>
+struct ArgEnum
+{
+    typedef uint8_t type;
+
+    /**
+     * @brief Returns the number of choices.
+     */
+    static constexpr size_t cnt(void)
+    {
+        return sizeof(E::names) / sizeof(E::names[0]);
+    }
+
+    /**
+     * @brief Returns the index of a choice. A word which is not a choice 
+     * fails to compile only where a constant is required, use CMDSCHEMA_OF()
+     * to make sure it is.
+     */
+    static constexpr type of(const char *name, size_t i = 0)
+    {
+        return i >= cnt() ? CmdSchemaUtil::noSuchChoice() :
+            CmdSchemaUtil::equal(E::names[i], name) ? (type) i : 
+            of(name, i + 1);
+    }
+
+    static bool parse(const char *s, type &v)
+    {
+        typedef CmdSchemaUtil::Hashes<E> H;
+        static_assert(cnt() < 0xFF, "too many choices");
+        static_assert(CmdSchemaUtil::unique(H::value, cnt()), 
+            "choices with the same hash");
+        uint32_t h = CmdSchemaUtil::hash(s);
+
+        for (size_t i = 0; i < cnt(); i++)
+        {
+            if (H::value[i] == h && strcmp(E::names[i], s) == 0)
+            {
+                v = (type) i;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Returned for a missing optional argument.
+     */
+    static type missing(void)
+    {
+        return (type) cnt();
+    }
+
+    static void describe(Print &io)
+    {
+        for (size_t i = 0; i < cnt(); i++)
+        {
+            FMT_PRINT(io, "%s%s", i > 0 ? "|" : "", E::names[i]);
+        }
+    }
+};
+
+/**
+ * @brief An optional argument, only allowed after the required ones. A 
+ * missing one is passed as A::missing(), i.e. nullptr for ArgStr and cnt() 
+ * for an enum.
+ */
+template<class A>
+struct ArgOpt : A
+{
+    static const bool optional = true;
+};
+
+/**
+ * @brief The schema of a command, the types of its arguments.
+ * @tparam A    The argument types: ArgInt, ArgStr, enums by CMDSCHEMA_ENUM 
+ *              and ArgOpt of them.
+ */
+template<class... A>
+class CmdSchema
+{
+    public:
+
+        /**
+         * @brief The type of the handler.
+         */
+        typedef int8_t handler_t(Stream &ioStream, typename A::type...);
+
+        /**
+         * @brief Checks and converts the arguments and calls the handler.
+         * @return The result of the handler or CMDSCHEMA_ERROR.
+         */
+        static int8_t run(Stream &ioStream, const char *cmd, size_t argc, 
+            const char *argv[], handler_t *pHandler)
+        {
+            Context ctx = {ioStream, cmd, argc, argv, pHandler};
+
+            if (argc < Count<A...>::required || argc > sizeof...(A))
+            {
+                usage(ioStream, cmd);
+                return CMDSCHEMA_ERROR;
+            }
+
+            return Call<List<A...>, List<>>::run(ctx, 0);
+        }
+
+        /**
+         * @brief Prints the usage line of the command, e.g. 
+         * "Usage: led 0|1|b".
+         */
+        static void usage(Print &io, const char *cmd)
+        {
+            FMT_PRINT(io, "Usage: %s", cmd);
+            Describe<A...>::run(io);
+            io.print("\n");
+        }
+
+    private:
+
+        template<class... T>
+        struct List {};
+
+        struct Context
+        {
+            Stream &io;
+            const char *cmd;
+            size_t argc;
+            const char **argv;
+            handler_t *pHandler;
+        };
+
+        /**
+         * @brief Tells if the argument type is an ArgOpt.
+         */
+        template<class T>
+        struct IsOpt
+        {
+            template<class U> 
+            static constexpr bool test(decltype(U::optional) *) 
+            { 
+                return true; 
+            }
+
+            template<class U> 
+            static constexpr bool test(...) 
+            { 
+                return false; 
+            }
+
+            static const bool value = test<T>(nullptr);
+        };
+
+        /**
+         * @brief Counts the required arguments, optional ones must follow 
+         * them.
+         */
+        template<class... T>
+        struct Count
+        {
+            static const size_t required = 0;
+        };
+
+        template<class T, class... R>
+        struct Count<T, R...>
+        {
+            static_assert(!IsOpt<T>::value || Count<R...>::required == 0,
+                "optional arguments must be last");
+            static const size_t required = 
+                IsOpt<T>::value ? 0 : 1 + Count<R...>::required;
+        };
+
+        template<class... T>
+        struct Describe
+        {
+            static void run(Print &io) {}
+        };
+
+        template<class T, class... R>
+        struct Describe<T, R...>
+        {
+            static void run(Print &io)
+            {
+                io.print(IsOpt<T>::value ? " [" : " ");
+                T::describe(io);
+                io.print(IsOpt<T>::value ? "]" : "");
+                Describe<R...>::run(io);
+            }
+        };
+
+        /**
+         * @brief Converts the arguments one by one, the converted values are
+         * passed on as parameters until the handler is called with all of
+         * them.
+         */
+        template<class L, class V>
+        struct Call;
+
+        template<class T, class... R, class... V>
+        struct Call<List<T, R...>, List<V...>>
+        {
+            static int8_t run(const Context &ctx, size_t n, V... vals)
+            {
+                typename T::type val;
+
+                if (n >= ctx.argc)
+                {
+                    val = Missing<T>::get();
+                }
+                else if (!T::parse(ctx.argv[n], val))
+                {
+                    CmdSchemaUtil::invalid(ctx.io, ctx.cmd, n + 1, 
+                        ctx.argv[n]);
+                    T::describe(ctx.io);
+                    ctx.io.print("\n");
+                    return CMDSCHEMA_ERROR;
+                }
+
+                return Call<List<R...>, List<V..., typename T::type>>::run(
+                    ctx, n + 1, vals..., val);
+            }
+        };
+
+        template<class... V>
+        struct Call<List<>, List<V...>>
+        {
+            static int8_t run(const Context &ctx, size_t n, V... vals)
+            {
+                return ctx.pHandler(ctx.io, vals...);
+            }
+        };
+
+        /**
+         * @brief The value of a missing argument, only optional ones can be
+         * missing.
+         */
+        template<class T, bool OPT = IsOpt<T>::value>
+        struct Missing
+        {
+            static typename T::type get(void)
+            {
+                return T::missing();
+            }
+        };
+
+        template<class T>
+        struct Missing<T, false>
+        {
+            static typename T::type get(void)
+            {
+                return typename T::type();
+            }
+        };
+};
+
+#endif /* _CMDSCHEMA_HPP_ */
@@ -0,0 +1,109 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#include "cmdtoken.hpp"
+
+#include <string.h>
+
+/**
+ * @brief Tells if the character separates tokens.
+ */
+static inline bool cmdTokenBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+int8_t CmdTokens::split(char *line)
+{
+    char *pRd = line;
+    char *pWr = line;
+    char quote = '\0';
+
+    pFirst = line;
+    cnt = 0;
+
+    while (true)
+    {
+        while (cmdTokenBlank(*pRd))
+        {
+            pRd++;
+        }
+
+        if (*pRd == '\0')
+        {
+            break;
+        }
+
+        /* pWr never passes pRd, the characters only move down. */
+        cnt++;
+        while (*pRd != '\0' && (quote != '\0' || !cmdTokenBlank(*pRd)))
+        {
+            char c = *pRd++;
+
+            if (c == quote)
+            {
+                quote = '\0';
+            }
+            else if (quote == '\0' && (c == '"' || c == '\''))
+            {
+                quote = c;
+            }
+            else if (c == '\\' && quote != '\'' && *pRd != '\0')
+            {
+                *pWr++ = *pRd++;
+            }
+            else
+            {
+                *pWr++ = c;
+            }
+        }
+
+        if (*pRd != '\0')
+        {
+            pRd++;
+        }
+        *pWr++ = '\0';
+    }
+
+    if (quote != '\0')
+    {
+        cnt = 0;
+        return CMDTOKEN_EQUOTE;
+    }
+
+    return 0;
+}
+
+size_t CmdTokens::toArgv(const char *argv[], size_t max) const
+{
+    const char *pTok = pFirst;
+
+    for (size_t i = 0; i + 1 < cnt && i < max; i++)
+    {
+        pTok = next(pTok);
+        argv[i] = pTok;
+    }
+
+    return cnt > 0 ? cnt - 1 : 0;
+}
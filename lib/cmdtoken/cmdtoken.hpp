@@ -0,0 +1,112 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CMDTOKEN_HPP_
+#define _CMDTOKEN_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+/**
+ * @brief The largest number of arguments after the command name. The argv 
+ * array is only built on the stack when a command is run, so this costs no 
+ * RAM per instance.
+ */
+#ifndef CMDTOKEN_ARGVSIZ
+#define CMDTOKEN_ARGVSIZ        8
+#endif
+
+/**
+ * @brief Returned by split() for a quote which is not closed.
+ */
+#define CMDTOKEN_EQUOTE         -1
+
+/**
+ * @brief Splits a command line into tokens in place, with quoting and 
+ * escapes.
+ * 
+ * Tokens are separated by spaces and tabs. Double and single quotes keep 
+ * blanks inside a token, e.g. telnet begin "My Net" pass. A backslash takes 
+ * the next character literally, except inside single quotes. Quotes and 
+ * backslashes are removed by moving the characters down in the line, so the
+ * tokens end up one after the other, each ending with a NUL. Nothing is 
+ * copied, only the first token and the count are kept: next() walks the 
+ * tokens and toArgv() fills an argv array, which the caller puts on the 
+ * stack when running the command.
+ */
+class CmdTokens
+{
+    public:
+
+        CmdTokens(void) : pFirst(nullptr), cnt(0) {}
+
+        /**
+         * @brief Splits the given line in place.
+         * @param line  The NUL terminated line, it is modified.
+         * @return 0 or CMDTOKEN_EQUOTE.
+         */
+        int8_t split(char *line);
+
+        /**
+         * @brief Returns the number of tokens, the command name included.
+         */
+        size_t getCnt(void) const
+        {
+            return cnt;
+        }
+
+        /**
+         * @brief Returns the first token, the command name, or nullptr if 
+         * the line is empty.
+         */
+        const char* first(void) const
+        {
+            return cnt > 0 ? pFirst : nullptr;
+        }
+
+        /**
+         * @brief Returns the token following the given one, which has to be 
+         * one of the tokens but not the last.
+         */
+        static const char* next(const char *pTok)
+        {
+            return pTok + strlen(pTok) + 1;
+        }
+
+        /**
+         * @brief Fills an argv array with the tokens after the command name.
+         * @param argv  The array to fill.
+         * @param max   The size of the array.
+         * @return The number of arguments, larger than max if they do not 
+         * fit, then only max entries are set.
+         */
+        size_t toArgv(const char *argv[], size_t max) const;
+
+    private:
+
+        const char *pFirst;
+        size_t cnt;
+};
+
+#endif /* _CMDTOKEN_HPP_ */
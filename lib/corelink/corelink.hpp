@@ -0,0 +1,177 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _CORELINK_HPP_
+#define _CORELINK_HPP_
+
+#include <Arduino.h>
+#include "spscqueue.hpp"
+
+/**
+ * @brief The size of each direction of a CoreLink, a power of two.
+ */
+#ifndef CORELINK_SIZ
+#define CORELINK_SIZ            512
+#endif
+
+/**
+ * @brief The most bytes pump() passes to the local stream per call.
+ */
+#ifndef CORELINK_CHUNK
+#define CORELINK_CHUNK          128
+#endif
+
+/**
+ * @brief How long a write waits for space in ms before the output is 
+ * dropped, e.g. while no terminal is attached to a USB CDC port.
+ */
+#ifndef CORELINK_TIMEOUT
+#define CORELINK_TIMEOUT        100
+#endif
+
+/**
+ * @brief Connects a stream owned by one core to a Cli running on another.
+ * 
+ * The core which owns the stream, e.g. Serial, calls pump() periodically. It
+ * moves the received bytes into the rx queue and the output of the other 
+ * core from the tx queue to the stream. The other core uses the CoreLink 
+ * itself as Stream for its Cli. Each queue has exactly one producer and one 
+ * consumer, so no locks are taken and neither core ever waits for the other,
+ * apart from a writer waiting for space in a full tx queue.
+ * 
+ * @tparam SIZ  The size of each queue, a power of two.
+ */
+template<size_t SIZ = CORELINK_SIZ>
+class CoreLink : public Stream
+{
+    public:
+
+        CoreLink(void) {}
+
+        /**
+         * @brief Passes data between the local stream and the queues, to be
+         * called by the core owning the stream.
+         */
+        void pump(Stream &io)
+        {
+            uint8_t buf[CORELINK_CHUNK];
+            size_t n = 0;
+
+            while (rx.space() > 0 && io.available() > 0)
+            {
+                int c = io.read();
+
+                if (c < 0)
+                {
+                    break;
+                }
+                buf[0] = (uint8_t) c;
+                rx.push(buf, 1);
+            }
+
+            n = tx.pop(buf, sizeof(buf));
+            if (n > 0)
+            {
+                io.write(buf, n);
+            }
+        }
+
+        /**
+         * @brief Returns the number of bytes waiting to be pumped out.
+         */
+        size_t pending(void) const
+        {
+            return SIZ - tx.space();
+        }
+
+        int available(void) override
+        {
+            return (int) rx.available();
+        }
+
+        int read(void) override
+        {
+            uint8_t c = 0;
+
+            return rx.pop(&c, 1) == 1 ? c : -1;
+        }
+
+        int peek(void) override
+        {
+            return rx.peek();
+        }
+
+        size_t write(uint8_t c) override
+        {
+            return write(&c, 1);
+        }
+
+        /**
+         * @brief Queues the data, waits for the other core while the queue 
+         * is full but drops the rest after CORELINK_TIMEOUT ms.
+         */
+        size_t write(const uint8_t *data, size_t size) override
+        {
+            size_t done = tx.push(data, size);
+            uint32_t start = millis();
+
+            while (done < size && millis() - start < CORELINK_TIMEOUT)
+            {
+                delay(1);
+                done += tx.push(data + done, size - done);
+            }
+
+            return done;
+        }
+
+        using Print::write;
+
+        /**
+         * @brief Waits until the other core has taken all output, at most 
+         * CORELINK_TIMEOUT ms.
+         */
+        void flush(void) override
+        {
+            uint32_t start = millis();
+
+            while (pending() > 0 && millis() - start < CORELINK_TIMEOUT)
+            {
+                delay(1);
+            }
+        }
+
+    private:
+
+        /**
+         * @brief Received bytes, from the owning core to the Cli.
+         */
+        SpscQueue<SIZ> rx;
+
+        /**
+         * @brief Output of the Cli, to the owning core.
+         */
+        SpscQueue<SIZ> tx;
+};
+
+#endif /* _CORELINK_HPP_ */
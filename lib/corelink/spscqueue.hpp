@@ -0,0 +1,157 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+
+#ifndef _SPSCQUEUE_HPP_
+#define _SPSCQUEUE_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+
+/**
+ * @brief A lock-free byte queue for exactly one producer and one consumer, 
+ * which may run on different cores.
+ * 
+ * Head and tail are free running counters, the index into the buffer is 
+ * taken modulo SIZ. Only the producer writes head and only the consumer 
+ * writes tail, so plain atomic loads and stores are enough: the producer 
+ * publishes the bytes by a release store of head after copying them, the 
+ * consumer frees them by a release store of tail after copying them out. 
+ * No read-modify-write is used, which the Cortex-M0+ of the RP2040 lacks.
+ * 
+ * @tparam SIZ  The size of the queue, must be a power of two.
+ */
+template<size_t SIZ>
+class SpscQueue
+{
+    static_assert(SIZ > 0 && (SIZ & (SIZ - 1)) == 0, 
+        "SpscQueue size must be a power of two");
+    static_assert(SIZ <= 0x80000000UL, "SpscQueue size too large");
+
+    public:
+
+        SpscQueue(void) : head(0), tail(0) {}
+
+        /**
+         * @brief Returns the number of bytes which can be popped, to be 
+         * called by the consumer.
+         */
+        size_t available(void) const
+        {
+            return head.load(std::memory_order_acquire) - 
+                tail.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the number of bytes which can be pushed, to be 
+         * called by the producer.
+         */
+        size_t space(void) const
+        {
+            return SIZ - (head.load(std::memory_order_relaxed) - 
+                tail.load(std::memory_order_acquire));
+        }
+
+        /**
+         * @brief Appends as many bytes as fit, to be called by the producer.
+         * @return The number of bytes appended.
+         */
+        size_t push(const uint8_t *data, size_t n)
+        {
+            uint32_t h = head.load(std::memory_order_relaxed);
+            size_t free = SIZ - (h - tail.load(std::memory_order_acquire));
+
+            n = n < free ? n : free;
+            copyIn(h, data, n);
+            head.store(h + n, std::memory_order_release);
+
+            return n;
+        }
+
+        /**
+         * @brief Removes up to n bytes, to be called by the consumer.
+         * @return The number of bytes removed.
+         */
+        size_t pop(uint8_t *data, size_t n)
+        {
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            size_t used = head.load(std::memory_order_acquire) - t;
+
+            n = n < used ? n : used;
+            copyOut(t, data, n);
+            tail.store(t + n, std::memory_order_release);
+
+            return n;
+        }
+
+        /**
+         * @brief Returns the next byte without removing it or -1, to be 
+         * called by the consumer.
+         */
+        int peek(void) const
+        {
+            uint32_t t = tail.load(std::memory_order_relaxed);
+
+            if (head.load(std::memory_order_acquire) == t)
+            {
+                return -1;
+            }
+
+            return buffer[t & (SIZ - 1)];
+        }
+
+    private:
+
+        /**
+         * @brief Copies n bytes into the ring at the given counter value, in
+         * two pieces if the ring wraps.
+         */
+        void copyIn(uint32_t pos, const uint8_t *data, size_t n)
+        {
+            size_t idx = pos & (SIZ - 1);
+            size_t first = SIZ - idx < n ? SIZ - idx : n;
+
+            memcpy(&buffer[idx], data, first);
+            memcpy(&buffer[0], data + first, n - first);
+        }
+
+        /**
+         * @brief Copies n bytes out of the ring at the given counter value.
+         */
+        void copyOut(uint32_t pos, uint8_t *data, size_t n) const
+        {
+            size_t idx = pos & (SIZ - 1);
+            size_t first = SIZ - idx < n ? SIZ - idx : n;
+
+            memcpy(data, &buffer[idx], first);
+            memcpy(data + first, &buffer[0], n - first);
+        }
+
+        uint8_t buffer[SIZ];
+        std::atomic<uint32_t> head;
+        std::atomic<uint32_t> tail;
+};
+
+#endif /* _SPSCQUEUE_HPP_ */
@@ -0,0 +1,538 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _FORMAT_HPP_
+#define _FORMAT_HPP_
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+#include <string.h>
+
+/**
+ * @brief The size of the buffer on the stack collecting the output of one 
+ * FMT_PRINT(), longer output is written in chunks of this size.
+ */
+#ifndef FORMAT_BUFSIZ
+#define FORMAT_BUFSIZ           64
+#endif
+
+/**
+ * @brief Drop in replacement for io.printf(fmt, ...) with a string literal as
+ * format. The format is checked against the argument types at compile time,
+ * a mismatch like "%d" given a size_t is reported by static_assert.
+ * 
+ * Supported are the flags '-' and '0', a decimal width, the length modifiers
+ * hh, h, l, ll and z and the conversions d, i, u, x, X, c, s and %%. The 
+ * modifiers h and hh are accepted, but the value is not truncated.
+ */
+#define FMT_PRINT(_io, _fmt, ...)                                           \
+    do {                                                                    \
+        static_assert(Format::check<                                        \
+            decltype(Format::types(__VA_ARGS__))>(_fmt),                    \
+            "format does not match the arguments: " _fmt);                  \
+        Format::print(_io, _fmt, ##__VA_ARGS__);                            \
+    } while (0)
+
+/**
+ * @brief A printf() subset for Print, without varargs and heap.
+ * 
+ * Print::printf() formats into a buffer with vsnprintf(), which pulls the 
+ * full libc formatter into the image, needs a lot of stack and has no type 
+ * information about its arguments. Here every argument is written by a 
+ * function chosen at compile time by its type and integers are converted in 
+ * a small buffer on the stack. The output is collected in a buffer of 
+ * FORMAT_BUFSIZ bytes on the stack and written once it is full and at the 
+ * end, so a line usually reaches the stream in a single write. Use it 
+ * through FMT_PRINT() to get the compile time check.
+ */
+class Format
+{
+    public:
+
+        /**
+         * @brief A list of argument types, only used in decltype().
+         */
+        template<typename... T>
+        struct TypeList {};
+
+        /**
+         * @brief Maps the arguments to their decayed types, declared only.
+         */
+        template<typename... T>
+        static TypeList<typename std::decay<T>::type...> types(T&&...);
+
+        /**
+         * @brief Tells if the format consumes exactly the given types.
+         */
+        template<typename L>
+        static constexpr bool check(const char *fmt)
+        {
+            return Checker<L>::check(fmt);
+        }
+
+        /**
+         * @brief Writes the formatted arguments to the given stream.
+         */
+        template<typename... A>
+        static void print(Print &io, const char *fmt, const A&... args)
+        {
+            Out out(io);
+
+            next(out, fmt, args...);
+            out.flush();
+        }
+
+    private:
+
+        /**
+         * @brief Length modifiers.
+         */
+        enum : uint8_t
+        {
+            LEN_NONE = 0,
+            LEN_HH,
+            LEN_H,
+            LEN_L,
+            LEN_LL,
+            LEN_Z
+        };
+
+        /**
+         * @brief Flags of a conversion.
+         */
+        enum : uint8_t
+        {
+            FLAG_LEFT = 0x01,
+            FLAG_ZERO = 0x02
+        };
+
+        /**
+         * @brief A parsed conversion specification.
+         */
+        struct Spec
+        {
+            uint8_t flags;
+            uint8_t width;
+            uint8_t len;
+            char conv;
+        };
+
+        /* Compile time parser, constexpr in C++11 style with one return 
+         * statement per function so older toolchains can handle it. */
+
+        /**
+         * @brief Returns the position after the next '%' starting a 
+         * conversion, or the terminating NUL if there is none.
+         */
+        static constexpr const char* skipText(const char *f)
+        {
+            return *f == 0 ? f :
+                *f != '%' ? skipText(f + 1) :
+                f[1] == '%' ? skipText(f + 2) : f + 1;
+        }
+
+        static constexpr const char* skipFlags(const char *f)
+        {
+            return *f == '-' || *f == '0' ? skipFlags(f + 1) : f;
+        }
+
+        static constexpr const char* skipWidth(const char *f)
+        {
+            return *f >= '0' && *f <= '9' ? skipWidth(f + 1) : f;
+        }
+
+        static constexpr uint8_t lenOf(const char *f)
+        {
+            return *f == 'h' ? (f[1] == 'h' ? LEN_HH : LEN_H) :
+                *f == 'l' ? (f[1] == 'l' ? LEN_LL : LEN_L) :
+                *f == 'z' ? LEN_Z : LEN_NONE;
+        }
+
+        static constexpr const char* skipLen(const char *f)
+        {
+            return lenOf(f) == LEN_HH || lenOf(f) == LEN_LL ? f + 2 :
+                lenOf(f) != LEN_NONE ? f + 1 : f;
+        }
+
+        /**
+         * @brief Returns the position of the conversion character of the 
+         * specification starting at f, right after the '%'.
+         */
+        static constexpr const char* convOf(const char *f)
+        {
+            return skipLen(skipWidth(skipFlags(f)));
+        }
+
+        /**
+         * @brief The type an integer argument is promoted to when passed to
+         * printf().
+         */
+        template<typename T, bool = std::is_integral<T>::value || 
+            std::is_enum<T>::value>
+        struct Promote
+        {
+            typedef T type;
+        };
+
+        template<typename T>
+        struct Promote<T, true>
+        {
+            typedef decltype(+T()) type;
+        };
+
+        /**
+         * @brief Tells if T is a valid argument for the given length and 
+         * conversion. Signedness must match for 'd' and 'u', so a size_t 
+         * given to "%d" is caught on 32 bit targets as well, where it has 
+         * the same size as int.
+         */
+        template<typename T>
+        static constexpr bool accepts(uint8_t len, char conv)
+        {
+            typedef typename Promote<T>::type P;
+
+            return conv == 's' ? len == LEN_NONE && 
+                    (std::is_same<T, const char*>::value || 
+                     std::is_same<T, char*>::value) :
+                conv == 'c' ? len == LEN_NONE && std::is_same<P, int>::value :
+                conv == 'd' || conv == 'i' ? 
+                    (len == LEN_L ? std::is_same<P, long>::value :
+                     len == LEN_LL ? std::is_same<P, long long>::value :
+                     len == LEN_Z ? std::is_same<P, 
+                        std::make_signed<size_t>::type>::value :
+                     std::is_same<P, int>::value) :
+                conv == 'x' || conv == 'X' ? 
+                    accepts<T>(len, 'u') || accepts<T>(len, 'd') :
+                conv == 'u' ?
+                    (len == LEN_L ? std::is_same<P, unsigned long>::value :
+                     len == LEN_LL ? 
+                        std::is_same<P, unsigned long long>::value :
+                     len == LEN_Z ? std::is_same<P, size_t>::value :
+                     std::is_same<P, unsigned int>::value ||
+                        (std::is_same<P, int>::value && 
+                         sizeof(T) < sizeof(int))) :
+                false;
+        }
+
+        template<typename L, typename = void>
+        struct Checker;
+
+        /**
+         * @brief Consumes one conversion per argument type, the format must 
+         * not contain more conversions than arguments.
+         */
+        template<typename T, typename... R>
+        struct Checker<TypeList<T, R...>, void>
+        {
+            static constexpr bool check(const char *f)
+            {
+                return *skipText(f) != 0 &&
+                    accepts<T>(lenOf(skipWidth(skipFlags(skipText(f)))), 
+                        *convOf(skipText(f))) &&
+                    Checker<TypeList<R...>>::check(convOf(skipText(f)) + 1);
+            }
+        };
+
+        template<typename D>
+        struct Checker<TypeList<>, D>
+        {
+            static constexpr bool check(const char *f)
+            {
+                return *skipText(f) == 0;
+            }
+        };
+
+        /* Run time part */
+
+        /**
+         * @brief Collects the output of one print() call.
+         */
+        class Out
+        {
+            public:
+
+                Out(Print &io) : io(io), len(0) {}
+
+                void write(char c)
+                {
+                    if (len == sizeof(buf))
+                    {
+                        flush();
+                    }
+                    buf[len++] = c;
+                }
+
+                void write(const char *str, size_t n)
+                {
+                    if (len + n > sizeof(buf))
+                    {
+                        flush();
+                    }
+
+                    if (n > sizeof(buf))
+                    {
+                        io.write((const uint8_t*) str, n);
+                        return;
+                    }
+
+                    memcpy(&buf[len], str, n);
+                    len += n;
+                }
+
+                /**
+                 * @brief Passes the collected output on to the stream.
+                 */
+                void flush(void)
+                {
+                    if (len > 0)
+                    {
+                        io.write((const uint8_t*) buf, len);
+                        len = 0;
+                    }
+                }
+
+            private:
+
+                Print &io;
+                char buf[FORMAT_BUFSIZ];
+                size_t len;
+        };
+
+        /**
+         * @brief Writes the literal text up to the next conversion.
+         * @return The position right after the '%' or the terminating NUL.
+         */
+        static const char* text(Out &io, const char *f)
+        {
+            while (*f != 0)
+            {
+                const char *start = f;
+
+                while (*f != 0 && *f != '%')
+                {
+                    f++;
+                }
+                if (f != start)
+                {
+                    io.write(start, f - start);
+                }
+                if (*f == 0)
+                {
+                    break;
+                }
+                if (f[1] != '%')
+                {
+                    return f + 1;
+                }
+                io.write('%');
+                f += 2;
+            }
+
+            return f;
+        }
+
+        /**
+         * @brief Parses the specification following a '%'.
+         * @return The position after the conversion character.
+         */
+        static const char* parse(const char *f, Spec &spec)
+        {
+            spec.flags = 0;
+            spec.width = 0;
+
+            for (;; f++)
+            {
+                if (*f == '-')
+                {
+                    spec.flags |= FLAG_LEFT;
+                }
+                else if (*f == '0')
+                {
+                    spec.flags |= FLAG_ZERO;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            while (*f >= '0' && *f <= '9')
+            {
+                spec.width = (uint8_t) (spec.width * 10 + *f++ - '0');
+            }
+
+            spec.len = lenOf(f);
+            f = skipLen(f);
+            spec.conv = *f;
+
+            return *f != 0 ? f + 1 : f;
+        }
+
+        static void pad(Out &io, char c, size_t n)
+        {
+            while (n-- > 0)
+            {
+                io.write(c);
+            }
+        }
+
+        /**
+         * @brief Writes str padded to the width of the specification.
+         */
+        static void field(Out &io, const Spec &spec, const char *str, 
+            size_t n)
+        {
+            size_t fill = spec.width > n ? spec.width - n : 0;
+
+            if (!(spec.flags & FLAG_LEFT))
+            {
+                pad(io, ' ', fill);
+            }
+            io.write(str, n);
+            if (spec.flags & FLAG_LEFT)
+            {
+                pad(io, ' ', fill);
+            }
+        }
+
+        static void arg(Out &io, const Spec &spec, const char *str)
+        {
+            if (str == nullptr)
+            {
+                str = "(null)";
+            }
+            field(io, spec, str, strlen(str));
+        }
+
+        static void arg(Out &io, const Spec &spec, char *str)
+        {
+            arg(io, spec, (const char*) str);
+        }
+
+        /**
+         * @brief Writes an integer, the conversion is done in the native word
+         * size unless the argument does not fit.
+         */
+        template<typename T, typename = typename std::enable_if<
+            std::is_integral<T>::value || std::is_enum<T>::value>::type>
+        static void arg(Out &io, const Spec &spec, T val)
+        {
+            typedef typename Promote<T>::type P;
+            typedef typename std::conditional<
+                (sizeof(P) > sizeof(unsigned long)), 
+                unsigned long long, unsigned long>::type U;
+
+            char buf[sizeof(U) * 3 + 2];
+            char *pos = &buf[sizeof(buf)];
+            bool neg = false;
+            U u = (U) (P) val;
+            U base = 10;
+            const char *digits = "0123456789abcdef";
+
+            if (spec.conv == 'c')
+            {
+                char c = (char) val;
+                field(io, spec, &c, 1);
+                return;
+            }
+
+            if (spec.conv == 'x' || spec.conv == 'X')
+            {
+                base = 16;
+                if (spec.conv == 'X')
+                {
+                    digits = "0123456789ABCDEF";
+                }
+            }
+            else if (std::is_signed<P>::value && (P) val < 0 &&
+                spec.conv != 'u')
+            {
+                neg = true;
+                u = (U) 0 - u;
+            }
+
+            if (spec.conv == 'u' || base == 16)
+            {
+                /* Unsigned conversions of a negative small type see the
+                 * promoted value truncated to unsigned int, like printf. */
+                if (sizeof(P) <= sizeof(unsigned int))
+                {
+                    u = (unsigned int) u;
+                }
+            }
+
+            do
+            {
+                *--pos = digits[u % base];
+                u /= base;
+            } 
+            while (u != 0);
+
+            size_t n = &buf[sizeof(buf)] - pos;
+            if (spec.flags & FLAG_ZERO && !(spec.flags & FLAG_LEFT))
+            {
+                size_t w = spec.width > (neg ? 1 : 0) ? 
+                    spec.width - (neg ? 1 : 0) : 0;
+
+                if (neg)
+                {
+                    io.write('-');
+                }
+                pad(io, '0', w > n ? w - n : 0);
+                io.write(pos, n);
+                return;
+            }
+
+            if (neg)
+            {
+                *--pos = '-';
+                n++;
+            }
+            field(io, spec, pos, n);
+        }
+
+        static void next(Out &io, const char *f)
+        {
+            text(io, f);
+        }
+
+        template<typename A, typename... R>
+        static void next(Out &io, const char *f, const A &a, 
+            const R&... rest)
+        {
+            Spec spec;
+
+            f = text(io, f);
+            if (*f == 0)
+            {
+                return;
+            }
+            f = parse(f, spec);
+            arg(io, spec, a);
+            next(io, f, rest...);
+        }
+};
+
+#endif /* _FORMAT_HPP_ */
@@ -0,0 +1,299 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _COMPACTHISTORY_HPP_
+#define _COMPACTHISTORY_HPP_
+
+#include "history.hpp"
+
+/**
+ * @brief Stores the Ctrl-R histories of the consoles prefix compressed, see 
+ * ConsoleHistory. Off by default, as it costs time on every search.
+ */
+#ifndef HISTORY_COMPACT
+#define HISTORY_COMPACT         0
+#endif
+
+/**
+ * @brief The default maximum number of entries between two entries stored 
+ * in full. Limits the work of read(), which has to decode from the last full
+ * entry on.
+ */
+#ifndef HISTORY_RESTART
+#define HISTORY_RESTART         8
+#endif
+
+/**
+ * @brief A HistoryRing storing each entry relative to its predecessor.
+ * 
+ * Command lines often share a long prefix with the line before, like
+ * "telnet begin ..." or "dummy_long_1" and "dummy_long_2". Each entry is 
+ * stored as one byte with the length of the prefix shared with the previous
+ * entry, followed by the rest of the line and the NUL. 
+ * 
+ *   "dummy_long_1"  ->  [0] "dummy_long_1\0"
+ *   "dummy_long_2"  ->  [11] "2\0"
+ * 
+ * An entry with a shared prefix of 0 holds the full line. At least every 
+ * RESTART entries one is stored in full, so read() has to decode at most 
+ * RESTART entries. The oldest entry must always be a full one, thus entries 
+ * are evicted in groups up to the next full entry.
+ * 
+ * As with HistoryRing, appending the newest entry again is skipped. The 
+ * search functions used by Ctrl-R work on decoded copies of the entries, as 
+ * a match may span the shared prefix.
+ * 
+ * @tparam SIZ      The size of the ring buffer in bytes.
+ * @tparam IDXSIZ   The maximum number of entries.
+ * @tparam RESTART  The maximum distance between full entries.
+ */
+template<size_t SIZ, size_t IDXSIZ = HISTORY_INDEXSIZ, 
+    size_t RESTART = HISTORY_RESTART>
+class CompactHistory : protected HistoryRing<SIZ, IDXSIZ>
+{
+    static_assert(SIZ > 2, "CompactHistory needs at least three bytes");
+    static_assert(RESTART > 0, "CompactHistory needs RESTART > 0");
+
+    typedef HistoryRing<SIZ, IDXSIZ> Ring;
+
+    public:
+
+        using Ring::is_used;
+        using Ring::clear;
+        using Ring::seek_backward;
+        using Ring::seek_forward;
+        using Ring::get_free_space;
+        using Ring::get_count;
+        using Ring::get_position;
+        using Ring::set_position;
+
+        /**
+         * @brief Adds a new entry and moves the read position to it.
+         * @param str   The NUL terminated string to add.
+         * @param len   The length of the string, str[len] must be NUL.
+         * @return true on success, false if the arguments are invalid.
+         */
+        bool append(const char *str, size_t len)
+        {
+            char prev[SIZ];
+            size_t prevLen = 0;
+            size_t shared = 0;
+
+            if (str == nullptr || len == 0 || len > SIZ - 2 || str[len] != 0)
+            {
+                return false;
+            }
+
+            if (this->cnt > 0)
+            {
+                prevLen = decode(this->cnt - 1, prev, sizeof(prev));
+                if (prevLen == len && memcmp(prev, str, len) == 0)
+                {
+                    this->cur = this->cnt - 1;
+                    is_used = false;
+                    return true;
+                }
+
+                if (sinceRestart() + 1 < RESTART)
+                {
+                    while (shared < prevLen && shared < len && 
+                        shared < 0xFF && prev[shared] == str[shared])
+                    {
+                        shared++;
+                    }
+                }
+            }
+
+            while (this->cnt > 0 && (this->cnt == IDXSIZ || 
+                get_free_space() < len - shared + 2))
+            {
+                evictGroup();
+            }
+
+            if (this->cnt == 0)
+            {
+                shared = 0;
+            }
+
+            this->offs[Ring::slot(this->cnt)] = (typename Ring::offset_t) 
+                this->head;
+            put((char) shared);
+            for (size_t i = shared; i <= len; i++)
+            {
+                put(str[i]);
+            }
+            this->cnt++;
+            this->cur = this->cnt - 1;
+            is_used = false;
+
+            return true;
+        }
+
+        /**
+         * @brief Decodes the entry at the read position into the buffer.
+         * @param buf   The buffer.
+         * @param siz   The size of the buffer, including space for the NUL.
+         * @return The length of the entry or 0 if there is no entry, or the
+         * buffer is too small.
+         */
+        size_t read(char *buf, size_t siz)
+        {
+            if (this->cnt == 0 || buf == nullptr || siz == 0)
+            {
+                return 0;
+            }
+
+            return decode(this->cur, buf, siz);
+        }
+
+        /**
+         * @brief Same as HistoryRing::find_backward(), each entry is decoded
+         * to a buffer on the stack first.
+         */
+        int find_backward(const char *pattern, size_t len, size_t from) const
+        {
+            char line[SIZ];
+
+            if (from >= this->cnt)
+            {
+                return -1;
+            }
+
+            for (size_t n = from + 1; n-- > 0; )
+            {
+                size_t lineLen = decode(n, line, sizeof(line));
+
+                for (size_t i = 0; i + len <= lineLen; i++)
+                {
+                    if (memcmp(&line[i], pattern, len) == 0)
+                    {
+                        return (int) n;
+                    }
+                }
+            }
+
+            return -1;
+        }
+
+        /**
+         * @brief Same as HistoryRing::write_entry(), the entry is decoded to
+         * a buffer on the stack first.
+         */
+        size_t write_entry(size_t n, Print &out) const
+        {
+            char line[SIZ];
+            size_t len = 0;
+
+            if (n >= this->cnt)
+            {
+                return 0;
+            }
+
+            len = decode(n, line, sizeof(line));
+            out.write((const uint8_t *) line, len);
+
+            return len;
+        }
+
+    private:
+
+        /**
+         * @brief Returns the shared prefix length of entry n.
+         */
+        uint8_t prefixOf(size_t n) const
+        {
+            return (uint8_t) this->buffer[this->offs[Ring::slot(n)]];
+        }
+
+        /**
+         * @brief Returns the number of entries since the newest full one.
+         */
+        size_t sinceRestart(void) const
+        {
+            size_t n = this->cnt - 1;
+
+            while (n > 0 && prefixOf(n) != 0)
+            {
+                n--;
+            }
+
+            return this->cnt - 1 - n;
+        }
+
+        /**
+         * @brief Decodes entry n by starting at the last full entry before it
+         * and applying the following ones.
+         */
+        size_t decode(size_t n, char *buf, size_t siz) const
+        {
+            size_t first = n;
+            size_t len = 0;
+
+            while (first > 0 && prefixOf(first) != 0)
+            {
+                first--;
+            }
+
+            for (size_t e = first; e <= n; e++)
+            {
+                size_t pos = Ring::next(this->offs[Ring::slot(e)]);
+
+                len = prefixOf(e) < len ? prefixOf(e) : len;
+                while (this->buffer[pos] != 0)
+                {
+                    if (len + 1 >= siz)
+                    {
+                        return 0;
+                    }
+                    buf[len++] = this->buffer[pos];
+                    pos = Ring::next(pos);
+                }
+            }
+            buf[len] = 0;
+
+            return len;
+        }
+
+        /**
+         * @brief Drops the oldest entry and all following ones which depend 
+         * on it, until the oldest entry is a full one again.
+         */
+        void evictGroup(void)
+        {
+            do
+            {
+                Ring::evict();
+            } while (this->cnt > 0 && prefixOf(0) != 0);
+        }
+
+        /**
+         * @brief Writes one byte at the head of the ring buffer.
+         */
+        void put(char c)
+        {
+            this->buffer[this->head] = c;
+            this->head = (typename Ring::offset_t) Ring::next(this->head);
+        }
+};
+
+#endif /* _COMPACTHISTORY_HPP_ */
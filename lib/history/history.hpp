@@ -0,0 +1,431 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _HISTORY_HPP_
+#define _HISTORY_HPP_
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+
+/**
+ * @brief The default number of entries the offset index can hold. As the 
+ * index needs one or two bytes per entry, this limits the number of entries
+ * in the history, the oldest entry is dropped if the index is full.
+ */
+#ifndef HISTORY_INDEXSIZ
+#define HISTORY_INDEXSIZ        32
+#endif
+
+/**
+ * @brief A command history ring buffer with the same interface and storage 
+ * format as CliHistory of libcli, plus an index of entry start offsets.
+ * 
+ * CliHistory finds the entry boundaries by walking the NUL terminators 
+ * through the ring buffer, so seeking gets slower with longer entries and a 
+ * larger buffer. This class keeps the start offset of every entry in a small
+ * ring of its own, kept up to date on append() and eviction. Seeking is
+ * therefore constant-time and read() only copies the entry.
+ * 
+ * @tparam SIZ      The size of the ring buffer in bytes.
+ * @tparam IDXSIZ   The maximum number of entries.
+ */
+template<size_t SIZ, size_t IDXSIZ = HISTORY_INDEXSIZ>
+class HistoryRing
+{
+    static_assert(SIZ > 1, "HistoryRing needs at least two bytes");
+    static_assert(IDXSIZ > 0, "HistoryRing needs at least one index entry");
+
+    public:
+
+        /**
+         * @brief Type of an offset into the ring buffer.
+         */
+        typedef typename std::conditional<(SIZ <= 0x100), 
+            uint8_t, uint16_t>::type offset_t;
+
+        /**
+         * @brief Type of an entry number.
+         */
+        typedef typename std::conditional<(IDXSIZ < 0x100), 
+            uint8_t, uint16_t>::type count_t;
+
+        /**
+         * @brief Constructor, starts with an empty history.
+         */
+        HistoryRing(void)
+        {
+            clear();
+        }
+
+        /**
+         * @brief Same as CliHistory::is_used, set by the user while the 
+         * history is being browsed and reset by append().
+         */
+        bool is_used;
+
+        /**
+         * @brief Removes all entries.
+         */
+        void clear(void)
+        {
+            head = 0;
+            tail = 0;
+            first = 0;
+            cnt = 0;
+            cur = 0;
+            is_used = false;
+        }
+
+        /**
+         * @brief Adds a new entry and moves the read position to it.
+         * 
+         * Old entries are evicted if there is not enough space in the buffer
+         * or the index is full. If the string is the same as the newest entry 
+         * nothing is written, but the read position is reset anyway.
+         * 
+         * @param str   The NUL terminated string to add.
+         * @param len   The length of the string, str[len] must be NUL.
+         * @return true on success, false if the arguments are invalid.
+         */
+        bool append(const char *str, size_t len)
+        {
+            if (str == nullptr || len == 0 || len > SIZ - 1 || str[len] != 0)
+            {
+                return false;
+            }
+
+            if (cnt == 0 || !equals(cnt - 1, str))
+            {
+                while (cnt > 0 && (cnt == IDXSIZ || get_free_space() < len + 1))
+                {
+                    evict();
+                }
+
+                offs[slot(cnt)] = (offset_t) head;
+                for (size_t i = 0; i <= len; i++)
+                {
+                    buffer[head] = str[i];
+                    head = (offset_t) next(head);
+                }
+                cnt++;
+            }
+
+            cur = cnt - 1;
+            is_used = false;
+
+            return true;
+        }
+
+        /**
+         * @brief Copies the entry at the read position to the given buffer.
+         * @param buf   The buffer.
+         * @param siz   The size of the buffer, including space for the NUL.
+         * @return The length of the entry or 0 if there is no entry, or the
+         * buffer is too small.
+         */
+        size_t read(char *buf, size_t siz)
+        {
+            size_t pos = 0;
+            size_t n = 0;
+
+            if (cnt == 0 || buf == nullptr || siz == 0)
+            {
+                return 0;
+            }
+
+            pos = offs[slot(cur)];
+            while (buffer[pos] != 0)
+            {
+                if (n + 1 >= siz)
+                {
+                    return 0;
+                }
+                buf[n++] = buffer[pos];
+                pos = next(pos);
+            }
+            buf[n] = 0;
+
+            return n;
+        }
+
+        /**
+         * @brief Moves the read position to the next older entry.
+         * @return false if already at the oldest entry.
+         */
+        bool seek_backward(void)
+        {
+            if (cnt == 0 || cur == 0)
+            {
+                return false;
+            }
+
+            cur--;
+            return true;
+        }
+
+        /**
+         * @brief Moves the read position to the next newer entry.
+         * @return false if already at the newest entry.
+         */
+        bool seek_forward(void)
+        {
+            if (cur + 1 >= cnt)
+            {
+                return false;
+            }
+
+            cur++;
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of free bytes in the ring buffer.
+         */
+        size_t get_free_space(void)
+        {
+            if (cnt == 0)
+            {
+                return SIZ;
+            }
+
+            return head > tail ? SIZ - head + tail : tail - head;
+        }
+
+        /**
+         * @brief Returns the number of entries.
+         */
+        size_t get_count(void) const
+        {
+            return cnt;
+        }
+
+        /**
+         * @brief Returns the entry number of the read position, 0 being the 
+         * oldest entry.
+         */
+        size_t get_position(void) const
+        {
+            return cur;
+        }
+
+        /**
+         * @brief Moves the read position to the given entry number.
+         * @return false if there is no such entry.
+         */
+        bool set_position(size_t n)
+        {
+            if (n >= cnt)
+            {
+                return false;
+            }
+
+            cur = (count_t) n;
+            return true;
+        }
+
+        /**
+         * @brief Searches for an entry containing the given pattern, directly
+         * in the ring buffer without copying the entries.
+         * @param pattern   The pattern, it does not need to be NUL terminated.
+         * @param len       The length of the pattern.
+         * @param from      The entry number to start with, the search goes 
+         *                  from there to older entries.
+         * @return The entry number of the match or -1 if there is none.
+         */
+        int find_backward(const char *pattern, size_t len, size_t from) const
+        {
+            if (from >= cnt)
+            {
+                return -1;
+            }
+
+            for (size_t n = from + 1; n-- > 0; )
+            {
+                if (contains(n, pattern, len))
+                {
+                    return (int) n;
+                }
+            }
+
+            return -1;
+        }
+
+        /**
+         * @brief Writes the given entry to a stream, without copying it.
+         * @return The number of characters written.
+         */
+        size_t write_entry(size_t n, Print &out) const
+        {
+            size_t pos = 0;
+            size_t len = 0;
+
+            if (n >= cnt)
+            {
+                return 0;
+            }
+
+            pos = offs[slot(n)];
+            while (buffer[pos] != 0)
+            {
+                out.write((uint8_t) buffer[pos]);
+                pos = next(pos);
+                len++;
+            }
+
+            return len;
+        }
+
+    protected:
+
+        /**
+         * @brief Returns the position following pos in the ring buffer.
+         */
+        static size_t next(size_t pos)
+        {
+            return pos + 1 < SIZ ? pos + 1 : 0;
+        }
+
+        /**
+         * @brief Maps the entry number n, 0 being the oldest, to its slot in
+         * the offset index.
+         */
+        size_t slot(size_t n) const
+        {
+            n += first;
+            return n < IDXSIZ ? n : n - IDXSIZ;
+        }
+
+        /**
+         * @brief Compares entry n with the given string.
+         */
+        bool equals(size_t n, const char *str) const
+        {
+            size_t pos = offs[slot(n)];
+
+            while (buffer[pos] == *str)
+            {
+                if (*str == 0)
+                {
+                    return true;
+                }
+                pos = next(pos);
+                str++;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Tells if entry n contains the pattern.
+         */
+        bool contains(size_t n, const char *pattern, size_t len) const
+        {
+            size_t start = offs[slot(n)];
+
+            if (len == 0)
+            {
+                return true;
+            }
+
+            while (buffer[start] != 0)
+            {
+                size_t pos = start;
+                size_t i = 0;
+
+                while (i < len && buffer[pos] == pattern[i])
+                {
+                    pos = next(pos);
+                    i++;
+                }
+
+                if (i == len)
+                {
+                    return true;
+                }
+                start = next(start);
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Drops the oldest entry, the start of the next entry is 
+         * taken from the index, so no scanning is needed.
+         */
+        void evict(void)
+        {
+            first = (count_t) slot(1);
+            cnt--;
+
+            if (cnt == 0)
+            {
+                clear();
+                return;
+            }
+
+            tail = offs[first];
+            if (cur > 0)
+            {
+                cur--;
+            }
+        }
+
+        /**
+         * @brief The ring buffer holding the NUL terminated entries.
+         */
+        char buffer[SIZ];
+
+        /**
+         * @brief Start offsets of the entries, oldest one at index first.
+         */
+        offset_t offs[IDXSIZ];
+
+        /**
+         * @brief Position where the next entry will be written.
+         */
+        offset_t head;
+
+        /**
+         * @brief Position of the oldest entry.
+         */
+        offset_t tail;
+
+        /**
+         * @brief The slot of the oldest entry in offs.
+         */
+        count_t first;
+
+        /**
+         * @brief The number of entries.
+         */
+        count_t cnt;
+
+        /**
+         * @brief The entry number of the read position, 0 being the oldest.
+         */
+        count_t cur;
+};
+
+#endif /* _HISTORY_HPP_ */
@@ -0,0 +1,419 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#include "historylog.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+bool HistoryMemStore::begin(void)
+{
+    return pMem != nullptr;
+}
+
+size_t HistoryMemStore::size(void)
+{
+    return len;
+}
+
+size_t HistoryMemStore::capacity(void)
+{
+    return siz;
+}
+
+size_t HistoryMemStore::read(size_t offset, char *buf, size_t len)
+{
+    if (offset >= this->len)
+    {
+        return 0;
+    }
+
+    if (len > this->len - offset)
+    {
+        len = this->len - offset;
+    }
+    memcpy(buf, &pMem[offset], len);
+
+    return len;
+}
+
+bool HistoryMemStore::append(const char *buf, size_t len)
+{
+    if (len > siz - this->len)
+    {
+        return false;
+    }
+
+    memcpy(&pMem[this->len], buf, len);
+    this->len += len;
+
+    return true;
+}
+
+bool HistoryMemStore::erase(void)
+{
+    len = 0;
+    return true;
+}
+
+bool HistoryMemStore::rewrite(void)
+{
+    if (pSpare == nullptr)
+    {
+        return erase();
+    }
+
+    spareLen = 0;
+    return true;
+}
+
+bool HistoryMemStore::appendRewrite(const char *buf, size_t len)
+{
+    if (pSpare == nullptr)
+    {
+        return append(buf, len);
+    }
+
+    if (len > siz - spareLen)
+    {
+        return false;
+    }
+
+    memcpy(&pSpare[spareLen], buf, len);
+    spareLen += len;
+
+    return true;
+}
+
+bool HistoryMemStore::commitRewrite(void)
+{
+    char *pTmp = pMem;
+
+    if (pSpare == nullptr)
+    {
+        return true;
+    }
+
+    pMem = pSpare;
+    pSpare = pTmp;
+    len = spareLen;
+
+    return true;
+}
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+bool HistoryFileStore::begin(void)
+{
+    FILE *pFile = fopen(path, "ab");
+
+    if (pFile == nullptr)
+    {
+        return false;
+    }
+
+    fclose(pFile);
+    return true;
+}
+
+size_t HistoryFileStore::size(void)
+{
+    FILE *pFile = fopen(path, "rb");
+    long siz = 0;
+
+    if (pFile == nullptr)
+    {
+        return 0;
+    }
+
+    fseek(pFile, 0, SEEK_END);
+    siz = ftell(pFile);
+    fclose(pFile);
+
+    return siz < 0 ? 0 : (size_t) siz;
+}
+
+size_t HistoryFileStore::capacity(void)
+{
+    return maxSiz;
+}
+
+void HistoryFileStore::closeRead(void)
+{
+    if (pRead != nullptr)
+    {
+        fclose(pRead);
+        pRead = nullptr;
+    }
+}
+
+size_t HistoryFileStore::read(size_t offset, char *buf, size_t len)
+{
+    size_t n = 0;
+
+    if (pRead == nullptr || offset != readPos)
+    {
+        closeRead();
+        pRead = fopen(path, "rb");
+        if (pRead == nullptr || fseek(pRead, (long) offset, SEEK_SET) != 0)
+        {
+            closeRead();
+            return 0;
+        }
+    }
+
+    n = fread(buf, 1, len, pRead);
+    readPos = offset + n;
+    if (n < len)
+    {
+        closeRead();
+    }
+
+    return n;
+}
+
+bool HistoryFileStore::append(const char *buf, size_t len)
+{
+    FILE *pFile = nullptr;
+    size_t n = 0;
+
+    closeRead();
+    pFile = fopen(path, "ab");
+
+    if (pFile == nullptr)
+    {
+        return false;
+    }
+
+    n = fwrite(buf, 1, len, pFile);
+    fclose(pFile);
+
+    return n == len;
+}
+
+bool HistoryFileStore::erase(void)
+{
+    FILE *pFile = nullptr;
+
+    closeRead();
+    pFile = fopen(path, "wb");
+
+    if (pFile == nullptr)
+    {
+        return false;
+    }
+
+    fclose(pFile);
+    return true;
+}
+
+bool HistoryFileStore::rewrite(void)
+{
+    FILE *pFile = fopen(newPath, "wb");
+
+    if (pFile == nullptr)
+    {
+        return false;
+    }
+
+    fclose(pFile);
+    return true;
+}
+
+bool HistoryFileStore::appendRewrite(const char *buf, size_t len)
+{
+    FILE *pFile = fopen(newPath, "ab");
+    size_t n = 0;
+
+    if (pFile == nullptr)
+    {
+        return false;
+    }
+
+    n = fwrite(buf, 1, len, pFile);
+    fclose(pFile);
+
+    return n == len;
+}
+
+bool HistoryFileStore::commitRewrite(void)
+{
+    closeRead();
+    return rename(newPath, path) == 0;
+}
+
+#endif /* ARDUINO_ARCH_NATIVE */
+
+#if HAS_LITTLEFS_SUPPORT
+
+bool HistoryFsStore::begin(void)
+{
+    File file;
+
+    /* The old log is only removed once the new one is complete. */
+    if (fs.exists(newPath))
+    {
+        if (fs.exists(path))
+        {
+            fs.remove(newPath);
+        }
+        else
+        {
+            fs.rename(newPath, path);
+        }
+    }
+
+    file = fs.open(path, "a");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    file.close();
+    return true;
+}
+
+size_t HistoryFsStore::size(void)
+{
+    File file = fs.open(path, "r");
+    size_t siz = 0;
+
+    if (file)
+    {
+        siz = file.size();
+        file.close();
+    }
+
+    return siz;
+}
+
+size_t HistoryFsStore::capacity(void)
+{
+    return maxSiz;
+}
+
+size_t HistoryFsStore::read(size_t offset, char *buf, size_t len)
+{
+    size_t n = 0;
+
+    if (!readFile || offset != readPos)
+    {
+        readFile.close();
+        readFile = fs.open(path, "r");
+        if (!readFile || !readFile.seek(offset))
+        {
+            readFile.close();
+            return 0;
+        }
+    }
+
+    n = readFile.read((uint8_t *) buf, len);
+    readPos = offset + n;
+    if (n < len)
+    {
+        readFile.close();
+    }
+
+    return n;
+}
+
+bool HistoryFsStore::append(const char *buf, size_t len)
+{
+    File file;
+    size_t n = 0;
+
+    readFile.close();
+    file = fs.open(path, "a");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    n = file.write((const uint8_t *) buf, len);
+    file.close();
+
+    return n == len;
+}
+
+bool HistoryFsStore::erase(void)
+{
+    File file;
+
+    readFile.close();
+    file = fs.open(path, "w");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    file.close();
+    return true;
+}
+
+bool HistoryFsStore::rewrite(void)
+{
+    File file = fs.open(newPath, "w");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    file.close();
+    return true;
+}
+
+bool HistoryFsStore::appendRewrite(const char *buf, size_t len)
+{
+    File file = fs.open(newPath, "a");
+    size_t n = 0;
+
+    if (!file)
+    {
+        return false;
+    }
+
+    n = file.write((const uint8_t *) buf, len);
+    file.close();
+
+    return n == len;
+}
+
+bool HistoryFsStore::commitRewrite(void)
+{
+    readFile.close();
+
+    /* Not every file system replaces an existing file by rename(), begin() 
+     * completes the commit if a reset hits in between. */
+    if (fs.rename(newPath, path))
+    {
+        return true;
+    }
+
+    return fs.remove(path) && fs.rename(newPath, path);
+}
+
+#endif /* HAS_LITTLEFS_SUPPORT */
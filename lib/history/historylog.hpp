@@ -0,0 +1,480 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _HISTORYLOG_HPP_
+#define _HISTORYLOG_HPP_
+
+#include "history.hpp"
+
+#include <stdio.h>
+
+/**
+ * @brief Used as central place to check if the platform has a LittleFS 
+ * implementation with the common Arduino FS API.
+ */
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266) ||       \
+    defined(ARDUINO_ARCH_RP2040)
+
+#define HAS_LITTLEFS_SUPPORT    1
+#include <FS.h>
+
+#endif
+
+/**
+ * @brief The chunk size used to read and write the log.
+ */
+#ifndef HISTORYLOG_CHUNKSIZ
+#define HISTORYLOG_CHUNKSIZ     32
+#endif
+
+/**
+ * @brief The size of the path of a log file, including the ".new" suffix of 
+ * the log written by compaction.
+ */
+#ifndef HISTORYLOG_PATHSIZ
+#define HISTORYLOG_PATHSIZ      40
+#endif
+
+/**
+ * @brief Interface of a backing store for the history log.
+ * 
+ * The log is append-only, the only other write operations are erasing it as a
+ * whole and replacing it by a new log. This fits flash file systems as well as
+ * EEPROM or NVS blobs, which all wear out by rewriting the same location over
+ * and over.
+ * 
+ * A new log is written next to the current one by rewrite() and 
+ * appendRewrite() and replaces it in commitRewrite() only, so a reset while 
+ * writing it leaves the current log intact.
+ */
+class HistoryStore
+{
+    public:
+
+        virtual ~HistoryStore() {}
+
+        /**
+         * @brief Opens the store, creates it if it does not exist.
+         * @return false on error.
+         */
+        virtual bool begin(void) = 0;
+
+        /**
+         * @brief Returns the number of bytes in the log.
+         */
+        virtual size_t size(void) = 0;
+
+        /**
+         * @brief Returns the maximum number of bytes the log may grow to.
+         */
+        virtual size_t capacity(void) = 0;
+
+        /**
+         * @brief Reads from the log. Stores on files keep the file open as 
+         * long as the log is read sequentially.
+         * @return The number of bytes read.
+         */
+        virtual size_t read(size_t offset, char *buf, size_t len) = 0;
+
+        /**
+         * @brief Appends to the end of the log.
+         * @return false on error.
+         */
+        virtual bool append(const char *buf, size_t len) = 0;
+
+        /**
+         * @brief Erases the whole log.
+         * @return false on error.
+         */
+        virtual bool erase(void) = 0;
+
+        /**
+         * @brief Starts a new, empty log next to the current one.
+         * @return false on error.
+         */
+        virtual bool rewrite(void) = 0;
+
+        /**
+         * @brief Appends to the end of the new log.
+         * @return false on error.
+         */
+        virtual bool appendRewrite(const char *buf, size_t len) = 0;
+
+        /**
+         * @brief Replaces the current log by the new one.
+         * @return false on error, the current log is kept.
+         */
+        virtual bool commitRewrite(void) = 0;
+};
+
+/**
+ * @brief A history store in RAM, for tests and for platforms where the log 
+ * is written to the final medium by other means.
+ */
+class HistoryMemStore : public HistoryStore
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param pMem      The memory to use, it must survive the store.
+         * @param siz       The size of the memory.
+         * @param pSpare    Memory of the same size the new log is written to
+         *                  by compaction, the two are swapped on commit. 
+         *                  Without it the log is rewritten in place.
+         */
+        HistoryMemStore(char *pMem, size_t siz, char *pSpare = nullptr) : 
+            pMem(pMem), pSpare(pSpare), siz(siz), len(0), spareLen(0) {}
+
+        bool begin(void) override;
+        size_t size(void) override;
+        size_t capacity(void) override;
+        size_t read(size_t offset, char *buf, size_t len) override;
+        bool append(const char *buf, size_t len) override;
+        bool erase(void) override;
+        bool rewrite(void) override;
+        bool appendRewrite(const char *buf, size_t len) override;
+        bool commitRewrite(void) override;
+
+    private:
+
+        char *pMem;
+        char *pSpare;
+        size_t siz;
+        size_t len;
+        size_t spareLen;
+};
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+/**
+ * @brief A history store in a plain file, used by the native environment.
+ */
+class HistoryFileStore : public HistoryStore
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param path      The path of the log file.
+         * @param maxSiz    The maximum size of the log file.
+         */
+        HistoryFileStore(const char *path, size_t maxSiz) : 
+            path(path), maxSiz(maxSiz), pRead(nullptr), readPos(0)
+        {
+            snprintf(newPath, sizeof(newPath), "%s.new", path);
+        }
+
+        ~HistoryFileStore()
+        {
+            closeRead();
+        }
+
+        bool begin(void) override;
+        size_t size(void) override;
+        size_t capacity(void) override;
+        size_t read(size_t offset, char *buf, size_t len) override;
+        bool append(const char *buf, size_t len) override;
+        bool erase(void) override;
+        bool rewrite(void) override;
+        bool appendRewrite(const char *buf, size_t len) override;
+        bool commitRewrite(void) override;
+
+    private:
+
+        void closeRead(void);
+
+        const char *path;
+        size_t maxSiz;
+
+        /**
+         * @brief The path of the log written by compaction.
+         */
+        char newPath[HISTORYLOG_PATHSIZ];
+
+        /**
+         * @brief Kept open while the log is read sequentially.
+         */
+        FILE *pRead;
+        size_t readPos;
+};
+
+#endif /* ARDUINO_ARCH_NATIVE */
+
+#if HAS_LITTLEFS_SUPPORT
+
+/**
+ * @brief A history store in a file on a mounted Arduino file system like 
+ * LittleFS. The file system has to be mounted by the application.
+ */
+class HistoryFsStore : public HistoryStore
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param fs        The file system, e.g. LittleFS.
+         * @param path      The path of the log file.
+         * @param maxSiz    The maximum size of the log file.
+         */
+        HistoryFsStore(fs::FS &fs, const char *path, size_t maxSiz) : 
+            fs(fs), path(path), maxSiz(maxSiz), readPos(0)
+        {
+            snprintf(newPath, sizeof(newPath), "%s.new", path);
+        }
+
+        /**
+         * @brief Opens the log. A new log left by a compaction which has 
+         * been cut by a reset is completed or dropped.
+         */
+        bool begin(void) override;
+        size_t size(void) override;
+        size_t capacity(void) override;
+        size_t read(size_t offset, char *buf, size_t len) override;
+        bool append(const char *buf, size_t len) override;
+        bool erase(void) override;
+        bool rewrite(void) override;
+        bool appendRewrite(const char *buf, size_t len) override;
+        bool commitRewrite(void) override;
+
+    private:
+
+        fs::FS &fs;
+        const char *path;
+        size_t maxSiz;
+
+        /**
+         * @brief The path of the log written by compaction.
+         */
+        char newPath[HISTORYLOG_PATHSIZ];
+
+        /**
+         * @brief Kept open while the log is read sequentially.
+         */
+        File readFile;
+        size_t readPos;
+};
+
+#endif /* HAS_LITTLEFS_SUPPORT */
+
+/**
+ * @brief A HistoryRing which mirrors every append() into an append-only log
+ * on a HistoryStore and restores itself from the log in begin().
+ * 
+ * The log holds the entries in the same format as the ring buffer, NUL 
+ * terminated and oldest first. New entries are only ever appended, so each 
+ * byte of the medium is written once until the log reaches the capacity of 
+ * the store. Then the log is compacted: a new log with the entries still in 
+ * the ring buffer is written next to it and replaces it once complete, so a
+ * reset during compaction loses nothing. A larger store therefore means less 
+ * wear, as compaction happens once every (capacity - SIZ) appended bytes.
+ * 
+ * A record which has been cut by a reset while writing has no terminating
+ * NUL. It is dropped on restore and the log is compacted, so that the next
+ * entry is not appended to the fragment. The capacity of the store must be at
+ * least SIZ bytes, otherwise compaction fails.
+ * 
+ * @tparam SIZ      The size of the ring buffer in bytes.
+ * @tparam IDXSIZ   The maximum number of entries.
+ */
+template<size_t SIZ, size_t IDXSIZ = HISTORY_INDEXSIZ>
+class PersistentHistory : public HistoryRing<SIZ, IDXSIZ>
+{
+    typedef HistoryRing<SIZ, IDXSIZ> Ring;
+
+    public:
+
+        PersistentHistory(void) : pStore(nullptr), compactions(0) {}
+
+        /**
+         * @brief Opens the store and rebuilds the ring buffer from the log by 
+         * reading it once from start to end.
+         * @param pStore    The store to use.
+         * @return false if the store could not be opened or a cut record 
+         * could not be removed from the log.
+         */
+        bool begin(HistoryStore *pStore)
+        {
+            char chunk[HISTORYLOG_CHUNKSIZ];
+            char line[SIZ];
+            size_t logSiz = 0;
+            size_t n = 0;
+            bool overflow = false;
+
+            this->pStore = pStore;
+            Ring::clear();
+
+            if (pStore == nullptr || !pStore->begin())
+            {
+                this->pStore = nullptr;
+                return false;
+            }
+
+            logSiz = pStore->size();
+            for (size_t off = 0; off < logSiz; off += sizeof(chunk))
+            {
+                size_t len = pStore->read(off, chunk, sizeof(chunk));
+
+                for (size_t i = 0; i < len; i++)
+                {
+                    if (chunk[i] == 0)
+                    {
+                        line[n] = 0;
+                        if (n > 0 && !overflow)
+                        {
+                            Ring::append(line, n);
+                        }
+                        n = 0;
+                        overflow = false;
+                    }
+                    else if (n < SIZ - 1)
+                    {
+                        line[n++] = chunk[i];
+                    }
+                    else
+                    {
+                        overflow = true;
+                    }
+                }
+
+                if (len < sizeof(chunk))
+                {
+                    break;
+                }
+            }
+
+            /* Rewrite the log without the fragment of a cut record. */
+            if (n > 0 || overflow)
+            {
+                return compact();
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Same as HistoryRing::append(), new entries are also appended
+         * to the log. Duplicates of the newest entry are not logged.
+         */
+        bool append(const char *str, size_t len)
+        {
+            bool duplicate = this->cnt > 0 && str != nullptr && 
+                Ring::equals(this->cnt - 1, str);
+
+            if (!Ring::append(str, len))
+            {
+                return false;
+            }
+
+            if (duplicate || pStore == nullptr)
+            {
+                return true;
+            }
+
+            if (pStore->size() + len + 1 > pStore->capacity())
+            {
+                return compact();
+            }
+
+            return pStore->append(str, len + 1);
+        }
+
+        /**
+         * @brief Same as HistoryRing::clear(), the log is erased too.
+         */
+        void clear(void)
+        {
+            Ring::clear();
+            if (pStore != nullptr)
+            {
+                pStore->erase();
+            }
+        }
+
+        /**
+         * @brief Replaces the log by a new one with the entries in the ring 
+         * buffer.
+         * @return false on error, the log is left as it was.
+         */
+        bool compact(void)
+        {
+            char chunk[HISTORYLOG_CHUNKSIZ];
+            size_t n = 0;
+
+            if (pStore == nullptr || !pStore->rewrite())
+            {
+                return false;
+            }
+
+            compactions++;
+            for (size_t e = 0; e < this->cnt; e++)
+            {
+                size_t pos = this->offs[Ring::slot(e)];
+                char c = 0;
+
+                do
+                {
+                    c = this->buffer[pos];
+                    chunk[n++] = c;
+                    if (n == sizeof(chunk))
+                    {
+                        if (!pStore->appendRewrite(chunk, n))
+                        {
+                            return false;
+                        }
+                        n = 0;
+                    }
+                    pos = Ring::next(pos);
+                } while (c != 0);
+            }
+
+            if (n > 0 && !pStore->appendRewrite(chunk, n))
+            {
+                return false;
+            }
+
+            return pStore->commitRewrite();
+        }
+
+        /**
+         * @brief Returns how often the log has been compacted.
+         */
+        uint32_t get_compactions(void) const
+        {
+            return compactions;
+        }
+
+    private:
+
+        /**
+         * @brief The store to mirror to, nullptr if not persistent.
+         */
+        HistoryStore *pStore;
+
+        /**
+         * @brief The number of compactions since begin().
+         */
+        uint32_t compactions;
+};
+
+#endif /* _HISTORYLOG_HPP_ */
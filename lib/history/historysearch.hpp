@@ -0,0 +1,548 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _HISTORYSEARCH_HPP_
+#define _HISTORYSEARCH_HPP_
+
+#include "history.hpp"
+#include "compacthistory.hpp"
+#include "cmdjob.hpp"
+
+#include <cli/cli.hpp>
+
+/**
+ * @brief Used as central place to check if reverse search is built, it needs
+ * the history and is left out for resource usage tests.
+ */
+#if !defined(RESOURCE_USAGE_TEST) && CLI_HISTORYSIZ > 0
+#define HAS_REVERSE_SEARCH      1
+#endif
+
+#if HAS_REVERSE_SEARCH
+
+/**
+ * @brief The history searched by Ctrl-R on a console.
+ */
+#if HISTORY_COMPACT
+typedef CompactHistory<CLI_HISTORYSIZ> ConsoleHistory;
+#else
+typedef HistoryRing<CLI_HISTORYSIZ> ConsoleHistory;
+#endif
+
+#endif
+
+/**
+ * @brief The maximum length of a search pattern.
+ */
+#ifndef HISTORYSEARCH_PATTERNSIZ
+#define HISTORYSEARCH_PATTERNSIZ    32
+#endif
+
+/**
+ * @brief Incremental reverse search over a HistoryRing, the engine behind 
+ * Ctrl-R. 
+ * 
+ * The pattern is matched directly inside the ring buffer. Each added 
+ * character continues the search from the current hit instead of starting 
+ * over, as every older match of the longer pattern is also an older match of 
+ * the shorter one. The hit of each pattern length is remembered, so deleting 
+ * a character goes back to the previous hit without searching at all.
+ * 
+ * @tparam H    The HistoryRing type.
+ */
+template<class H>
+class HistorySearch
+{
+    public:
+
+        HistorySearch(H &history) : history(history), len(0) 
+        {
+            hits[0] = -1;
+        }
+
+        /**
+         * @brief Starts a new search at the newest entry.
+         */
+        void begin(void)
+        {
+            len = 0;
+            hits[0] = (int) history.get_count() - 1;
+        }
+
+        /**
+         * @brief Adds a character to the pattern.
+         * @return false if there is no match, or the pattern is too long.
+         */
+        bool add(char c)
+        {
+            int hit = hits[len];
+
+            if (len >= HISTORYSEARCH_PATTERNSIZ)
+            {
+                return false;
+            }
+
+            pattern[len++] = c;
+            if (hit >= 0)
+            {
+                hit = history.find_backward(pattern, len, hit);
+            }
+            hits[len] = hit;
+
+            return hit >= 0;
+        }
+
+        /**
+         * @brief Removes the last character of the pattern and goes back to 
+         * the hit found before it has been added.
+         */
+        void remove(void)
+        {
+            if (len > 0)
+            {
+                len--;
+            }
+        }
+
+        /**
+         * @brief Searches the next older match of the pattern, as done when 
+         * Ctrl-R is pressed again.
+         * @return false if there is none, the current hit is kept then.
+         */
+        bool next(void)
+        {
+            int hit = hits[len];
+
+            if (hit <= 0)
+            {
+                return false;
+            }
+
+            hit = history.find_backward(pattern, len, hit - 1);
+            if (hit < 0)
+            {
+                return false;
+            }
+
+            hits[len] = hit;
+            return true;
+        }
+
+        /**
+         * @brief Returns the entry number of the current hit or -1.
+         */
+        int getHit(void) const
+        {
+            return hits[len];
+        }
+
+        /**
+         * @brief Writes the pattern to the given stream.
+         */
+        void writePattern(Print &out) const
+        {
+            out.write((const uint8_t *) pattern, len);
+        }
+
+    private:
+
+        H &history;
+        char pattern[HISTORYSEARCH_PATTERNSIZ];
+        int hits[HISTORYSEARCH_PATTERNSIZ + 1];
+        size_t len;
+};
+
+/**
+ * @brief A Stream placed between a terminal stream and a Cli instance which 
+ * adds bash like Ctrl-R reverse search.
+ * 
+ * Input from the terminal is passed on to the Cli, except while searching: 
+ * then the keys edit the search pattern and the current match is shown in 
+ * place of the command line. Enter executes the match, ESC or an arrow key 
+ * puts it on the command line for editing and Ctrl-G or Ctrl-C cancel. 
+ * 
+ * The Cli keeps its own history inside libcli, which offers no access to it.
+ * Therefore this stream records the lines it passes on in a HistoryRing of its
+ * own, which costs the same RAM as the history of the Cli again. Lines edited
+ * with arrow keys can not be followed and are not recorded. Lines read by a 
+ * job of the CmdJob above, e.g. a pasted script, are no commands of the Cli 
+ * and are not recorded either. Ctrl-R is only handled on an empty command 
+ * line, otherwise it is passed on.
+ * 
+ * Usage: 
+ *   HistoryRing<CLI_HISTORYSIZ> history;
+ *   SearchStream<HistoryRing<CLI_HISTORYSIZ>> input(Serial, history);
+ *   CmdJob job(input);
+ *   input.setJob(job);
+ *   cli.begin(&job);
+ * 
+ * @tparam H    The HistoryRing type.
+ */
+template<class H>
+class SearchStream : public Stream
+{
+    public:
+
+        SearchStream(Stream &io, H &history) : io(&io), history(history),
+            pJob(nullptr), search(history), searching(false), skipEsc(0), 
+            lineLen(0), lineKnown(true), escSeq(false), qHead(0), qCnt(0) {}
+
+        /**
+         * @brief Sets the terminal stream, used by sessions which get their 
+         * client when connected.
+         */
+        void setStream(Stream &io)
+        {
+            this->io = &io;
+            searching = false;
+            skipEsc = 0;
+            lineLen = 0;
+            lineKnown = true;
+            qCnt = 0;
+        }
+
+        int available(void) override
+        {
+            pump();
+            return (int) qCnt;
+        }
+
+        int read(void) override
+        {
+            char c = 0;
+
+            pump();
+            if (qCnt == 0)
+            {
+                return -1;
+            }
+
+            c = queue[qHead];
+            qHead = (qHead + 1) % sizeof(queue);
+            qCnt--;
+
+            return (uint8_t) c;
+        }
+
+        int peek(void) override
+        {
+            pump();
+            return qCnt == 0 ? -1 : (uint8_t) queue[qHead];
+        }
+
+        size_t write(uint8_t c) override
+        {
+            return io->write(c);
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) override
+        {
+            return io->write(buffer, size);
+        }
+
+        void flush(void) override
+        {
+            io->flush();
+        }
+
+        /**
+         * @brief Sets the CmdJob reading from this stream, lines read by its 
+         * jobs are not recorded.
+         */
+        void setJob(const CmdJob &job)
+        {
+            pJob = &job;
+        }
+
+        /**
+         * @brief Tells if a search is in progress.
+         */
+        bool isSearching(void) const
+        {
+            return searching;
+        }
+
+    private:
+
+        /**
+         * @brief Reads from the terminal until there is input for the Cli.
+         */
+        void pump(void)
+        {
+            while (qCnt == 0 && io->available() > 0)
+            {
+                int c = io->read();
+
+                if (c < 0)
+                {
+                    break;
+                }
+
+                if (skipEsc > 0 && skipSequence((char) c))
+                {
+                    continue;
+                }
+
+                if (searching)
+                {
+                    handleSearch((char) c);
+                }
+                else if (c == CTRL_R && lineKnown && lineLen == 0 && 
+                    !isReading())
+                {
+                    searching = true;
+                    search.begin();
+                    render();
+                }
+                else
+                {
+                    pass((char) c);
+                }
+            }
+        }
+
+        /**
+         * @brief Handles a key while searching.
+         */
+        void handleSearch(char c)
+        {
+            int hit = search.getHit();
+
+            switch (c)
+            {
+                case CTRL_R:
+                    if (!search.next())
+                    {
+                        io->write('\a');
+                    }
+                    break;
+
+                case '\b':
+                case 0x7f:
+                    search.remove();
+                    break;
+
+                case '\r':
+                case '\n':
+                case 0x1b:
+                    clearLine();
+                    searching = false;
+                    skipEsc = c == 0x1b ? 1 : 0;
+                    if (hit >= 0)
+                    {
+                        history.set_position(hit);
+                        injectEntry(hit);
+                        if (c != 0x1b)
+                        {
+                            pass('\r');
+                        }
+                    }
+                    return;
+
+                case CTRL_C:
+                case CTRL_G:
+                    clearLine();
+                    searching = false;
+                    return;
+
+                default:
+                    if (c >= ' ' && !search.add(c))
+                    {
+                        io->write('\a');
+                    }
+                    break;
+            }
+
+            render();
+        }
+
+        /**
+         * @brief Swallows the rest of an escape sequence which ended a search,
+         * so that an arrow key does not recall another line right away.
+         * @return true if the character has been swallowed.
+         */
+        bool skipSequence(char c)
+        {
+            if (skipEsc == 1)
+            {
+                skipEsc = (c == '[' || c == 'O') ? 2 : 0;
+                return skipEsc == 2;
+            }
+
+            if ((c >= '0' && c <= '9') || c == ';')
+            {
+                return true;
+            }
+
+            skipEsc = 0;
+            return true;
+        }
+
+        /**
+         * @brief Tells if a job reads the input, it gets no commands then.
+         */
+        bool isReading(void) const
+        {
+            return pJob != nullptr && pJob->isReading();
+        }
+
+        /**
+         * @brief Shows the search pattern and the current match.
+         */
+        void render(void)
+        {
+            int hit = search.getHit();
+
+            io->print("\r\033[K");
+            io->print(hit < 0 ? "(failed reverse-i-search)`" : 
+                "(reverse-i-search)`");
+            search.writePattern(*io);
+            io->print("': ");
+            if (hit >= 0)
+            {
+                history.write_entry(hit, *io);
+            }
+        }
+
+        /**
+         * @brief Removes the search line and shows the prompt again.
+         */
+        void clearLine(void)
+        {
+            io->print("\r\033[K");
+            io->print(CLI_PROMPT);
+        }
+
+        /**
+         * @brief Passes the given entry to the Cli as if it has been typed,
+         * the characters are taken one by one from the ring buffer.
+         */
+        void injectEntry(int n)
+        {
+            QueueWriter writer(*this);
+            history.write_entry(n, writer);
+        }
+
+        /**
+         * @brief Passes a character to the Cli and follows the command line, 
+         * so that complete lines can be recorded in the history.
+         */
+        void pass(char c)
+        {
+            if (qCnt < sizeof(queue))
+            {
+                queue[(qHead + qCnt) % sizeof(queue)] = c;
+                qCnt++;
+            }
+
+            if (c == '\r' || c == '\n')
+            {
+                if (lineKnown && lineLen > 0 && !isReading())
+                {
+                    line[lineLen] = 0;
+                    history.append(line, lineLen);
+                }
+                lineLen = 0;
+                lineKnown = true;
+                escSeq = false;
+            }
+            else if (c == 0x1b || escSeq)
+            {
+                /* Cursor and history keys change the line in ways we can not
+                 * follow, wait for the end of the sequence and the line. */
+                escSeq = c == 0x1b || c == '[' || (c >= '0' && c <= '9');
+                lineKnown = false;
+            }
+            else if (c == '\b' || c == 0x7f)
+            {
+                if (lineLen > 0)
+                {
+                    lineLen--;
+                }
+            }
+            else if (c >= ' ' && lineLen < sizeof(line) - 1)
+            {
+                line[lineLen++] = c;
+            }
+            else
+            {
+                /* Tab completion, overlong lines and other control keys. */
+                lineKnown = false;
+            }
+        }
+
+        /**
+         * @brief Adapter used to inject a history entry without copying it to
+         * a temporary buffer first.
+         */
+        class QueueWriter : public Print
+        {
+            public:
+
+                QueueWriter(SearchStream &owner) : owner(owner) {}
+
+                size_t write(uint8_t c) override
+                {
+                    owner.pass((char) c);
+                    return 1;
+                }
+
+                using Print::write;
+
+            private:
+
+                SearchStream &owner;
+        };
+
+        static const char CTRL_C = 0x03;
+        static const char CTRL_G = 0x07;
+        static const char CTRL_R = 0x12;
+
+        Stream *io;
+        H &history;
+        const CmdJob *pJob;
+        HistorySearch<H> search;
+        bool searching;
+
+        /**
+         * @brief 1 after ESC ended a search, 2 within the following sequence.
+         */
+        uint8_t skipEsc;
+
+        /**
+         * @brief The command line as passed on to the Cli.
+         */
+        char line[CLI_COMMANDSIZ];
+        size_t lineLen;
+        bool lineKnown;
+        bool escSeq;
+
+        /**
+         * @brief Characters waiting to be read by the Cli.
+         */
+        char queue[CLI_COMMANDSIZ];
+        size_t qHead;
+        size_t qCnt;
+};
+
+#endif /* _HISTORYSEARCH_HPP_ */
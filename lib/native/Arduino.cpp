@@ -0,0 +1,245 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#include "Arduino.h"
+
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+
+/**
+ * @brief The state of the simulated GPIO pins, only used to make digitalRead()
+ * return what has been written.
+ */
+static uint8_t pinState[256];
+
+/**
+ * @brief Terminal settings of stdin to restore at exit.
+ */
+static struct termios termOrig;
+static bool termChanged = false;
+
+HostSerial Serial;
+
+static uint64_t nowUs(void)
+{
+    static uint64_t start = 0;
+    struct timespec ts;
+    uint64_t us = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    us = (uint64_t) ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+    if (start == 0)
+    {
+        start = us;
+    }
+
+    return us - start;
+}
+
+uint32_t millis(void)
+{
+    return (uint32_t) (nowUs() / 1000);
+}
+
+uint32_t micros(void)
+{
+    return (uint32_t) nowUs();
+}
+
+void delay(uint32_t ms)
+{
+    usleep(ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    usleep(us);
+}
+
+void yield(void)
+{
+    // nothing to do
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    // nothing to do
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    pinState[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin)
+{
+    return pinState[pin];
+}
+
+void randomSeed(unsigned long seed)
+{
+    srand(seed);
+}
+
+long random(long max)
+{
+    return max > 0 ? rand() % max : 0;
+}
+
+long random(long min, long max)
+{
+    return max > min ? min + random(max - min) : min;
+}
+
+static void termRestore(void)
+{
+    if (termChanged)
+    {
+        tcsetattr(STDIN_FILENO, TCSANOW, &termOrig);
+        termChanged = false;
+    }
+}
+
+void HostSerial::begin(unsigned long baud)
+{
+    struct termios term;
+
+    if (started)
+    {
+        return;
+    }
+
+    started = true;
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &termOrig) == 0)
+    {
+        term = termOrig;
+        term.c_lflag &= ~(ICANON | ECHO);
+        term.c_cc[VMIN] = 1;
+        term.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &term);
+        termChanged = true;
+        atexit(termRestore);
+    }
+}
+
+void HostSerial::end(void)
+{
+    termRestore();
+    started = false;
+}
+
+void HostSerial::fill(void)
+{
+    struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    uint8_t c = 0;
+
+    if (lookahead >= 0 || eof)
+    {
+        return;
+    }
+
+    if (poll(&pfd, 1, 0) <= 0)
+    {
+        return;
+    }
+
+    if (::read(STDIN_FILENO, &c, 1) == 1)
+    {
+        lookahead = c;
+    }
+    else
+    {
+        eof = true;
+    }
+}
+
+int HostSerial::available(void)
+{
+    fill();
+    return lookahead >= 0 ? 1 : 0;
+}
+
+int HostSerial::read(void)
+{
+    int c = 0;
+
+    fill();
+    c = lookahead;
+    lookahead = -1;
+
+    return c;
+}
+
+int HostSerial::peek(void)
+{
+    fill();
+    return lookahead;
+}
+
+size_t HostSerial::write(uint8_t c)
+{
+    return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size)
+{
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HostSerial::flush(void)
+{
+    fflush(stdout);
+}
+
+bool HostSerial::finished(void)
+{
+    fill();
+    return eof && lookahead < 0;
+}
+
+/**
+ * @brief Runs the sketch like an Arduino core does. Output is flushed after 
+ * each iteration so that interactive sessions behave like a serial terminal.
+ */
+int main(void)
+{
+    setup();
+
+    while (!Serial.finished() || (hostBusy != nullptr && hostBusy()))
+    {
+        loop();
+        Serial.flush();
+
+        if (Serial.available() == 0)
+        {
+            usleep(100);
+        }
+    }
+
+    Serial.flush();
+    termRestore();
+
+    return hostResult != nullptr ? hostResult() : 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _NATIVE_ARDUINO_H_
+#define _NATIVE_ARDUINO_H_
+
+/**
+ * This is not an Arduino core. It provides just enough of the Arduino API to 
+ * build clidemo, libcli and the unit tests on the host by using the "native" 
+ * environment in platformio.ini. The serial port is mapped to stdin/stdout.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Print.h"
+#include "Stream.h"
+
+/**
+ * @brief Used as central place to check if we are building for the host.
+ */
+#define ARDUINO_ARCH_NATIVE         1
+
+#define HIGH                        0x1
+#define LOW                         0x0
+
+#define INPUT                       0x0
+#define OUTPUT                      0x1
+
+#define LED_BUILTIN                 13
+
+#define PROGMEM
+#define PSTR(_str)                  (_str)
+#define F(_str)                     (_str)
+#define pgm_read_byte(_addr)        (*(const uint8_t *) (_addr))
+#define memcpy_P                    memcpy
+#define strncpy_P                   strncpy
+
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+void randomSeed(unsigned long seed);
+long random(long max);
+long random(long min, long max);
+
+/**
+ * @brief Provided by the sketch, called by the host main().
+ */
+void setup(void);
+
+/**
+ * @brief Provided by the sketch, called by the host main().
+ */
+void loop(void);
+
+/**
+ * @brief Optionally provided by the sketch, the host main() keeps calling 
+ * loop() after the end of the input while it returns true, e.g. while a 
+ * command is still running.
+ */
+bool hostBusy(void) __attribute__((weak));
+
+/**
+ * @brief Optionally provided by the sketch, the exit status of the host 
+ * main(), e.g. to report failed tests to a script.
+ */
+int hostResult(void) __attribute__((weak));
+
+/**
+ * @brief The serial port of the host, reads from stdin and writes to stdout.
+ * 
+ * If stdin is a terminal it is switched to non canonical mode without echo so
+ * that libcli gets every key as it is typed, like on a real serial port. When
+ * stdin is a pipe or a file the program terminates as soon as all input has 
+ * been consumed, which allows to run scripted sessions like:
+ * 
+ *   echo "test all" | .pio/build/native/program
+ */
+class HostSerial : public Stream
+{
+    public:
+
+        HostSerial(void) : started(false), eof(false), lookahead(-1) {}
+
+        void begin(unsigned long baud);
+        void end(void);
+
+        int available(void) override;
+        int read(void) override;
+        int peek(void) override;
+
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+        using Print::write;
+
+        void flush(void) override;
+
+        /**
+         * @brief Tells if stdin has been closed and all input is consumed.
+         */
+        bool finished(void);
+
+        operator bool() const 
+        {
+            return true;
+        }
+
+    private:
+
+        /**
+         * @brief Fetches the next byte from stdin into the lookahead without 
+         * blocking.
+         */
+        void fill(void);
+
+        bool started;
+        bool eof;
+        int lookahead;
+};
+
+extern HostSerial Serial;
+
+#endif /* _NATIVE_ARDUINO_H_ */
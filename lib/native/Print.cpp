@@ -0,0 +1,173 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#include "Print.h"
+
+#include <stdio.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t n = 0;
+
+    while (size--)
+    {
+        if (write(*buffer++) == 0)
+        {
+            break;
+        }
+        n++;
+    }
+
+    return n;
+}
+
+size_t Print::print(const char *str)
+{
+    return write(str);
+}
+
+size_t Print::print(char c)
+{
+    return write((uint8_t) c);
+}
+
+size_t Print::print(int val, int base)
+{
+    return print((long) val, base);
+}
+
+size_t Print::print(unsigned int val, int base)
+{
+    return print((unsigned long) val, base);
+}
+
+size_t Print::print(long val, int base)
+{
+    if (base == 10 && val < 0)
+    {
+        return printNumber(-(unsigned long) val, base, true);
+    }
+
+    return printNumber((unsigned long) val, base, false);
+}
+
+size_t Print::print(unsigned long val, int base)
+{
+    return printNumber(val, base, false);
+}
+
+size_t Print::println(void)
+{
+    return write("\n");
+}
+
+size_t Print::println(const char *str)
+{
+    return print(str) + println();
+}
+
+size_t Print::println(char c)
+{
+    return print(c) + println();
+}
+
+size_t Print::println(int val, int base)
+{
+    return print(val, base) + println();
+}
+
+size_t Print::println(unsigned int val, int base)
+{
+    return print(val, base) + println();
+}
+
+size_t Print::println(long val, int base)
+{
+    return print(val, base) + println();
+}
+
+size_t Print::println(unsigned long val, int base)
+{
+    return print(val, base) + println();
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buf[256];
+    char *pBuf = buf;
+    va_list args;
+    int len = 0;
+
+    va_start(args, format);
+    len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+
+    if (len < 0)
+    {
+        return 0;
+    }
+
+    /* Same as the ESP32 core: fall back to the heap for long output. */
+    if ((size_t) len >= sizeof(buf))
+    {
+        pBuf = new char[len + 1];
+        va_start(args, format);
+        vsnprintf(pBuf, len + 1, format, args);
+        va_end(args);
+    }
+
+    len = write((const uint8_t *) pBuf, len);
+
+    if (pBuf != buf)
+    {
+        delete[] pBuf;
+    }
+
+    return len;
+}
+
+size_t Print::printNumber(unsigned long val, int base, bool negative)
+{
+    char buf[8 * sizeof(long) + 2];
+    char *str = &buf[sizeof(buf) - 1];
+
+    if (base < 2)
+    {
+        base = 10;
+    }
+
+    *str = '\0';
+    do
+    {
+        unsigned long digit = val % base;
+        val /= base;
+        *--str = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    } while (val);
+
+    if (negative)
+    {
+        *--str = '-';
+    }
+
+    return write(str);
+}
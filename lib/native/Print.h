@@ -0,0 +1,96 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _NATIVE_PRINT_H_
+#define _NATIVE_PRINT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+
+/**
+ * @brief Host version of the Arduino Print class.
+ * Only the subset used by clidemo, libcli and libgeneric is provided. Derived 
+ * classes have to implement write(uint8_t), everything else is built on top.
+ */
+class Print
+{
+    public:
+
+        virtual ~Print() {}
+
+        /**
+         * @brief Writes a single byte.
+         * @return The number of bytes written.
+         */
+        virtual size_t write(uint8_t c) = 0;
+
+        /**
+         * @brief Writes a block of bytes, override it if the sink can do 
+         * better than byte by byte.
+         */
+        virtual size_t write(const uint8_t *buffer, size_t size);
+
+        size_t write(const char *str)
+        {
+            return str == nullptr ? 0 : write((const uint8_t *) str, strlen(str));
+        }
+
+        size_t write(const char *buffer, size_t size)
+        {
+            return write((const uint8_t *) buffer, size);
+        }
+
+        /**
+         * @brief Does nothing by default, override it if the sink buffers.
+         */
+        virtual void flush(void) {}
+
+        size_t print(const char *str);
+        size_t print(char c);
+        size_t print(int val, int base = 10);
+        size_t print(unsigned int val, int base = 10);
+        size_t print(long val, int base = 10);
+        size_t print(unsigned long val, int base = 10);
+
+        size_t println(void);
+        size_t println(const char *str);
+        size_t println(char c);
+        size_t println(int val, int base = 10);
+        size_t println(unsigned int val, int base = 10);
+        size_t println(long val, int base = 10);
+        size_t println(unsigned long val, int base = 10);
+
+        /**
+         * @brief Same as on ESP32, RP2040 and STM32 cores.
+         */
+        size_t printf(const char *format, ...)
+            __attribute__ ((format (printf, 2, 3)));
+
+    private:
+
+        size_t printNumber(unsigned long val, int base, bool negative);
+};
+
+#endif /* _NATIVE_PRINT_H_ */
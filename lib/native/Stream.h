@@ -0,0 +1,52 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _NATIVE_STREAM_H_
+#define _NATIVE_STREAM_H_
+
+#include "Print.h"
+
+/**
+ * @brief Host version of the Arduino Stream class.
+ */
+class Stream : public Print
+{
+    public:
+
+        /**
+         * @brief Returns the number of bytes which can be read right now.
+         */
+        virtual int available(void) = 0;
+
+        /**
+         * @brief Returns the next byte or -1 if there is none.
+         */
+        virtual int read(void) = 0;
+
+        /**
+         * @brief Returns the next byte without consuming it, -1 if none.
+         */
+        virtual int peek(void) = 0;
+};
+
+#endif /* _NATIVE_STREAM_H_ */
@@ -0,0 +1,373 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _SCHEDULER_HPP_
+#define _SCHEDULER_HPP_
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * @brief Enables the runtime statistics of the scheduled jobs, costs two 
+ * micros() calls per run.
+ */
+#ifndef SCHEDULER_STATS
+#define SCHEDULER_STATS         1
+#endif
+
+/**
+ * @brief The number of buckets of the execution time histogram, bucket i 
+ * counts runs shorter than 10^(i+1) us, the last one all longer runs.
+ */
+#define SCHEDULER_HISTSIZ       5
+
+/**
+ * @brief The function of a scheduled job, same as used by Task of libgeneric.
+ */
+typedef void (*schedFunc_t)(uint32_t now);
+
+/**
+ * @brief Runtime statistics of a scheduled job.
+ */
+typedef struct {
+
+    /**
+     * @brief The number of runs.
+     */
+    uint32_t runs;
+
+    /**
+     * @brief The execution time of the last run and the longest one in us.
+     */
+    uint32_t lastUs;
+    uint32_t maxUs;
+
+    /**
+     * @brief The sum of all execution times in us, for the average.
+     */
+    uint64_t totalUs;
+
+    /**
+     * @brief How late the last run and the latest one started compared to 
+     * its deadline, in ms.
+     */
+    uint32_t lateMs;
+    uint32_t maxLateMs;
+
+    /**
+     * @brief Execution time histogram, see SCHEDULER_HISTSIZ.
+     */
+    uint32_t hist[SCHEDULER_HISTSIZ];
+
+} schedStats_t;
+
+/**
+ * @brief Runs periodic jobs, touching only the ones which are due.
+ * 
+ * Polling a Task per job costs a call and a compare per job on every loop, 
+ * no matter if anything is due. Here the jobs are kept in a binary min-heap
+ * ordered by their next deadline, so loop() only looks at the top of the heap
+ * and a due job costs O(log n) to be put back. That is not faster in general,
+ * with many jobs due per loop the heap work can outweigh the compares saved,
+ * see `bench scheduler`. What it adds is getNext(), the time the loop may 
+ * sleep. Deadlines are compared wrap safe, periods must be shorter than 
+ * 2^31 ms.
+ * 
+ * A job keeps its phase: the next deadline is the last one plus the period. 
+ * If a job fell behind by a period or more, the missed runs are skipped 
+ * instead of being run back to back.
+ * 
+ * With SCHEDULER_STATS each run is timed, the run count, execution times, 
+ * lateness and a histogram are kept per job, see schedStats_t.
+ * 
+ * @tparam N    The maximum number of jobs.
+ */
+template<size_t N>
+class Scheduler
+{
+    static_assert(N > 0, "Scheduler needs at least one job");
+
+    public:
+
+        /**
+         * @brief Type of a job id and heap position.
+         */
+        typedef typename std::conditional<(N < 0x100), 
+            uint8_t, uint16_t>::type id_t;
+
+        Scheduler(void) : cnt(0) {}
+
+        /**
+         * @brief Adds a job.
+         * @param func      The function to run.
+         * @param period    The period in ms.
+         * @param now       The current time, the first run is due one period 
+         *                  later.
+         * @param name      Optional name of the job for the statistics.
+         * @return The id of the job or -1 if the scheduler is full.
+         */
+        int add(schedFunc_t func, uint32_t period, uint32_t now, 
+            const char *name = nullptr)
+        {
+            if (cnt == N || func == nullptr || period == 0)
+            {
+                return -1;
+            }
+
+            jobs[cnt].func = func;
+            jobs[cnt].period = period;
+            jobs[cnt].deadline = now + period;
+            jobs[cnt].name = name;
+#if SCHEDULER_STATS
+            memset(&jobs[cnt].stats, 0, sizeof(jobs[cnt].stats));
+#endif
+            heap[cnt] = (id_t) cnt;
+            cnt++;
+            up(cnt - 1);
+
+            return (int) cnt - 1;
+        }
+
+        /**
+         * @brief Runs all jobs which are due.
+         * @return The number of jobs run.
+         */
+        size_t loop(uint32_t now)
+        {
+            size_t runs = 0;
+
+            while (cnt > 0 && !before(now, jobs[heap[0]].deadline))
+            {
+                Job &job = jobs[heap[0]];
+#if SCHEDULER_STATS
+                uint32_t late = now - job.deadline;
+#endif
+
+                job.deadline += job.period;
+                if (!before(now, job.deadline))
+                {
+                    job.deadline = now + job.period;
+                }
+                down(0);
+
+#if SCHEDULER_STATS
+                uint32_t start = micros();
+                job.func(now);
+                record(job.stats, micros() - start, late);
+#else
+                job.func(now);
+#endif
+                runs++;
+            }
+
+            return runs;
+        }
+
+        /**
+         * @brief Returns the time in ms until the next job is due, 0 if one 
+         * is due already and UINT32_MAX if there are no jobs.
+         */
+        uint32_t getNext(uint32_t now) const
+        {
+            if (cnt == 0)
+            {
+                return UINT32_MAX;
+            }
+
+            uint32_t deadline = jobs[heap[0]].deadline;
+            return before(now, deadline) ? deadline - now : 0;
+        }
+
+        /**
+         * @brief Returns the number of jobs.
+         */
+        size_t getCount(void) const
+        {
+            return cnt;
+        }
+
+        /**
+         * @brief Returns the period of the given job.
+         */
+        uint32_t getPeriod(size_t id) const
+        {
+            return jobs[id].period;
+        }
+
+        /**
+         * @brief Returns the name of the given job, may be nullptr.
+         */
+        const char* getName(size_t id) const
+        {
+            return jobs[id].name;
+        }
+
+#if SCHEDULER_STATS
+
+        /**
+         * @brief Returns the statistics of the given job.
+         */
+        const schedStats_t& getStats(size_t id) const
+        {
+            return jobs[id].stats;
+        }
+
+        /**
+         * @brief Clears the statistics of all jobs.
+         */
+        void resetStats(void)
+        {
+            for (size_t i = 0; i < cnt; i++)
+            {
+                memset(&jobs[i].stats, 0, sizeof(jobs[i].stats));
+            }
+        }
+
+#endif
+
+    protected:
+
+        /**
+         * @brief A job and its next deadline.
+         */
+        struct Job
+        {
+            schedFunc_t func;
+            uint32_t period;
+            uint32_t deadline;
+            const char *name;
+#if SCHEDULER_STATS
+            schedStats_t stats;
+#endif
+        };
+
+#if SCHEDULER_STATS
+
+        /**
+         * @brief Adds a run to the statistics.
+         */
+        static void record(schedStats_t &stats, uint32_t us, uint32_t late)
+        {
+            size_t bucket = 0;
+
+            stats.runs++;
+            stats.lastUs = us;
+            stats.maxUs = us > stats.maxUs ? us : stats.maxUs;
+            stats.totalUs += us;
+            stats.lateMs = late;
+            stats.maxLateMs = late > stats.maxLateMs ? late : stats.maxLateMs;
+
+            for (uint32_t limit = 10; bucket < SCHEDULER_HISTSIZ - 1 && 
+                us >= limit; limit *= 10)
+            {
+                bucket++;
+            }
+            stats.hist[bucket]++;
+        }
+
+#endif
+
+        /**
+         * @brief Wrap safe a < b on time stamps.
+         */
+        static bool before(uint32_t a, uint32_t b)
+        {
+            return (int32_t) (a - b) < 0;
+        }
+
+        /**
+         * @brief Tells if the job at heap position i is due before the one at
+         * position j.
+         */
+        bool less(size_t i, size_t j) const
+        {
+            return before(jobs[heap[i]].deadline, jobs[heap[j]].deadline);
+        }
+
+        void swap(size_t i, size_t j)
+        {
+            id_t tmp = heap[i];
+            heap[i] = heap[j];
+            heap[j] = tmp;
+        }
+
+        /**
+         * @brief Moves the entry at position i up to its place.
+         */
+        void up(size_t i)
+        {
+            while (i > 0 && less(i, (i - 1) / 2))
+            {
+                swap(i, (i - 1) / 2);
+                i = (i - 1) / 2;
+            }
+        }
+
+        /**
+         * @brief Moves the entry at position i down to its place.
+         */
+        void down(size_t i)
+        {
+            for (;;)
+            {
+                size_t min = i;
+                size_t l = 2 * i + 1;
+                size_t r = l + 1;
+
+                if (l < cnt && less(l, min))
+                {
+                    min = l;
+                }
+                if (r < cnt && less(r, min))
+                {
+                    min = r;
+                }
+                if (min == i)
+                {
+                    return;
+                }
+                swap(i, min);
+                i = min;
+            }
+        }
+
+        /**
+         * @brief The jobs, indexed by id.
+         */
+        Job jobs[N];
+
+        /**
+         * @brief Job ids ordered as min-heap by deadline.
+         */
+        id_t heap[N];
+
+        /**
+         * @brief The number of jobs.
+         */
+        size_t cnt;
+};
+
+#endif /* _SCHEDULER_HPP_ */
@@ -0,0 +1,225 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _SESSIONPOOL_HPP_
+#define _SESSIONPOOL_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+#include "historysearch.hpp"
+#include "cmdjob.hpp"
+
+/**
+ * @brief A fixed pool of CLI sessions, each with its own client connection,
+ * Cli instance and thereby line buffer and history.
+ * 
+ * All sessions are allocated statically with the pool, open() only claims a
+ * free slot. Each session runs resumable commands by a CmdJob of its own. 
+ * serve() gives every open session one Cli::loop() call, the session served
+ * first rotates so no session is always last.
+ * 
+ * @tparam C    The client type, a Stream with connected() and stop(), like 
+ *              WiFiClient.
+ * @tparam N    The number of sessions.
+ */
+template<typename C, size_t N>
+class SessionPool
+{
+    static_assert(N > 0, "SessionPool needs at least one session");
+
+    public:
+
+        /**
+         * @brief A single session.
+         */
+        class Session
+        {
+            public:
+
+#if HAS_REVERSE_SEARCH
+                Session(void) : input(client, history), job(input), 
+                    used(false) 
+                {
+                    input.setJob(job);
+                }
+#else
+                Session(void) : job(client), used(false) {}
+#endif
+
+                /**
+                 * @brief Attaches the Cli to the given stream, usually a 
+                 * protocol layer on top of the client. Call it after sending
+                 * the banner.
+                 */
+                void begin(Stream &io)
+                {
+#if HAS_REVERSE_SEARCH
+                    history.clear();
+                    input.setStream(io);
+                    job.setStream(input);
+#else
+                    job.setStream(io);
+#endif
+                    cli.begin(&job);
+                }
+
+                /**
+                 * @brief Attaches the Cli directly to the client.
+                 */
+                void begin(void)
+                {
+                    begin(client);
+                }
+
+                /**
+                 * @brief Returns the stream the Cli is operated on, which is 
+                 * passed to the commands of this session.
+                 */
+                Stream& getStream(void)
+                {
+                    return job;
+                }
+
+                /**
+                 * @brief Tells if the slot is in use.
+                 */
+                bool isUsed(void) const
+                {
+                    return used;
+                }
+
+                C client;
+                Cli cli;
+
+            private:
+
+                friend class SessionPool;
+
+#if HAS_REVERSE_SEARCH
+                ConsoleHistory history;
+                SearchStream<ConsoleHistory> input;
+#endif
+                CmdJob job;
+                bool used;
+        };
+
+        SessionPool(void) : cnt(0), first(0) {}
+
+        /**
+         * @brief Claims a free session for the given client.
+         * @return The session or nullptr if all sessions are in use.
+         */
+        Session* open(const C &client)
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                if (!sessions[i].used)
+                {
+                    sessions[i].client = client;
+                    sessions[i].used = true;
+                    cnt++;
+                    return &sessions[i];
+                }
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * @brief Runs one Cli::loop() of every open session. Sessions whose
+         * client disconnected get their job aborted, are passed to closed() 
+         * and released.
+         * @param closed    Called with the client of a closed session.
+         */
+        template<typename F>
+        void serve(F closed)
+        {
+            for (size_t n = 0; n < N; n++)
+            {
+                size_t i = first + n < N ? first + n : first + n - N;
+                Session &session = sessions[i];
+
+                if (!session.used)
+                {
+                    continue;
+                }
+
+                if (session.client.connected())
+                {
+                    session.cli.loop();
+                }
+                else
+                {
+                    /* A job left running would keep its command busy and
+                     * pass its held output to the next client. */
+                    session.job.abort();
+                    closed(session.client);
+                    session.client.stop();
+                    session.used = false;
+                    cnt--;
+                }
+            }
+
+            first = first + 1 < N ? first + 1 : 0;
+        }
+
+        /**
+         * @brief Returns the number of open sessions.
+         */
+        size_t getCount(void) const
+        {
+            return cnt;
+        }
+
+        /**
+         * @brief Returns the number of sessions in the pool.
+         */
+        static constexpr size_t getSize(void)
+        {
+            return N;
+        }
+
+        /**
+         * @brief Returns the slot number of the given session.
+         */
+        size_t indexOf(const Session *pSession) const
+        {
+            return pSession - sessions;
+        }
+
+        /**
+         * @brief Returns the session in slot i, check isUsed() before use.
+         */
+        Session& at(size_t i)
+        {
+            return sessions[i];
+        }
+
+    private:
+
+        Session sessions[N];
+        size_t cnt;
+        size_t first;
+};
+
+#endif /* _SESSIONPOOL_HPP_ */
@@ -23,13 +23,19 @@
 
 #include "telnetserver.hpp"
 
+#include <cli/cli.hpp>
+
 /**
  * Currently the TelnetServer is only supported on ESP32 platforms.
  */
 #if HAS_WIFI_SUPPORT
 
 #include <WiFi.h>
-#include <cli/cli.hpp>
+#include "cmdindex.hpp"
+#include "cmdstats.hpp"
+#include "sessionpool.hpp"
+#include "telnetstream.hpp"
+#include "txbuffer.hpp"
 
 /**
  * Defining those instances here avoids the need of having them as member of 
@@ -39,9 +45,11 @@
 namespace tsrvGlobal
 {
     WiFiServer telnetServer(23);
-    WiFiClient telnetClient;
-    WiFiClient wifiClient;
-    Cli telnetCli;
+    SessionPool<WiFiClient, TELNET_SESSIONS> sessions;
+    TelnetStream telnetIo[TELNET_SESSIONS];
+#if TELNET_TXBUFFER_SIZ > 0
+    BufferedStream<TELNET_TXBUFFER_SIZ> telnetOut[TELNET_SESSIONS];
+#endif
 }
 
 void TelnetServer::wifiSetup(char* ssid, char* passwd)
@@ -50,44 +58,68 @@ void TelnetServer::wifiSetup(char* ssid, char* passwd)
     strncpy(this->passwd, passwd, sizeof(this->passwd));
 }
 
-int8_t TelnetServer::begin(void)
+int8_t TelnetServer::begin(Stream &ioStream)
 {
-    const uint8_t timeout_sec = 5;
-    uint32_t start = 0;
-    uint32_t ms = 0;
-
     if(strlen(ssid) == 0 || strlen(passwd) == 0)
     {
-        Serial.println("WiFi: No SSID or password set.");
+        ioStream.println("WiFi: No SSID or password set.");
         return -1;
     }
 
-    Serial.printf("WiFi: Connecting to %s, ", ssid);
+    if (wifiState == wifi_connecting)
+    {
+        ioStream.println("WiFi: Already connecting.");
+        return -1;
+    }
+
+    /* A new association would stop serving the open sessions. */
+    if (wifiState == wifi_up)
+    {
+        ioStream.println("WiFi: Already connected.");
+        return -1;
+    }
+
+    ioStream.printf("WiFi: Connecting to %s ...\n", ssid);
     WiFi.mode(WIFI_STA);
 
-    start = millis(); 
+    wifiStart = millis(); 
     WiFi.begin(ssid, passwd);
+    wifiState = wifi_connecting;
+
+    return 0;   
+}
+
+void TelnetServer::wifiLoop(void)
+{
+    uint32_t ms = millis() - wifiStart;
 
-    while (WiFi.status() != WL_CONNECTED)
+    if (WiFi.status() == WL_CONNECTED)
     {
-        ms = millis() - start;
-        if(ms > (timeout_sec * 1000))
-        {
-            Serial.printf("Timeout(%u sec)\n", timeout_sec);
-            return -1;
-        }
-    }
+        pLog->printf("WiFi: %s (%lums)\n", 
+            WiFi.localIP().toString().c_str(), (unsigned long) ms);
+        randomSeed(micros()); 
 
-    ms = millis() - start;
-    Serial.printf("%s (%ums)\n", WiFi.localIP().toString().c_str(), ms);
-    randomSeed(micros()); 
-    
-    tsrvGlobal::telnetServer.begin();
-    tsrvGlobal::telnetServer.setNoDelay(true);
-    tsrvGlobal::telnetCli.setEcho(false);
-    Serial.println("Telnet-Server started");
+        tsrvGlobal::telnetServer.begin();
+        tsrvGlobal::telnetServer.setNoDelay(true);
+        pLog->println("Telnet-Server started");
+        wifiState = wifi_up;
+    }
+    else if (ms > TELNET_WIFI_TIMEOUT)
+    {
+        pLog->printf("WiFi: Timeout(%lu ms)\n", (unsigned long) ms);
+        WiFi.disconnect();
+        wifiState = wifi_failed;
+    }
+    else
+    {
+        return;
+    }
 
-    return 0;   
+    wifiMs = ms;
+    if (pReady != nullptr)
+    {
+        pReady(wifiState == wifi_up, ms);
+    }
 }
 
 bool TelnetServer::wifiConnected(void)
@@ -97,65 +129,146 @@ bool TelnetServer::wifiConnected(void)
 
 bool TelnetServer::clientConnected(void)
 {
-    return tsrvGlobal::telnetClient.connected();
+    return tsrvGlobal::sessions.getCount() > 0;
 }
 
 void TelnetServer::info(Stream &ioStream)
 {
     ioStream.println("Telnet-Server:");
     ioStream.printf("  MAC:           %s\n", WiFi.macAddress().c_str());
-    ioStream.printf("  WiFi Status:   %s\n", WiFi.isConnected() ? "Connected" : "Connecting ...");
+    switch (wifiState)
+    {
+        case wifi_connecting:
+            ioStream.printf("  WiFi Status:   Connecting to %s (%lu ms)\n", 
+                ssid, (unsigned long) (millis() - wifiStart));
+            break;
+
+        case wifi_up:
+            ioStream.printf("  WiFi Status:   %s (took %lu ms)\n", 
+                WiFi.isConnected() ? "Connected" : "Connection lost",
+                (unsigned long) wifiMs);
+            break;
+
+        case wifi_failed:
+            ioStream.printf("  WiFi Status:   Timeout after %lu ms\n", 
+                (unsigned long) wifiMs);
+            break;
+
+        default:
+            ioStream.printf("  WiFi Status:   Off\n");
+            break;
+    }
     ioStream.printf("  WiFi IP:       %s\n", WiFi.localIP().toString().c_str());
     ioStream.printf("  WiFi RSSI:     %d\n", WiFi.RSSI());
-    ioStream.printf("  Telnet-Client: %s\n", tsrvGlobal::telnetClient.connected() ? "Connected" : "Disconnected");
+    ioStream.printf("  Sessions:      %u of %u\n", 
+        (unsigned int) tsrvGlobal::sessions.getCount(),
+        (unsigned int) tsrvGlobal::sessions.getSize());
+
+    for (size_t i = 0; i < tsrvGlobal::sessions.getSize(); i++)
+    {
+        if (tsrvGlobal::sessions.at(i).isUsed())
+        {
+            ioStream.printf("  Telnet-Client: %s\n", tsrvGlobal::sessions.at(i)
+                .client.remoteIP().toString().c_str());
+        }
+    }
+}
+
+uint16_t TelnetServer::getWidth(Stream &io)
+{
+#if CMDSTATS
+    Stream *pIo = &CmdStats::stream(io);
+#else
+    Stream *pIo = &io;
+#endif
+
+    for (size_t i = 0; i < tsrvGlobal::sessions.getSize(); i++)
+    {
+        if (tsrvGlobal::sessions.at(i).isUsed() && 
+            &tsrvGlobal::sessions.at(i).getStream() == pIo)
+        {
+            return tsrvGlobal::telnetIo[i].getWidth();
+        }
+    }
+
+    return CLI_TERMINAL_WIDTH;
 }
 
 void TelnetServer::loop(void)
 {
+    if (wifiState == wifi_connecting)
+    {
+        wifiLoop();
+    }
+
+    if (wifiState != wifi_up)
+    {
+        return;
+    }
+
     if (tsrvGlobal::telnetServer.hasClient()) 
     {
-        if (state == idle)
+        WiFiClient newClient = tsrvGlobal::telnetServer.available();
+        SessionPool<WiFiClient, TELNET_SESSIONS>::Session *pSession = 
+            tsrvGlobal::sessions.open(newClient);
+
+        if (pSession == nullptr)
         {
-            tsrvGlobal::telnetClient = 
-                tsrvGlobal::telnetServer.available();
-            Serial.printf("Telnet-Client %s connected.\n", 
-                tsrvGlobal::telnetClient.remoteIP().toString().c_str());
-            state = connecting;
+            pLog->printf("Telnet-Client %s rejected, all %u sessions in use.\n", 
+                newClient.remoteIP().toString().c_str(), 
+                (unsigned int) tsrvGlobal::sessions.getSize());
+            newClient.printf("All %u sessions in use, try again later.\n",
+                (unsigned int) tsrvGlobal::sessions.getSize());
+            newClient.stop();
         }
         else
         {
-            WiFiClient newClient = tsrvGlobal::telnetServer.available();
-            Serial.printf("Telnet-Client %s connected, rejecting %s.\n", 
-                tsrvGlobal::telnetClient.remoteIP().toString().c_str(),
-                newClient.remoteIP().toString().c_str());
-            newClient.stop();
+            size_t i = tsrvGlobal::sessions.indexOf(pSession);
+            TelnetStream &io = tsrvGlobal::telnetIo[i];
+
+            pLog->printf("Telnet-Client %s connected.\n", 
+                pSession->client.remoteIP().toString().c_str());
+#if TELNET_TXBUFFER_SIZ > 0
+            tsrvGlobal::telnetOut[i].setStream(pSession->client);
+            tsrvGlobal::telnetOut[i].setMaxDelay(TELNET_TXBUFFER_DELAY);
+            io.begin(tsrvGlobal::telnetOut[i]);
+#else
+            io.begin(pSession->client);
+#endif
+            io.print("\033c");
+            CmdIndex::exec(io, "ver", 0, 0);
+            io.printf("Use the 'help' command to get a list of available commands.\n\n");
+            pSession->cli.setEcho(true);
+            pSession->begin(io);
         }
     }
 
-    if(state == connecting)
+    tsrvGlobal::sessions.serve([this](WiFiClient &client)
     {
-        tsrvGlobal::telnetClient.print("\033c");
-        CliCommand::exec(tsrvGlobal::telnetClient, "ver", 0, 0);
-        tsrvGlobal::telnetClient.printf("Info: This telent session operates in Line Mode.\n");
-        tsrvGlobal::telnetClient.printf("      Input is processed upon pressing Enter.\n");
-        tsrvGlobal::telnetClient.printf("\n");
-        tsrvGlobal::telnetClient.printf("Use the 'help' command to get a list of available commands.\n\n");
-        tsrvGlobal::telnetCli.begin(&tsrvGlobal::telnetClient);
-        state = connected;
-    }
+        pLog->printf("Telnet-Client %s disconnected.\n", 
+            client.remoteIP().toString().c_str());
+    });
 
-    if(state == connected && tsrvGlobal::telnetClient.connected())  
+    /* A client refusing the server echo would see every key twice. */
+    for (size_t i = 0; i < tsrvGlobal::sessions.getSize(); i++)
     {
-        tsrvGlobal::telnetCli.loop();
+        if (tsrvGlobal::sessions.at(i).isUsed() && 
+            tsrvGlobal::telnetIo[i].echoChanged())
+        {
+            tsrvGlobal::sessions.at(i).cli.setEcho(
+                tsrvGlobal::telnetIo[i].getEcho());
+        }
     }
 
-    if (state == connected && !tsrvGlobal::telnetClient.connected())
+#if TELNET_TXBUFFER_SIZ > 0
+    for (size_t i = 0; i < tsrvGlobal::sessions.getSize(); i++)
     {
-        Serial.printf("Telnet-Client %s disconnected.\n", 
-            tsrvGlobal::telnetClient.remoteIP().toString().c_str());
-            tsrvGlobal::telnetClient.stop();
-        state = idle;
+        if (tsrvGlobal::sessions.at(i).isUsed())
+        {
+            tsrvGlobal::telnetOut[i].poll();
+        }
     }
+#endif
 }
 
 #else
@@ -165,9 +278,9 @@ void TelnetServer::wifiSetup(char* ssid, char* passwd)
     // nothing to do
 }   
 
-int8_t TelnetServer::begin(void)
+int8_t TelnetServer::begin(Stream &ioStream)
 {
-    info(Serial);
+    info(ioStream);
     return -1;
 }
 
@@ -186,6 +299,11 @@ void TelnetServer::info(Stream &ioStream)
     ioStream.println("Telnet-Server not supported on this platform.");
 }
 
+uint16_t TelnetServer::getWidth(Stream &io)
+{
+    return CLI_TERMINAL_WIDTH;
+}
+
 void TelnetServer::loop(void)
 {
     // nothing to do
@@ -36,7 +36,47 @@
 #endif
 
 /**
- * @brief This class provides a simple telnet server.
+ * @brief The time given to the WiFi association started by begin().
+ */
+#ifndef TELNET_WIFI_TIMEOUT
+#define TELNET_WIFI_TIMEOUT 5000
+#endif
+
+/**
+ * @brief The number of concurrent telnet sessions, each one needs its own 
+ * Cli instance and history.
+ */
+#ifndef TELNET_SESSIONS
+#define TELNET_SESSIONS     2
+#endif
+
+/**
+ * @brief The size of the transmit buffer of each telnet session, one TCP 
+ * segment of lwIP by default. 0 sends every write as it is.
+ */
+#ifndef TELNET_TXBUFFER_SIZ
+#define TELNET_TXBUFFER_SIZ 1436
+#endif
+
+/**
+ * @brief The longest time output of a telnet session may wait in the 
+ * transmit buffer.
+ */
+#ifndef TELNET_TXBUFFER_DELAY
+#define TELNET_TXBUFFER_DELAY 20
+#endif
+
+/**
+ * @brief Called once the WiFi bring-up started by TelnetServer::begin() has 
+ * finished.
+ * @param connected  true if the server is up, false on timeout.
+ * @param ms         The time the bring-up took in milliseconds.
+ */
+typedef void (*telnetReadyFunc_t)(bool connected, uint32_t ms);
+
+/**
+ * @brief This class provides a simple telnet server with up to TELNET_SESSIONS
+ * concurrent sessions.
  * On platforms without WiFi support this class will do nothing.
  */
 class TelnetServer
@@ -50,7 +90,11 @@ class TelnetServer
         {
             memset(ssid, 0, sizeof(ssid));
             memset(passwd, 0, sizeof(passwd));
-            state = idle;
+            wifiState = wifi_off;
+            wifiStart = 0;
+            wifiMs = 0;
+            pReady = nullptr;
+            pLog = &Serial;
         }
         
         /**
@@ -61,10 +105,32 @@ class TelnetServer
         void wifiSetup(char* ssid, char* passwd);
         
         /**
-         * @brief Starts the telnet server.
-         * @return 0 on success, -1 on error.
+         * @brief Starts the WiFi association, the telnet server is started by
+         * loop() once it is done. Does not block, the outcome is reported 
+         * through the callback set by onReady(). Refused while connecting 
+         * or once the server is up, open sessions are not dropped.
+         * @param ioStream  The console of the caller, gets the replies.
+         * @return 0 if the bring-up has been started, -1 on error.
+         */
+        int8_t begin(Stream &ioStream = Serial);
+
+        /**
+         * @brief Sets the function to call when the bring-up has finished.
          */
-        int8_t begin(void);
+        void onReady(telnetReadyFunc_t func)
+        {
+            pReady = func;
+        }
+
+        /**
+         * @brief Sets the stream loop() reports the WiFi state and the 
+         * sessions on, Serial by default. Must be the console of the core 
+         * which calls loop().
+         */
+        void setLog(Print &log)
+        {
+            pLog = &log;
+        }
 
         /**
          * @brief Tells if the WiFi connection is established.
@@ -72,7 +138,7 @@ class TelnetServer
         bool wifiConnected(void);
 
         /**
-         * @brief Tells if a client is connected.
+         * @brief Tells if at least one client is connected.
          */
         bool clientConnected(void);
         
@@ -81,6 +147,12 @@ class TelnetServer
          */
         void info(Stream &ioStream = Serial);
     
+        /**
+         * @brief Returns the terminal width of the telnet session operated on
+         * the given stream, or CLI_TERMINAL_WIDTH for any other stream.
+         */
+        uint16_t getWidth(Stream &io);
+
         /**
          * @brief This function must be called in the loop() function.
          */
@@ -99,9 +171,34 @@ class TelnetServer
         char passwd[32];
         
         /**
-         * @brief Internal state of the telnet server.
+         * @brief Advances the WiFi bring-up.
+         */
+        void wifiLoop(void);
+
+        /**
+         * @brief State of the WiFi bring-up.
+         */
+        enum {wifi_off = 0, wifi_connecting, wifi_up, wifi_failed} wifiState;
+
+        /**
+         * @brief The time the bring-up has been started.
+         */
+        uint32_t wifiStart;
+
+        /**
+         * @brief The time the last bring-up took.
+         */
+        uint32_t wifiMs;
+
+        /**
+         * @brief Called when the bring-up has finished.
+         */
+        telnetReadyFunc_t pReady;
+
+        /**
+         * @brief Where loop() reports to.
          */
-        enum {idle = 0, connecting, connected} state;
+        Print *pLog;
 };
 
 #endif /* _NETWORKING_HPP_ */
\ No newline at end of file
@@ -0,0 +1,311 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#include "telnetstream.hpp"
+
+#include <string.h>
+
+/**
+ * Telnet commands and options used here, see RFC 854, 857, 858 and 1073.
+ */
+#define TELNET_SE               240
+#define TELNET_SB               250
+#define TELNET_WILL             251
+#define TELNET_WONT             252
+#define TELNET_DO               253
+#define TELNET_DONT             254
+#define TELNET_IAC              255
+
+#define TELNET_OPT_ECHO         1
+#define TELNET_OPT_SGA          3
+#define TELNET_OPT_NAWS         31
+
+TelnetStream::TelnetStream(void) : io(nullptr), state(data), cmd(0), 
+    afterCr(false), sbLen(0), width(0), height(0), echo(true), 
+    echoChange(false)
+{
+
+}
+
+void TelnetStream::begin(Stream &io)
+{
+    this->io = &io;
+    state = data;
+    afterCr = false;
+    sbLen = 0;
+    width = 0;
+    height = 0;
+    echo = true;
+    echoChange = false;
+
+    send(TELNET_WILL, TELNET_OPT_ECHO);
+    send(TELNET_WILL, TELNET_OPT_SGA);
+    send(TELNET_DO, TELNET_OPT_SGA);
+    send(TELNET_DO, TELNET_OPT_NAWS);
+}
+
+uint16_t TelnetStream::getWidth(void) const
+{
+    return width != 0 ? width : CLI_TERMINAL_WIDTH;
+}
+
+uint16_t TelnetStream::getHeight(void) const
+{
+    return height;
+}
+
+bool TelnetStream::getEcho(void) const
+{
+    return echo;
+}
+
+bool TelnetStream::echoChanged(void)
+{
+    bool changed = echoChange;
+
+    echoChange = false;
+    return changed;
+}
+
+int TelnetStream::available(void)
+{
+    if (io == nullptr)
+    {
+        return 0;
+    }
+
+    skip();
+    return io->available();
+}
+
+int TelnetStream::read(void)
+{
+    int c = 0;
+
+    if (io == nullptr)
+    {
+        return -1;
+    }
+
+    skip();
+    c = io->read();
+    if (c < 0)
+    {
+        return -1;
+    }
+    parse((uint8_t) c);
+
+    return c;
+}
+
+int TelnetStream::peek(void)
+{
+    if (io == nullptr)
+    {
+        return -1;
+    }
+
+    skip();
+    return io->peek();
+}
+
+size_t TelnetStream::write(uint8_t c)
+{
+    if (io == nullptr)
+    {
+        return 0;
+    }
+
+    if (c == TELNET_IAC)
+    {
+        io->write(c);
+    }
+
+    return io->write(c);
+}
+
+size_t TelnetStream::write(const uint8_t *buffer, size_t size)
+{
+    if (io == nullptr)
+    {
+        return 0;
+    }
+
+    /* Plain text goes out as it is, only 0xFF needs to be doubled. */
+    if (memchr(buffer, TELNET_IAC, size) == nullptr)
+    {
+        return io->write(buffer, size);
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        write(buffer[i]);
+    }
+
+    return size;
+}
+
+void TelnetStream::flush(void)
+{
+    if (io != nullptr)
+    {
+        io->flush();
+    }
+}
+
+bool TelnetStream::isData(int c) const
+{
+    if (state == iac)
+    {
+        return c == TELNET_IAC;
+    }
+
+    return state == data && c != TELNET_IAC && 
+        !(afterCr && (c == 0 || c == '\n'));
+}
+
+void TelnetStream::skip(void)
+{
+    while (io->available() > 0 && !isData(io->peek()))
+    {
+        parse((uint8_t) io->read());
+    }
+}
+
+bool TelnetStream::parse(uint8_t c)
+{
+    switch (state)
+    {
+        case data:
+            if (afterCr)
+            {
+                afterCr = false;
+                if (c == 0 || c == '\n')
+                {
+                    return false;
+                }
+            }
+            if (c == TELNET_IAC)
+            {
+                state = iac;
+                return false;
+            }
+            afterCr = (c == '\r');
+            return true;
+
+        case iac:
+            state = data;
+            if (c == TELNET_IAC)
+            {
+                return true;
+            }
+            if (c >= TELNET_WILL)
+            {
+                cmd = c;
+                state = option;
+            }
+            else if (c == TELNET_SB)
+            {
+                sbLen = 0;
+                state = sub;
+            }
+            return false;
+
+        case option:
+            negotiate(cmd, c);
+            state = data;
+            return false;
+
+        case sub:
+            if (c == TELNET_IAC)
+            {
+                state = subIac;
+            }
+            else if (sbLen < sizeof(sb))
+            {
+                sb[sbLen++] = c;
+            }
+            return false;
+
+        case subIac:
+            if (c == TELNET_IAC)
+            {
+                if (sbLen < sizeof(sb))
+                {
+                    sb[sbLen++] = c;
+                }
+                state = sub;
+                return false;
+            }
+            if (c == TELNET_SE)
+            {
+                subnegotiation();
+            }
+            state = data;
+            return false;
+    }
+
+    return false;
+}
+
+void TelnetStream::negotiate(uint8_t cmd, uint8_t opt)
+{
+    /* The client may refuse the server echo and ask for it again, only a
+     * change is acknowledged so that both sides do not loop (RFC 854). */
+    if (opt == TELNET_OPT_ECHO && (cmd == TELNET_DO || cmd == TELNET_DONT))
+    {
+        if ((cmd == TELNET_DO) != echo)
+        {
+            echo = cmd == TELNET_DO;
+            echoChange = true;
+            send(echo ? TELNET_WILL : TELNET_WONT, opt);
+        }
+    }
+    /* Options asked for in begin() are confirmed by the client, anything
+     * else is refused. WONT and DONT need no answer. */
+    else if (cmd == TELNET_DO && opt != TELNET_OPT_SGA)
+    {
+        send(TELNET_WONT, opt);
+    }
+    else if (cmd == TELNET_WILL && opt != TELNET_OPT_SGA && 
+        opt != TELNET_OPT_NAWS)
+    {
+        send(TELNET_DONT, opt);
+    }
+}
+
+void TelnetStream::subnegotiation(void)
+{
+    if (sbLen == 5 && sb[0] == TELNET_OPT_NAWS)
+    {
+        width = (uint16_t) ((sb[1] << 8) | sb[2]);
+        height = (uint16_t) ((sb[3] << 8) | sb[4]);
+    }
+}
+
+void TelnetStream::send(uint8_t cmd, uint8_t opt)
+{
+    uint8_t buf[3] = {TELNET_IAC, cmd, opt};
+
+    io->write(buf, sizeof(buf));
+}
@@ -0,0 +1,160 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _TELNETSTREAM_HPP_
+#define _TELNETSTREAM_HPP_
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+/**
+ * @brief A Stream which speaks the telnet protocol on top of a client 
+ * connection and switches the client to character mode.
+ * 
+ * begin() asks the client to let the server echo (WILL ECHO), to suppress 
+ * go-ahead in both directions and to report its window size (DO NAWS). The
+ * client then sends every key as it is pressed, so the Cli can do line 
+ * editing, tab completion and history like on the serial console.
+ * 
+ * Incoming data is parsed as the reader consumes it, a byte at a time from 
+ * the client, so nothing is copied or buffered here. Commands and option 
+ * negotiation are answered and dropped, IAC IAC becomes 0xFF and the NUL or 
+ * LF a client sends after CR is dropped, so Enter is seen once.
+ */
+class TelnetStream : public Stream
+{
+    public:
+
+        TelnetStream(void);
+
+        /**
+         * @brief Attaches the stream to a new connection and starts the 
+         * option negotiation.
+         */
+        void begin(Stream &io);
+
+        /**
+         * @brief Returns the terminal width reported by the client, or 
+         * CLI_TERMINAL_WIDTH if it did not report one.
+         */
+        uint16_t getWidth(void) const;
+
+        /**
+         * @brief Returns the terminal height reported by the client, or 0.
+         */
+        uint16_t getHeight(void) const;
+
+        /**
+         * @brief Tells if the server echoes, i.e. the client has not refused
+         * it by DONT ECHO.
+         */
+        bool getEcho(void) const;
+
+        /**
+         * @brief Returns true once after the client turned the server echo 
+         * on or off, the Cli echo has to follow getEcho() then.
+         */
+        bool echoChanged(void);
+
+        int available(void) override;
+
+        int read(void) override;
+
+        int peek(void) override;
+
+        size_t write(uint8_t c) override;
+
+        size_t write(const uint8_t *buffer, size_t size) override;
+
+        using Print::write;
+
+        void flush(void) override;
+
+    private:
+
+        /**
+         * @brief Tells if c is data in the current parser state.
+         */
+        bool isData(int c) const;
+
+        /**
+         * @brief Consumes everything in front of the next data byte.
+         */
+        void skip(void);
+
+        /**
+         * @brief Advances the parser by one received byte.
+         * @return true if the byte is data for the reader.
+         */
+        bool parse(uint8_t c);
+
+        /**
+         * @brief Answers a WILL, WONT, DO or DONT of the client.
+         */
+        void negotiate(uint8_t cmd, uint8_t opt);
+
+        /**
+         * @brief Evaluates a complete subnegotiation.
+         */
+        void subnegotiation(void);
+
+        /**
+         * @brief Sends a three byte command.
+         */
+        void send(uint8_t cmd, uint8_t opt);
+
+        Stream *io;
+
+        /**
+         * @brief The parser state.
+         */
+        enum : uint8_t {data = 0, iac, option, sub, subIac} state;
+
+        /**
+         * @brief The pending WILL, WONT, DO or DONT.
+         */
+        uint8_t cmd;
+
+        /**
+         * @brief Set after a CR, the next byte is dropped if it is NUL or LF.
+         */
+        bool afterCr;
+
+        /**
+         * @brief The subnegotiation received so far, long enough for NAWS.
+         */
+        uint8_t sb[5];
+        uint8_t sbLen;
+
+        uint16_t width;
+        uint16_t height;
+
+        /**
+         * @brief The state of the ECHO option and if it changed since the 
+         * last echoChanged().
+         */
+        bool echo;
+        bool echoChange;
+};
+
+#endif /* _TELNETSTREAM_HPP_ */
@@ -0,0 +1,259 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * This project is hosted on GitHub:
+ *   https://github.com/fjulian79/clidemo
+ * Please feel free to file issues, open pull requests, or contribute there.
+ */
+
+#ifndef _TXBUFFER_HPP_
+#define _TXBUFFER_HPP_
+
+#include <Arduino.h>
+#include <string.h>
+
+/**
+ * @brief The default size of the transmit buffer, 0 disables buffering.
+ */
+#ifndef TXBUFFER_SIZ
+#define TXBUFFER_SIZ            128
+#endif
+
+/**
+ * @brief A Stream which collects output in a fixed transmit buffer and 
+ * passes it on to the underlying stream in large chunks.
+ * 
+ * Commands print their output with many small printf() calls. On a UART each
+ * call pays the driver overhead, over TCP each one can become a segment of 
+ * its own. The buffer is written to the underlying stream when:
+ *   - it is full,
+ *   - the reader asks for input, which the Cli only does once a command 
+ *     has returned and the prompt is drawn, or while echoing typed keys,
+ *   - flush() is called, e.g. before a command blocks or resets the CPU,
+ *   - the oldest pending byte is older than the delay set by setMaxDelay(),
+ *     checked on every write and by poll().
+ * 
+ * A stream taking only part of a write, like a WiFiClient or a UART with a 
+ * full TX queue, leaves the rest in the buffer. poll() and flush() try again,
+ * writes into a full buffer return 0.
+ * 
+ * @tparam SIZ  The size of the transmit buffer.
+ */
+template<size_t SIZ = TXBUFFER_SIZ>
+class BufferedStream : public Stream
+{
+    static_assert(SIZ > 0, "BufferedStream needs a buffer");
+
+    public:
+
+        BufferedStream(Stream &io) : io(&io), len(0), maxDelay(0), since(0),
+            stalled(false) {}
+
+        /**
+         * @brief Constructor for arrays of buffers, setStream() must be called
+         * before use.
+         */
+        BufferedStream(void) : io(nullptr), len(0), maxDelay(0), since(0),
+            stalled(false) {}
+
+        /**
+         * @brief Sets the underlying stream, pending output is dropped.
+         */
+        void setStream(Stream &io)
+        {
+            this->io = &io;
+            len = 0;
+            stalled = false;
+        }
+
+        int available(void) override
+        {
+            push();
+            return io->available();
+        }
+
+        int read(void) override
+        {
+            push();
+            return io->read();
+        }
+
+        int peek(void) override
+        {
+            push();
+            return io->peek();
+        }
+
+        /**
+         * @brief Sets the longest time output may wait in the buffer, 0 
+         * disables the limit.
+         */
+        void setMaxDelay(uint32_t ms)
+        {
+            maxDelay = ms;
+        }
+
+        /**
+         * @brief Sends the pending output if it waited longer than the delay
+         * set by setMaxDelay(), or if the last write did not take all of it.
+         * To be called periodically.
+         */
+        void poll(void)
+        {
+            if (len > 0 && (stalled || 
+                (maxDelay != 0 && millis() - since >= maxDelay)))
+            {
+                push();
+            }
+        }
+
+        size_t write(uint8_t c) override
+        {
+            if (len == SIZ && !push())
+            {
+                return 0;
+            }
+
+            if (len == 0)
+            {
+                since = maxDelay != 0 ? millis() : 0;
+            }
+
+            buffer[len++] = c;
+            if (len == SIZ)
+            {
+                push();
+            }
+            else
+            {
+                poll();
+            }
+
+            return 1;
+        }
+
+        size_t write(const uint8_t *data, size_t size) override
+        {
+            size_t n = size;
+
+            /* Large blocks would only be copied in pieces, send them right 
+             * away after what is pending. */
+            if (size >= SIZ)
+            {
+                push();
+                if (len == 0)
+                {
+                    return io->write(data, size);
+                }
+            }
+
+            if (len == 0)
+            {
+                since = maxDelay != 0 ? millis() : 0;
+            }
+
+            while (n > 0)
+            {
+                size_t chunk = SIZ - len < n ? SIZ - len : n;
+
+                memcpy(&buffer[len], data, chunk);
+                len += chunk;
+                data += chunk;
+                n -= chunk;
+                if (len == SIZ && !push())
+                {
+                    break;
+                }
+            }
+            poll();
+
+            return size - n;
+        }
+
+        using Print::write;
+
+        /**
+         * @brief Sends the pending output and waits until the underlying 
+         * stream has sent it.
+         */
+        void flush(void) override
+        {
+            bool sent = false;
+
+            do
+            {
+                sent = push();
+                io->flush();
+            }
+            while (len > 0 && sent);
+        }
+
+        /**
+         * @brief Returns the number of bytes waiting in the buffer.
+         */
+        size_t pending(void) const
+        {
+            return len;
+        }
+
+    private:
+
+        /**
+         * @brief Passes the pending output on with a single write, what the
+         * underlying stream does not take is kept for the next try.
+         * @return false if nothing could be sent.
+         */
+        bool push(void)
+        {
+            size_t n = 0;
+
+            if (len == 0 || io == nullptr)
+            {
+                return len == 0;
+            }
+
+            n = io->write(buffer, len);
+            n = n < len ? n : len;
+            memmove(buffer, &buffer[n], len - n);
+            len -= n;
+            stalled = len > 0;
+
+            return n > 0;
+        }
+
+        Stream *io;
+        uint8_t buffer[SIZ];
+        size_t len;
+
+        /**
+         * @brief The longest time output may wait, 0 for no limit.
+         */
+        uint32_t maxDelay;
+
+        /**
+         * @brief The time the oldest pending byte has been written.
+         */
+        uint32_t since;
+
+        /**
+         * @brief Set if the last write did not take all pending output.
+         */
+        bool stalled;
+};
+
+#endif /* _TXBUFFER_HPP_ */
@@ -0,0 +1,109 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "cmdbatch.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief A provisioning like script with cheap commands, so the time is 
+ * dominated by the way the lines get to the commands.
+ */
+static const char scriptBatch[] =
+    "led 0" BENCH_EOL
+    "args wifi ssid" BENCH_EOL
+    "args wifi pass secret" BENCH_EOL
+    "led_blink" BENCH_EOL
+    "err 0" BENCH_EOL
+    "dummy_1" BENCH_EOL
+    "args mqtt host 192.168.0.1" BENCH_EOL
+    "led b" BENCH_EOL;
+
+#define BATCH_LINES             8
+#define BATCH_ROUNDS            200
+
+/**
+ * @brief Prints the rates of a run, the UART time is what the output would 
+ * take at 115200 baud.
+ */
+static void report(Stream& ioStream, const char *name, uint32_t us, 
+    const ScriptStream &stream) {
+
+    uint32_t lines = BATCH_LINES * BATCH_ROUNDS;
+    uint32_t bytes = stream.getOutBytes();
+
+    FMT_PRINT(ioStream, "\n[%s]\n", name);
+    FMT_PRINT(ioStream, "  Lines:          %lu\n", (unsigned long) lines);
+    FMT_PRINT(ioStream, "  Time:           %lu us\n", (unsigned long) us);
+    FMT_PRINT(ioStream, "  Lines/sec:      %lu\n", 
+        (unsigned long) benchPerSec(lines, us));
+    FMT_PRINT(ioStream, "  Output bytes:   %lu in %lu writes\n", 
+        (unsigned long) bytes, (unsigned long) stream.getOutCalls());
+    FMT_PRINT(ioStream, "  UART time:      %lu ms, %lu lines/sec\n", 
+        (unsigned long) (bytes * 10ULL * 1000 / 115200),
+        (unsigned long) benchPerSec(lines, 
+            (uint32_t) (bytes * 10ULL * 1000000 / 115200)));
+}
+
+/**
+ * @brief Compares a script pasted into the Cli, with echo, prompt and history,
+ * to the same script run by CmdBatch.
+ */
+BENCH_DECL(batch) {
+    static Cli benchCli;
+    ScriptStream stream;
+    uint32_t start = 0;
+    uint32_t us = 0;
+
+    stream.setScript(scriptBatch);
+    benchCli.begin(&stream);
+    start = micros();
+    for (uint32_t i = 0; i < BATCH_ROUNDS; i++) {
+        stream.rewind();
+        while (stream.available() > 0) {
+            benchCli.loop();
+        }
+    }
+    us = micros() - start;
+    report(ioStream, "paste", us, stream);
+
+    stream.setScript(scriptBatch);
+    start = micros();
+    for (uint32_t i = 0; i < BATCH_ROUNDS; i++) {
+        CmdBatch batch(stream);
+        const char *pScript = scriptBatch;
+        size_t len = sizeof(scriptBatch) - 1;
+
+        while (len > 0) {
+            size_t n = batch.feed(pScript, len);
+
+            pScript += n;
+            len -= n;
+        }
+        batch.end();
+    }
+    us = micros() - start;
+    report(ioStream, "source", us, stream);
+}
@@ -0,0 +1,104 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Short commands with cheap handlers, so the time is dominated by 
+ * parsing, history and dispatch.
+ */
+static const char scriptDispatch[] =
+    "dummy" BENCH_EOL
+    "dummy_1" BENCH_EOL
+    "dummy_long_4" BENCH_EOL
+    "args a b c" BENCH_EOL
+    "err 0" BENCH_EOL
+    "led_blink" BENCH_EOL
+    "led b" BENCH_EOL
+    "args" BENCH_EOL;
+
+/**
+ * @brief Lines with typos fixed by backspace and lines recalled from the
+ * history by arrow up, to measure the per keystroke cost of line editing.
+ */
+static const char scriptEditing[] =
+    "dummx\x7fy_2" BENCH_EOL
+    "\033[A" BENCH_EOL
+    "args one two three" BENCH_EOL
+    "\033[A\033[A\033[B" BENCH_EOL
+    "led_blinkk\x7f" BENCH_EOL;
+
+/**
+ * @brief Runs @p script @p rounds times through a dedicated Cli instance and
+ * prints the resulting rates.
+ */
+static void runScript(Stream& ioStream, const char *name, const char *script, 
+    uint32_t lines, uint32_t rounds) {
+
+    static Cli benchCli;
+    ScriptStream stream;
+    uint32_t start = 0;
+    uint32_t us = 0;
+
+    stream.setScript(script);
+    benchCli.begin(&stream);
+
+    start = micros();
+    for (uint32_t i = 0; i < rounds; i++) {
+        stream.rewind();
+        while (stream.available() > 0) {
+            benchCli.loop();
+        }
+    }
+    us = micros() - start;
+
+    lines *= rounds;
+    uint32_t bytes = stream.getLength() * rounds;
+
+    FMT_PRINT(ioStream, "\n[%s]\n", name);
+    FMT_PRINT(ioStream, "  Rounds:         %lu\n", (unsigned long) rounds);
+    FMT_PRINT(ioStream, "  Input bytes:    %lu\n", (unsigned long) bytes);
+    FMT_PRINT(ioStream, "  Output bytes:   %lu in %lu writes\n", 
+        (unsigned long) stream.getOutBytes(), 
+        (unsigned long) stream.getOutCalls());
+    FMT_PRINT(ioStream, "  Time:           %lu us\n", (unsigned long) us);
+    FMT_PRINT(ioStream, "  Commands/sec:   %lu\n", 
+        (unsigned long) benchPerSec(lines, us));
+    FMT_PRINT(ioStream, "  Bytes/sec:      %lu\n", 
+        (unsigned long) benchPerSec(bytes, us));
+    FMT_PRINT(ioStream, "  ns/keystroke:   %lu\n", 
+        (unsigned long) benchNsPer(us, bytes));
+}
+
+/**
+ * @brief Feeds scripted input through Cli::loop() and reports commands/sec, 
+ * bytes/sec and the cost per keystroke. Output of the commands is counted but
+ * not sent anywhere, so the numbers are not limited by the terminal.
+ */
+BENCH_DECL(cli) {
+    runScript(ioStream, "dispatch", scriptDispatch, 8, 200);
+    runScript(ioStream, "editing", scriptEditing, 5, 200);
+}
@@ -0,0 +1,123 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "cmdindex.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Tab completion as done by scanning the whole command table: count the
+ * candidates and shorten the common prefix with every match.
+ */
+static size_t linearComplete(const char *prefix, size_t len, size_t *pCnt) {
+    cliCmd_t *pTab = CliCommand::getTable();
+    size_t cmdCnt = CliCommand::getCmdCnt();
+    const char *pMatch = nullptr;
+    size_t lcp = 0;
+
+    *pCnt = 0;
+    for (size_t i = 0; i < cmdCnt; i++) {
+        const char *name = pTab[i].name;
+
+        if (strncmp(name, prefix, len) != 0) {
+            continue;
+        }
+
+        if (pMatch == nullptr) {
+            pMatch = name;
+            lcp = strlen(name);
+        } else {
+            size_t n = len;
+            while (n < lcp && name[n] == pMatch[n]) {
+                n++;
+            }
+            lcp = n;
+        }
+        (*pCnt)++;
+    }
+
+    return lcp;
+}
+
+/**
+ * @brief Compares tab completion by a linear scan against CmdIndex for every 
+ * prefix of every registered command, e.g. "l", "le", "led", "led_" ...
+ */
+BENCH_DECL(complete) {
+    const uint32_t rounds = 20;
+    cliCmd_t *pTab = CliCommand::getTable();
+    size_t cmdCnt = CliCommand::getCmdCnt();
+    uint32_t calls = 0;
+    uint32_t start = 0;
+    uint32_t usLinear = 0;
+    uint32_t usIndex = 0;
+    uint32_t candidates = 0;
+    size_t cnt = 0;
+    bool same = true;
+
+    for (size_t i = 0; i < cmdCnt; i++) {
+        const char *name = pTab[i].name;
+        for (size_t len = 1; len <= strlen(name); len++) {
+            size_t cntIdx = 0;
+            same &= linearComplete(name, len, &cnt) == 
+                CmdIndex::commonPrefix(name, len, &cntIdx) && cnt == cntIdx;
+            candidates += cnt;
+            calls++;
+        }
+    }
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < cmdCnt; i++) {
+            const char *name = pTab[i].name;
+            for (size_t len = 1; name[len - 1] != '\0'; len++) {
+                linearComplete(name, len, &cnt);
+            }
+        }
+    }
+    usLinear = micros() - start;
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < cmdCnt; i++) {
+            const char *name = pTab[i].name;
+            for (size_t len = 1; name[len - 1] != '\0'; len++) {
+                CmdIndex::commonPrefix(name, len, &cnt);
+            }
+        }
+    }
+    usIndex = micros() - start;
+
+    calls *= rounds;
+    FMT_PRINT(ioStream, "  Commands:       %lu\n", (unsigned long) cmdCnt);
+    FMT_PRINT(ioStream, "  Completions:    %lu, avg %lu candidates\n", 
+        (unsigned long) calls, 
+        (unsigned long) (candidates * rounds / (calls ? calls : 1)));
+    FMT_PRINT(ioStream, "  Same results:   %s\n", same ? "yes" : "NO");
+    FMT_PRINT(ioStream, "  Linear scan:    %lu us, %lu ns/completion\n",
+        (unsigned long) usLinear, (unsigned long) benchNsPer(usLinear, calls));
+    FMT_PRINT(ioStream, "  CmdIndex:       %lu us, %lu ns/completion\n",
+        (unsigned long) usIndex, (unsigned long) benchNsPer(usIndex, calls));
+}
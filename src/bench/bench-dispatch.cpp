@@ -0,0 +1,107 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "cmdindex.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef BENCH_MANY_COMMANDS
+
+/**
+ * @brief Generates 256 commands named gen_00 to gen_ff which do nothing. Only
+ * enabled in the native environment as CLI_COMMANDS_MAX has to be large 
+ * enough to hold them.
+ */
+#define BENCH_CMD(_name)        CLI_COMMAND(_name) { return 0; }
+#define BENCH_CMD16(_p)                                                 \
+    BENCH_CMD(_p##0) BENCH_CMD(_p##1) BENCH_CMD(_p##2) BENCH_CMD(_p##3) \
+    BENCH_CMD(_p##4) BENCH_CMD(_p##5) BENCH_CMD(_p##6) BENCH_CMD(_p##7) \
+    BENCH_CMD(_p##8) BENCH_CMD(_p##9) BENCH_CMD(_p##a) BENCH_CMD(_p##b) \
+    BENCH_CMD(_p##c) BENCH_CMD(_p##d) BENCH_CMD(_p##e) BENCH_CMD(_p##f)
+
+BENCH_CMD16(gen_0) BENCH_CMD16(gen_1) BENCH_CMD16(gen_2) BENCH_CMD16(gen_3)
+BENCH_CMD16(gen_4) BENCH_CMD16(gen_5) BENCH_CMD16(gen_6) BENCH_CMD16(gen_7)
+BENCH_CMD16(gen_8) BENCH_CMD16(gen_9) BENCH_CMD16(gen_a) BENCH_CMD16(gen_b)
+BENCH_CMD16(gen_c) BENCH_CMD16(gen_d) BENCH_CMD16(gen_e) BENCH_CMD16(gen_f)
+
+#endif
+
+/**
+ * @brief Compares the dispatch of CliCommand::exec() against the sorted 
+ * CmdIndex by executing every registered command once per round. Output is 
+ * counted by a ScriptStream and not sent to the terminal.
+ */
+BENCH_DECL(dispatch) {
+    const uint32_t rounds = 100;
+    static const char *names[CLI_COMMANDS_MAX];
+    cliCmd_t *pTab = CliCommand::getTable();
+    size_t cmdCnt = CliCommand::getCmdCnt();
+    size_t nameCnt = 0;
+    ScriptStream stream;
+    uint32_t start = 0;
+    uint32_t usLinear = 0;
+    uint32_t usIndex = 0;
+
+    /* Only commands without side effects on the system are executed. */
+    static const char *skip[] = {"reset", "bench", "test", "telnet", "info"};
+
+    for (size_t i = 0; i < cmdCnt; i++) {
+        bool skipped = false;
+
+        for (size_t s = 0; s < sizeof(skip) / sizeof(skip[0]); s++) {
+            skipped |= strcmp(pTab[i].name, skip[s]) == 0;
+        }
+        if (!skipped) {
+            names[nameCnt++] = pTab[i].name;
+        }
+    }
+
+    uint32_t calls = rounds * nameCnt;
+    stream.setScript("");
+    CmdIndex::getCnt();
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < nameCnt; i++) {
+            CliCommand::exec(stream, names[i], nullptr, 0);
+        }
+    }
+    usLinear = micros() - start;
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < nameCnt; i++) {
+            CmdIndex::exec(stream, names[i], nullptr, 0);
+        }
+    }
+    usIndex = micros() - start;
+
+    FMT_PRINT(ioStream, "  Commands:       %lu\n", (unsigned long) cmdCnt);
+    FMT_PRINT(ioStream, "  Calls:          %lu\n", (unsigned long) calls);
+    FMT_PRINT(ioStream, "  CliCommand:     %lu us, %lu ns/call\n",
+        (unsigned long) usLinear, (unsigned long) benchNsPer(usLinear, calls));
+    FMT_PRINT(ioStream, "  CmdIndex:       %lu us, %lu ns/call\n",
+        (unsigned long) usIndex, (unsigned long) benchNsPer(usIndex, calls));
+}
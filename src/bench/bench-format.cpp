@@ -0,0 +1,138 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief The number of stack bytes painted to find the stack usage, must be
+ * well below the stack size of the loop task.
+ */
+#ifndef BENCH_STACK_PAINT
+#if ARDUINO_ARCH_NATIVE
+#define BENCH_STACK_PAINT       8192
+#else
+#define BENCH_STACK_PAINT       2048
+#endif
+#endif
+
+/**
+ * @brief Fills the stack below the caller with a pattern.
+ */
+static void __attribute__((noinline)) stackPaint(void) {
+    volatile uint8_t area[BENCH_STACK_PAINT];
+
+    for (size_t i = 0; i < sizeof(area); i++) {
+        area[i] = 0xA5;
+    }
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+/**
+ * @brief Returns the number of painted bytes overwritten since stackPaint(),
+ * which has to be called from the same function. Assumes a descending stack.
+ * Reading the uninitialized area is the whole point here.
+ */
+static size_t __attribute__((noinline)) stackUsed(void) {
+    volatile uint8_t area[BENCH_STACK_PAINT];
+    size_t i = 0;
+
+    while (i < sizeof(area) && area[i] == 0xA5) {
+        i++;
+    }
+
+    return sizeof(area) - i;
+}
+
+#pragma GCC diagnostic pop
+
+/**
+ * @brief The same lines as printed by the info and args commands, once 
+ * through Print::printf() and once through FMT_PRINT().
+ */
+static void __attribute__((noinline)) linesPrintf(Stream &io, size_t n) {
+    io.printf("  CLI_COMMANDSIZ:              %d\n", CLI_COMMANDSIZ);
+    io.printf("  CLI_PROMPT:                  %s\n", CLI_PROMPT);
+    io.printf("  argv[%zu]: \"%s\"\n", n, "argument");
+    io.printf("Got value %d\n", -1234);
+}
+
+static void __attribute__((noinline)) linesFormat(Stream &io, size_t n) {
+    FMT_PRINT(io, "  CLI_COMMANDSIZ:              %d\n", CLI_COMMANDSIZ);
+    FMT_PRINT(io, "  CLI_PROMPT:                  %s\n", CLI_PROMPT);
+    FMT_PRINT(io, "  argv[%zu]: \"%s\"\n", n, "argument");
+    FMT_PRINT(io, "Got value %d\n", -1234);
+}
+
+typedef void (*linesFunc_t)(Stream &io, size_t n);
+
+/**
+ * @brief Runs @p func @p rounds times and prints time per call, output and 
+ * stack usage.
+ */
+static void runLines(Stream& ioStream, const char *name, linesFunc_t func,
+    uint32_t rounds) {
+
+    ScriptStream sink;
+    uint32_t start = 0;
+    uint32_t us = 0;
+    size_t stack = 0;
+
+    sink.setScript("");
+    stackPaint();
+    func(sink, 0);
+    stack = stackUsed();
+
+    start = micros();
+    for (uint32_t i = 0; i < rounds; i++) {
+        func(sink, i);
+    }
+    us = micros() - start;
+
+    FMT_PRINT(ioStream, "\n[%s]\n", name);
+    FMT_PRINT(ioStream, "  Rounds:         %lu\n", (unsigned long) rounds);
+    FMT_PRINT(ioStream, "  Output bytes:   %lu in %lu writes\n", 
+        (unsigned long) sink.getOutBytes(), 
+        (unsigned long) sink.getOutCalls());
+    FMT_PRINT(ioStream, "  Time:           %lu us\n", (unsigned long) us);
+    FMT_PRINT(ioStream, "  ns/call:        %lu\n", 
+        (unsigned long) benchNsPer(us, rounds * 4));
+    FMT_PRINT(ioStream, "  Stack:          %s%lu bytes\n", 
+        stack >= BENCH_STACK_PAINT ? ">= " : "", (unsigned long) stack);
+}
+
+/**
+ * @brief Compares Print::printf() with FMT_PRINT() on typical command output.
+ * The stack usage includes the write path of ScriptStream, so only the 
+ * difference between the two is meaningful. Flash usage is best compared by
+ * building a board environment with and without this benchmark.
+ */
+BENCH_DECL(format) {
+    runLines(ioStream, "printf", linesPrintf, 2000);
+    runLines(ioStream, "FMT_PRINT", linesFormat, 2000);
+}
@@ -0,0 +1,161 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "history.hpp"
+#include "format.hpp"
+#include "compacthistory.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Fills the history with entries of the given length until the oldest
+ * entries get evicted, then measures a walk from the newest entry to the 
+ * oldest one and back, as done when holding the arrow keys.
+ */
+template<class H>
+static void walk(Stream& ioStream, const char *name, H& history, 
+    size_t siz, size_t entryLen) {
+
+    const uint32_t rounds = 200;
+    char buf[64];
+    uint32_t seeks = 0;
+    uint32_t start = 0;
+    uint32_t us = 0;
+
+    history.clear();
+    memset(buf, 'x', entryLen);
+    buf[entryLen] = '\0';
+    for (size_t i = 0; i < 2 * siz / (entryLen + 1); i++) {
+        buf[0] = 'a' + (i % 26);
+        history.append(buf, entryLen);
+    }
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++) {
+        while (history.seek_backward()) {
+            history.read(buf, sizeof(buf));
+            seeks++;
+        }
+        while (history.seek_forward()) {
+            history.read(buf, sizeof(buf));
+            seeks++;
+        }
+    }
+    us = micros() - start;
+
+    FMT_PRINT(ioStream, 
+        "  %-22s %5lu bytes, %2lu char entries: %5lu ns/seek+read\n", 
+        name, (unsigned long) siz, (unsigned long) entryLen, 
+        (unsigned long) benchNsPer(us, seeks));
+}
+
+/**
+ * @brief Compares history navigation of CliHistory with the indexed 
+ * HistoryRing, for the configured CLI_HISTORYSIZ and for a larger buffer.
+ */
+BENCH_DECL(history) {
+#if CLI_HISTORYSIZ > 0
+    static CliHistory cliHistory;
+    static HistoryRing<CLI_HISTORYSIZ> ring;
+    static HistoryRing<2048, 128> largeRing;
+
+    walk(ioStream, "CliHistory", cliHistory, CLI_HISTORYSIZ, 8);
+    walk(ioStream, "HistoryRing", ring, CLI_HISTORYSIZ, 8);
+    walk(ioStream, "CliHistory", cliHistory, CLI_HISTORYSIZ, 48);
+    walk(ioStream, "HistoryRing", ring, CLI_HISTORYSIZ, 48);
+    walk(ioStream, "HistoryRing<2048,128>", largeRing, 2048, 8);
+    walk(ioStream, "HistoryRing<2048,128>", largeRing, 2048, 48);
+#else
+    FMT_PRINT(ioStream, "  [SKIPPED] CLI_HISTORYSIZ is 0\n");
+#endif
+}
+
+/**
+ * @brief A recorded session of a provisioning and debugging run.
+ */
+static const char *corpus[] = {
+    "telnet begin lab-wifi-2g secret123", "telnet info", "info", "led b",
+    "led 0", "led 1", "led_on", "led_off", "led_blink", "dummy_long_1",
+    "dummy_long_2", "dummy_long_3", "dummy_long_4", "dummy_1", "dummy_2",
+    "list", "args a b c", "args a b c d", "err 0", "err 1", "err -1", 
+    "telnet begin lab-wifi-5g secret123", "telnet info", "test history",
+    "test historyidx", "test all", "bench cli", "bench history", "ver", 
+    "echo off", "echo on", "led b", "led 0", "led 1", "dummy_long_1",
+    "dummy_long_2", "dummy_3", "dummy_4", "help", "info"
+};
+
+/**
+ * @brief Feeds the corpus into the given history and reports how many 
+ * entries it holds in the end.
+ */
+template<class H>
+static void fill(Stream& ioStream, const char *name, H& history, size_t siz) {
+    size_t cnt = sizeof(corpus) / sizeof(corpus[0]);
+
+    history.clear();
+    for (size_t round = 0; round < 3; round++) {
+        for (size_t i = 0; i < cnt; i++) {
+            history.append(corpus[i], strlen(corpus[i]));
+        }
+    }
+
+    size_t used = siz - history.get_free_space();
+    FMT_PRINT(ioStream, 
+        "  %-24s %3lu entries in %3lu bytes, %2lu.%02lu bytes/entry\n",
+        name, (unsigned long) history.get_count(), (unsigned long) used,
+        (unsigned long) (used / history.get_count()), 
+        (unsigned long) (used * 100 / history.get_count() % 100));
+}
+
+/**
+ * @brief Compares the number of entries the plain and the prefix compressed
+ * history format hold for a recorded command corpus.
+ */
+BENCH_DECL(histcompress) {
+    static HistoryRing<200, 64> ring;
+    static CompactHistory<200, 64> compact;
+    static CompactHistory<200, 64, 4> compact4;
+    char buf[64];
+    const uint32_t rounds = 200;
+    uint32_t start = 0;
+    uint32_t reads = 0;
+
+    fill(ioStream, "HistoryRing", ring, 200);
+    fill(ioStream, "CompactHistory", compact, 200);
+    fill(ioStream, "CompactHistory RESTART=4", compact4, 200);
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++) {
+        while (compact.seek_backward()) {
+            compact.read(buf, sizeof(buf));
+            reads++;
+        }
+        while (compact.seek_forward()) {
+            compact.read(buf, sizeof(buf));
+            reads++;
+        }
+    }
+    FMT_PRINT(ioStream, "  CompactHistory read:     %lu ns/seek+read\n", 
+        (unsigned long) benchNsPer(micros() - start, reads));
+}
@@ -0,0 +1,144 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "cmdindex.hpp"
+#include "cmdrpc.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief The commands of the script, the same ones run in both modes. Cheap
+ * commands with short output, as a test rig or provisioning tool uses them.
+ */
+static const char *const rpcScript[][3] = {
+    {"led", "0", nullptr},
+    {"args", "wifi", "ssid"},
+    {"err", "0", nullptr},
+    {"led_blink", nullptr, nullptr},
+    {"args", "mqtt", "192.168.0.1"},
+    {"dummy_1", nullptr, nullptr},
+    {"err", "0", nullptr},
+    {"led", "b", nullptr},
+};
+
+#define RPC_CMDS                (sizeof(rpcScript) / sizeof(rpcScript[0]))
+#define RPC_ROUNDS              200
+
+/**
+ * @brief The rate of a UART at 115200 baud, 8N1.
+ */
+#define RPC_UART_BYTES          11520
+
+/**
+ * @brief Prints the rates of a run. A UART sends in both directions at once,
+ * so the longer direction limits the commands/sec.
+ */
+static void report(Stream& ioStream, const char *name, uint32_t us, 
+    uint32_t inBytes, const ScriptStream &stream) {
+
+    uint32_t cmds = RPC_CMDS * RPC_ROUNDS;
+    uint32_t outBytes = stream.getOutBytes();
+    uint32_t wire = inBytes > outBytes ? inBytes : outBytes;
+
+    FMT_PRINT(ioStream, "\n[%s]\n", name);
+    FMT_PRINT(ioStream, "  Commands:       %lu\n", (unsigned long) cmds);
+    FMT_PRINT(ioStream, "  Time:           %lu us, %lu ns/cmd\n", 
+        (unsigned long) us, (unsigned long) benchNsPer(us, cmds));
+    FMT_PRINT(ioStream, "  Commands/sec:   %lu\n", 
+        (unsigned long) benchPerSec(cmds, us));
+    FMT_PRINT(ioStream, "  Bytes/cmd:      %lu in, %lu out\n", 
+        (unsigned long) (inBytes / cmds), (unsigned long) (outBytes / cmds));
+    FMT_PRINT(ioStream, "  UART 115200:    %lu commands/sec\n", 
+        (unsigned long) ((uint64_t) cmds * RPC_UART_BYTES / wire));
+}
+
+/**
+ * @brief Compares the commands typed into the Cli, with echo, prompt and 
+ * parsing, to the same commands sent as CmdRpc requests.
+ */
+BENCH_DECL(rpc) {
+    static Cli benchCli;
+    static char text[RPC_CMDS * 40];
+    static uint8_t frames[RPC_CMDS * (CMDRPC_RXSIZ + 4)];
+    ScriptStream stream;
+    size_t textLen = 0;
+    size_t framesLen = 0;
+    uint32_t start = 0;
+    uint32_t us = 0;
+
+    for (size_t i = 0; i < RPC_CMDS; i++) {
+        uint8_t frame[CMDRPC_RXSIZ];
+        size_t idx = CmdIndex::find(rpcScript[i][0]) - CliCommand::getTable();
+        size_t len = 5;
+        size_t argc = 0;
+
+        textLen += snprintf(&text[textLen], sizeof(text) - textLen, "%s", 
+            rpcScript[i][0]);
+        for (size_t k = 1; k < 3 && rpcScript[i][k] != nullptr; k++) {
+            size_t n = strlen(rpcScript[i][k]) + 1;
+
+            textLen += snprintf(&text[textLen], sizeof(text) - textLen, 
+                " %s", rpcScript[i][k]);
+            memcpy(&frame[len], rpcScript[i][k], n);
+            len += n;
+            argc++;
+        }
+        textLen += snprintf(&text[textLen], sizeof(text) - textLen, 
+            BENCH_EOL);
+
+        frame[0] = CMDRPC_CALL;
+        frame[1] = (uint8_t) i;
+        frame[2] = (uint8_t) idx;
+        frame[3] = (uint8_t) (idx >> 8);
+        frame[4] = (uint8_t) argc;
+        framesLen += CmdRpc::pack(frame, len, &frames[framesLen]);
+    }
+
+    stream.setScript(text, textLen);
+    benchCli.begin(&stream);
+    start = micros();
+    for (uint32_t i = 0; i < RPC_ROUNDS; i++) {
+        stream.rewind();
+        while (stream.available() > 0) {
+            benchCli.loop();
+        }
+    }
+    us = micros() - start;
+    report(ioStream, "text", us, textLen * RPC_ROUNDS, stream);
+
+    CmdRpc rpc(stream);
+
+    stream.setScript((const char *) frames, framesLen);
+    rpc.begin();
+    benchCli.begin(&rpc);
+    start = micros();
+    for (uint32_t i = 0; i < RPC_ROUNDS; i++) {
+        stream.rewind();
+        while (stream.available() > 0) {
+            benchCli.loop();
+        }
+    }
+    us = micros() - start;
+    report(ioStream, "rpc", us, framesLen * RPC_ROUNDS, stream);
+}
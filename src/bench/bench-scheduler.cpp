@@ -0,0 +1,114 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+#include <generic/task.hpp>
+
+#include "bench.hpp"
+#include "scheduler.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* 128 jobs with statistics plus a Task each need about 11 KB of RAM, more 
+ * than the small boards can spare, so this one runs on the host only. */
+#ifdef ARDUINO_ARCH_NATIVE
+
+/**
+ * @brief The number of periodic jobs.
+ */
+#define BENCH_JOBS              128
+
+/**
+ * @brief The simulated time in ms, one loop iteration per ms.
+ */
+#define BENCH_JOB_TIME          10000
+
+/**
+ * @brief Counts the runs of all jobs.
+ */
+static volatile uint32_t jobRuns = 0;
+
+static void benchJob(uint32_t now) {
+    jobRuns++;
+}
+
+/**
+ * @brief Periods between 10 ms and 1 s.
+ */
+static uint32_t jobPeriod(size_t i) {
+    return 10 + (i * 37) % 990;
+}
+
+static void report(Stream& ioStream, const char *name, uint32_t us) {
+    FMT_PRINT(ioStream, "\n[%s]\n", name);
+    FMT_PRINT(ioStream, "  Jobs:           %u\n", (unsigned int) BENCH_JOBS);
+    FMT_PRINT(ioStream, "  Iterations:     %lu\n", 
+        (unsigned long) BENCH_JOB_TIME);
+    FMT_PRINT(ioStream, "  Runs:           %lu\n", (unsigned long) jobRuns);
+    FMT_PRINT(ioStream, "  Time:           %lu us\n", (unsigned long) us);
+    FMT_PRINT(ioStream, "  ns/iteration:   %lu\n", 
+        (unsigned long) benchNsPer(us, BENCH_JOB_TIME));
+}
+
+/**
+ * @brief Compares the CPU time per loop iteration of polling a Task per job 
+ * against the heap based Scheduler, with a simulated clock advancing 1 ms 
+ * per iteration.
+ */
+BENCH_DECL(scheduler) {
+    static Task *tasks[BENCH_JOBS];
+    static Scheduler<BENCH_JOBS> sched;
+    static uint32_t clock = 0;
+    uint32_t start = 0;
+
+    for (size_t i = 0; i < BENCH_JOBS; i++) {
+        if (tasks[i] == nullptr) {
+            tasks[i] = new Task(jobPeriod(i));
+        }
+        if (sched.getCount() < BENCH_JOBS) {
+            sched.add(benchJob, jobPeriod(i), clock);
+        }
+    }
+
+    jobRuns = 0;
+    start = micros();
+    for (uint32_t now = clock + 1; now <= clock + BENCH_JOB_TIME; now++) {
+        for (size_t i = 0; i < BENCH_JOBS; i++) {
+            if (tasks[i]->isScheduled(now)) {
+                benchJob(now);
+            }
+        }
+    }
+    report(ioStream, "Task polling", micros() - start);
+
+    jobRuns = 0;
+    start = micros();
+    for (uint32_t now = clock + 1; now <= clock + BENCH_JOB_TIME; now++) {
+        sched.loop(now);
+    }
+    report(ioStream, "Scheduler", micros() - start);
+
+    /* Both keep their deadlines, the next run continues the clock. */
+    clock += BENCH_JOB_TIME;
+}
+
+#endif /* ARDUINO_ARCH_NATIVE */
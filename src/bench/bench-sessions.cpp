@@ -0,0 +1,127 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "sessionpool.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* Eight sessions with a Cli and a history each need about 9 KB of RAM, more
+ * than the small boards can spare, so this one runs on the host only. */
+#ifdef ARDUINO_ARCH_NATIVE
+
+/**
+ * @brief The largest number of sessions measured.
+ */
+#define BENCH_SESSIONS          8
+
+/**
+ * @brief Stands in for a WiFiClient, always connected and remembers when it
+ * has been written to the last time.
+ */
+class BenchClient : public ScriptStream {
+    public:
+        BenchClient() : lastUs(0) {}
+
+        bool connected() { 
+            return true; 
+        }
+
+        void stop() {}
+
+        size_t write(uint8_t c) override {
+            lastUs = micros();
+            return ScriptStream::write(c);
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) override {
+            lastUs = micros();
+            return ScriptStream::write(buffer, size);
+        }
+
+        using Print::write;
+
+        uint32_t lastUs;
+};
+
+/**
+ * @brief Each client sends a command at the same time, the latency of a 
+ * session is the time until the last byte of its answer, the prompt, has 
+ * been written.
+ */
+static void runSessions(Stream& ioStream, 
+    SessionPool<BenchClient, BENCH_SESSIONS> &pool, uint32_t rounds) {
+
+    size_t cnt = pool.getCount();
+    uint32_t sum = 0;
+    uint32_t max = 0;
+    uint32_t start = 0;
+
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < cnt; i++) {
+            pool.at(i).client.rewind();
+        }
+
+        start = micros();
+        for (bool busy = true; busy; ) {
+            pool.serve([](BenchClient &client) {});
+            busy = false;
+            for (size_t i = 0; i < cnt; i++) {
+                busy = busy || pool.at(i).client.available() > 0;
+            }
+        }
+
+        for (size_t i = 0; i < cnt; i++) {
+            uint32_t us = pool.at(i).client.lastUs - start;
+
+            sum += us;
+            max = us > max ? us : max;
+        }
+    }
+
+    FMT_PRINT(ioStream, "  %2u sessions:  avg %5lu us  max %5lu us\n", 
+        (unsigned int) cnt, (unsigned long) (sum / (cnt * rounds)), 
+        (unsigned long) max);
+}
+
+/**
+ * @brief Measures the command latency of telnet sessions served round-robin 
+ * from one loop, with scripted clients in place of WiFiClient.
+ */
+BENCH_DECL(sessions) {
+    static SessionPool<BenchClient, BENCH_SESSIONS> pool;
+    BenchClient client;
+
+    client.setScript("list" BENCH_EOL);
+
+    FMT_PRINT(ioStream, "\n[list on every session]\n");
+    for (size_t n = 1; n <= BENCH_SESSIONS; n *= 2) {
+        while (pool.getCount() < n) {
+            pool.open(client)->begin();
+        }
+        runSessions(ioStream, pool, 200);
+    }
+}
+
+#endif /* ARDUINO_ARCH_NATIVE */
@@ -0,0 +1,141 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "cmdtoken.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Typical command lines, the plain ones can be split by both parsers.
+ */
+static const char *const tokenLines[] = {
+    "led 0",
+    "args wifi ssid",
+    "telnet begin MyNet secret",
+    "args mqtt host 192.168.0.1",
+    "err 0",
+    "  args  a   b  ",
+};
+
+/**
+ * @brief The same lines with quotes, only CmdTokens can split them.
+ */
+static const char *const tokenQuoted[] = {
+    "telnet begin \"My Home Net\" 'pa ss'",
+    "args \"a b\" c\\ d 'e'",
+};
+
+#define TOKEN_LINES             (sizeof(tokenLines) / sizeof(tokenLines[0]))
+#define TOKEN_QUOTED            (sizeof(tokenQuoted) / sizeof(tokenQuoted[0]))
+#define TOKEN_ROUNDS            2000
+
+/**
+ * @brief Keeps the compiler from dropping the loops.
+ */
+static volatile size_t tokenSink;
+
+/**
+ * @brief Splits the lines by strtok_r() into a fixed argv, the way a parser
+ * with an argv array per instance does.
+ */
+static uint32_t splitStrtok(const char *const lines[], size_t cnt) {
+    static char line[CLI_COMMANDSIZ];
+    static const char *argv[CLI_ARGVSIZ + 1];
+    uint32_t start = micros();
+
+    for (uint32_t r = 0; r < TOKEN_ROUNDS; r++) {
+        for (size_t i = 0; i < cnt; i++) {
+            char *pSave = nullptr;
+            size_t argc = 0;
+
+            strcpy(line, lines[i]);
+            for (char *pTok = strtok_r(line, " \t", &pSave); 
+                pTok != nullptr && argc <= CLI_ARGVSIZ; 
+                pTok = strtok_r(nullptr, " \t", &pSave)) {
+                argv[argc++] = pTok;
+            }
+            tokenSink = argc + (uint8_t) argv[argc - 1][0];
+        }
+    }
+
+    return micros() - start;
+}
+
+/**
+ * @brief Splits the lines by CmdTokens, argv is on the stack.
+ */
+static uint32_t splitTokens(const char *const lines[], size_t cnt) {
+    static char line[CLI_COMMANDSIZ];
+    uint32_t start = micros();
+
+    for (uint32_t r = 0; r < TOKEN_ROUNDS; r++) {
+        for (size_t i = 0; i < cnt; i++) {
+            const char *argv[CMDTOKEN_ARGVSIZ];
+            CmdTokens tokens;
+
+            strcpy(line, lines[i]);
+            tokens.split(line);
+            tokenSink = tokens.toArgv(argv, CMDTOKEN_ARGVSIZ) + 
+                (uint8_t) argv[0][0];
+        }
+    }
+
+    return micros() - start;
+}
+
+/**
+ * @brief Prints the time per line of a run.
+ */
+static void report(Stream& ioStream, const char *name, uint32_t us, 
+    size_t cnt) {
+
+    uint32_t lines = cnt * TOKEN_ROUNDS;
+
+    FMT_PRINT(ioStream, "  %-16s %8lu us %8lu ns/line %10lu lines/sec\n", name,
+        (unsigned long) us, (unsigned long) benchNsPer(us, lines),
+        (unsigned long) benchPerSec(lines, us));
+}
+
+/**
+ * @brief Compares CmdTokens to a strtok_r() parser, by time per line and by
+ * the RAM an argv takes.
+ */
+BENCH_DECL(tokenize) {
+    FMT_PRINT(ioStream, "\n[Time per line]\n");
+    report(ioStream, "strtok_r", splitStrtok(tokenLines, TOKEN_LINES), 
+        TOKEN_LINES);
+    report(ioStream, "CmdTokens", splitTokens(tokenLines, TOKEN_LINES), 
+        TOKEN_LINES);
+    report(ioStream, "CmdTokens quoted", 
+        splitTokens(tokenQuoted, TOKEN_QUOTED), TOKEN_QUOTED);
+
+    FMT_PRINT(ioStream, "\n[RAM]\n");
+    FMT_PRINT(ioStream, "  argv per instance, %2d args:  %3lu bytes\n", 
+        CLI_ARGVSIZ, (unsigned long) (CLI_ARGVSIZ * sizeof(const char *)));
+    FMT_PRINT(ioStream, "  CmdTokens per instance:      %3lu bytes\n", 
+        (unsigned long) sizeof(CmdTokens));
+    FMT_PRINT(ioStream, "  argv on the stack, %2d args:  %3lu bytes\n",
+        CMDTOKEN_ARGVSIZ, 
+        (unsigned long) (CMDTOKEN_ARGVSIZ * sizeof(const char *)));
+}
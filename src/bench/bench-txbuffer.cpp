@@ -0,0 +1,115 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "bench.hpp"
+#include "txbuffer.hpp"
+#include "telnetserver.hpp"
+#include "telnetstream.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Commands producing multi line output, where each printf() ends up
+ * as a write call of its own on an unbuffered stream.
+ */
+static const char scriptOutput[] =
+    "help" BENCH_EOL
+    "list" BENCH_EOL
+    "args a b c d e f" BENCH_EOL;
+
+/**
+ * @brief The number of commands in scriptOutput.
+ */
+#define BENCH_OUTPUT_CMDS       3
+
+/**
+ * @brief Runs the script @p rounds times through a dedicated Cli instance 
+ * attached to @p io and prints the number of write calls which reached 
+ * @p wire.
+ */
+static void runOutput(Stream& ioStream, const char *name, Stream &io,
+    ScriptStream &wire, uint32_t rounds) {
+
+    static Cli benchCli;
+    uint32_t start = 0;
+    uint32_t us = 0;
+
+    wire.setScript(scriptOutput);
+    benchCli.begin(&io);
+
+    start = micros();
+    for (uint32_t i = 0; i < rounds; i++) {
+        wire.rewind();
+        while (io.available() > 0) {
+            benchCli.loop();
+        }
+    }
+    io.flush();
+    us = micros() - start;
+
+    FMT_PRINT(ioStream, "\n[%s]\n", name);
+    FMT_PRINT(ioStream, "  Rounds:         %lu\n", (unsigned long) rounds);
+    FMT_PRINT(ioStream, "  Output bytes:   %lu\n", 
+        (unsigned long) wire.getOutBytes());
+    FMT_PRINT(ioStream, "  Write calls:    %lu\n", 
+        (unsigned long) wire.getOutCalls());
+    FMT_PRINT(ioStream, "  Bytes/write:    %lu\n", (unsigned long) 
+        (wire.getOutCalls() ? wire.getOutBytes() / wire.getOutCalls() : 0));
+    FMT_PRINT(ioStream, "  Writes/command: %lu\n", (unsigned long) 
+        (wire.getOutCalls() / (rounds * BENCH_OUTPUT_CMDS)));
+    FMT_PRINT(ioStream, "  Time:           %lu us\n", (unsigned long) us);
+    FMT_PRINT(ioStream, "  Bytes/sec:      %lu\n", 
+        (unsigned long) benchPerSec(wire.getOutBytes(), us));
+}
+
+/**
+ * @brief Compares the write calls reaching the terminal stream with and 
+ * without the BufferedStream in between. On a real UART or TCP connection 
+ * every write call has a fixed cost, so fewer and larger writes mean less 
+ * time spent in the driver and fewer packets. With setNoDelay(true) each 
+ * write on a telnet connection is a TCP segment of its own, so the telnet 
+ * runs report segments per command.
+ */
+BENCH_DECL(txbuffer) {
+    ScriptStream wire;
+    TelnetStream telnet;
+
+    runOutput(ioStream, "direct", wire, wire, 50);
+
+#if TXBUFFER_SIZ > 0
+    BufferedStream<> buffered(wire);
+    runOutput(ioStream, "buffered", buffered, wire, 50);
+#endif
+
+    telnet.begin(wire);
+    runOutput(ioStream, "telnet", telnet, wire, 50);
+
+#if TELNET_TXBUFFER_SIZ > 0
+    static BufferedStream<TELNET_TXBUFFER_SIZ> coalesced;
+    coalesced.setStream(wire);
+    coalesced.setMaxDelay(TELNET_TXBUFFER_DELAY);
+    telnet.begin(coalesced);
+    runOutput(ioStream, "telnet coalesced", telnet, wire, 50);
+#endif
+}
@@ -0,0 +1,104 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.hpp"
+#include <cli/cli.hpp>
+#include "cmdhelp.hpp"
+#include "format.hpp"
+
+/** 
+ * Use BENCH_DECL(_name_) to declare all benchmark functions, then add them to 
+ * the benchTab with BENCH(_name_).
+ */
+BENCH_DECL(cli);
+BENCH_DECL(dispatch);
+BENCH_DECL(complete);
+BENCH_DECL(history);
+BENCH_DECL(histcompress);
+BENCH_DECL(txbuffer);
+BENCH_DECL(format);
+#ifdef ARDUINO_ARCH_NATIVE
+BENCH_DECL(sessions);
+BENCH_DECL(scheduler);
+#endif
+BENCH_DECL(batch);
+BENCH_DECL(rpc);
+BENCH_DECL(tokenize);
+
+/**
+ * Same as the unittestTab, the table is used for the lookup of benchmarks
+ * based on user input.
+ */
+bench_t benchTab[] = {
+    BENCH(cli),
+    BENCH(dispatch),
+    BENCH(complete),
+    BENCH(history),
+    BENCH(histcompress),
+    BENCH(txbuffer),
+    BENCH(format),
+#ifdef ARDUINO_ARCH_NATIVE
+    BENCH(sessions),
+    BENCH(scheduler),
+#endif
+    BENCH(batch),
+    BENCH(rpc),
+    BENCH(tokenize),
+    {0, 0}
+};
+
+/**
+ * The CLI command for running benchmarks.
+ * Add new benchmarks to the table above and implement them in separate files 
+ * like src/bench/bench-cli.cpp
+ */
+CLI_COMMAND(bench) {
+    bool found = false;
+
+    if (argc != 1) {
+        FMT_PRINT(ioStream, "Usage: bench [name|all]\n");
+        FMT_PRINT(ioStream, "Available benchmarks:\n");
+        for (size_t i = 0; benchTab[i].name != nullptr; i++) {
+            FMT_PRINT(ioStream, "  %s\n", benchTab[i].name);
+        }
+        return -1;
+    }
+
+    for (size_t i = 0; benchTab[i].name != nullptr; i++) {
+        if (strcmp(argv[0], "all") == 0 || 
+            strcmp(argv[0], benchTab[i].name) == 0) {
+            FMT_PRINT(ioStream, "=== Running benchmark: %s ===\n", 
+                benchTab[i].name);
+            benchTab[i].pfunc(ioStream);
+            FMT_PRINT(ioStream, "\n");
+            found = true;
+        }
+    }
+
+    if (!found) {
+        FMT_PRINT(ioStream, "Benchmark '%s' not found.\n", argv[0]);
+        return -1;
+    }
+
+    return 0;
+}
+
+CLI_HELP(bench, "Testing/Debug", "<name|all>",
+    "Run benchmarks\n"
+    "Without a name the available benchmarks are listed.");
@@ -0,0 +1,153 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+#include <stddef.h>
+
+/**
+ * @brief Use BENCH_DECL(_name_) to declare benchmark functions, then add them
+ * to the benchmark table using BENCH(_name_).
+ */
+#define BENCH_DECL(_name)       void bench_##_name(Stream& ioStream)
+
+/**
+ * @brief Use BENCH(_name_) when adding benchmark functions to the table.
+ */
+#define BENCH(_name)            {#_name, bench_##_name}
+
+/**
+ * @brief The line ending used in benchmark scripts, same as a terminal sends
+ * when pressing Enter.
+ */
+#define BENCH_EOL               "\r"
+
+/**
+ * @brief Benchmark function pointer type.
+ */
+typedef void (*BenchFuncPtr)(Stream& ioStream);
+
+/**
+ * @brief The bench_t structure is used to store the benchmark name and the
+ * corresponding function pointer, same as unittest_t does for tests.
+ */
+typedef struct {
+
+    const char *name;
+    BenchFuncPtr pfunc;
+
+} bench_t;
+
+/**
+ * @brief A Stream which feeds a fixed script to its reader and swallows all 
+ * output while counting it. 
+ * 
+ * Used to drive a Cli instance with scripted input at full speed, without 
+ * being limited by the baud rate of the real terminal.
+ */
+class ScriptStream : public Stream {
+    public:
+        ScriptStream() : pScript(nullptr), len(0), pos(0), 
+            outBytes(0), outCalls(0) {}
+
+        /**
+         * @brief Sets the script to feed and resets all counters.
+         */
+        void setScript(const char *script, size_t len) {
+            pScript = script;
+            this->len = len;
+            rewind();
+            outBytes = 0;
+            outCalls = 0;
+        }
+
+        void setScript(const char *script) {
+            setScript(script, strlen(script));
+        }
+
+        /**
+         * @brief Starts feeding the script from the beginning again, the 
+         * output counters are kept.
+         */
+        void rewind() { 
+            pos = 0; 
+        }
+
+        int available() override { 
+            return (int)(len - pos); 
+        }
+
+        int read() override { 
+            return pos < len ? (uint8_t) pScript[pos++] : -1; 
+        }
+
+        int peek() override { 
+            return pos < len ? (uint8_t) pScript[pos] : -1; 
+        }
+
+        size_t write(uint8_t c) override {
+            outBytes++;
+            outCalls++;
+            return 1;
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) override {
+            outBytes += size;
+            outCalls++;
+            return size;
+        }
+
+        size_t getLength() const { 
+            return len; 
+        }
+
+        uint32_t getOutBytes() const { 
+            return outBytes; 
+        }
+
+        uint32_t getOutCalls() const { 
+            return outCalls; 
+        }
+
+    private:
+        const char *pScript;
+        size_t len;
+        size_t pos;
+        uint32_t outBytes;
+        uint32_t outCalls;
+};
+
+/**
+ * @brief Scales @p cnt events measured in @p us micro seconds to events per
+ * second without overflowing 32 bit math.
+ */
+static inline uint32_t benchPerSec(uint32_t cnt, uint32_t us) {
+    return us == 0 ? 0 : (uint32_t)(((uint64_t) cnt * 1000000ULL) / us);
+}
+
+/**
+ * @brief Scales @p us micro seconds spent on @p cnt events to nano seconds 
+ * per event.
+ */
+static inline uint32_t benchNsPer(uint32_t us, uint32_t cnt) {
+    return cnt == 0 ? 0 : (uint32_t)(((uint64_t) us * 1000ULL) / cnt);
+}
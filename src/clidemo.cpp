@@ -24,13 +24,31 @@
 #include <Arduino.h>
 #include <cli/cli.hpp>
 #include <generic/generic.hpp>
-#include <generic/task.hpp>
 
 #include "version/version.h"
 #include "telnetserver.hpp"
+#include "cmdindex.hpp"
+#include "cmdstats.hpp"
+#include "cmdpipe.hpp"
+#include "historysearch.hpp"
+#include "txbuffer.hpp"
+#include "format.hpp"
+#include "scheduler.hpp"
+#include "corelink.hpp"
+#include "cmdjob.hpp"
+#include "cmdbatch.hpp"
+#include "cmdrpc.hpp"
+#include "cmdschema.hpp"
+#include "cmdhelp.hpp"
+#include "historylog.hpp"
 
 #include <stdio.h>
 #include <stdint.h>
+#include <atomic>
+
+#if HAS_LITTLEFS_SUPPORT
+#include <LittleFS.h>
+#endif
 
 #ifdef ARDUINO_ARCH_ESP8266
 /**
@@ -54,6 +72,40 @@
 #define SERIAL_RX_BUFFER_SIZE       0
 #endif
 
+/**
+ * @brief Runs the Cli of the serial console and the telnet sessions on the 
+ * second core, so that a long command does not delay the periodic jobs. 
+ * Supported on ESP32 and RP2040.
+ */
+#ifndef CLI_CORE
+#define CLI_CORE                0
+#endif
+
+#if CLI_CORE && !defined(ARDUINO_ARCH_ESP32) && !defined(ARDUINO_ARCH_RP2040)
+#error "CLI_CORE is supported on ESP32 and RP2040 only"
+#endif
+
+#if CLI_CORE && defined(ARDUINO_ARCH_ESP32)
+
+/**
+ * @brief The core of the Cli task, the one not running loop(). Single core 
+ * variants run it as task of its own next to loop().
+ */
+#if CONFIG_FREERTOS_UNICORE
+#define CLI_CORE_ID             0
+#else
+#define CLI_CORE_ID             (ARDUINO_RUNNING_CORE == 0 ? 1 : 0)
+#endif
+
+/**
+ * @brief The stack size of the Cli task in bytes.
+ */
+#ifndef CLI_CORE_STACK
+#define CLI_CORE_STACK          8192
+#endif
+
+#endif
+
 /**
  * @brief Used to define dummy commands for testing the command listing and
  * command completion functionality.
@@ -61,7 +113,7 @@
  */
 #define DUMMY_CMD(_name)                                            \
     CLI_COMMAND(_name) {                                            \
-        ioStream.printf("Executed dummy command %s\n", #_name);     \
+        FMT_PRINT(ioStream, "Executed dummy command %s\n", #_name); \
         return 0;                                                   \
     }
 
@@ -78,6 +130,117 @@ typedef enum{
  */
 Cli cli;
 
+#if CLI_CORE
+
+/**
+ * @brief Carries the serial console between Serial, which is only used by 
+ * loop(), and the Cli on the other core.
+ */
+CoreLink<> serialLink;
+
+/**
+ * @brief The stream the serial console is operated on.
+ */
+Stream &serialIo = serialLink;
+
+/**
+ * @brief Counts how often the serial console has been (re)connected, written
+ * by loop() and polled by the Cli core to begin the Cli.
+ */
+std::atomic<uint32_t> serialBegins(0);
+
+#elif TXBUFFER_SIZ > 0
+
+/**
+ * @brief Collects the output of commands and sends it in large chunks.
+ */
+BufferedStream<> serialOut(Serial);
+
+/**
+ * @brief The stream the serial console is operated on.
+ */
+Stream &serialIo = serialOut;
+
+#else
+
+Stream &serialIo = Serial;
+
+#endif
+
+/**
+ * @brief Adds the binary machine mode to the serial console, below all text
+ * handling so that frames pass untouched.
+ */
+CmdRpc serialRpc(serialIo);
+
+/**
+ * @brief Keeps the lines entered on the serial console across resets, in a 
+ * log file on LittleFS or, on the native environment, in the working 
+ * directory. Only the Ctrl-R history is kept, the history of the Cli is 
+ * inside libcli.
+ */
+#ifndef HISTORY_PERSIST
+#define HISTORY_PERSIST         0
+#endif
+
+#if HISTORY_PERSIST && !defined(ARDUINO_ARCH_NATIVE) && !HAS_LITTLEFS_SUPPORT
+#error "HISTORY_PERSIST needs LittleFS or the native environment"
+#endif
+
+#if HISTORY_PERSIST && HISTORY_COMPACT
+#error "HISTORY_PERSIST and HISTORY_COMPACT can not be combined"
+#endif
+
+/**
+ * @brief The maximum size of the history log, it is compacted once every 
+ * HISTORY_LOGSIZ - CLI_HISTORYSIZ appended bytes.
+ */
+#ifndef HISTORY_LOGSIZ
+#define HISTORY_LOGSIZ          (4 * CLI_HISTORYSIZ)
+#endif
+
+#if HAS_REVERSE_SEARCH
+
+#if HISTORY_PERSIST
+
+typedef PersistentHistory<CLI_HISTORYSIZ> SerialHistory;
+
+/**
+ * @brief The log of the serial console history.
+ */
+#ifdef ARDUINO_ARCH_NATIVE
+HistoryFileStore historyStore("history.log", HISTORY_LOGSIZ);
+#else
+HistoryFsStore historyStore(LittleFS, "/history.log", HISTORY_LOGSIZ);
+#endif
+
+#else
+
+typedef ConsoleHistory SerialHistory;
+
+#endif
+
+/**
+ * @brief Lines entered on the serial console, searched by Ctrl-R.
+ */
+SerialHistory serialHistory;
+
+/**
+ * @brief Adds Ctrl-R reverse search to the serial console.
+ */
+SearchStream<SerialHistory> serialInput(serialRpc, serialHistory);
+
+/**
+ * @brief Runs resumable commands of the serial console.
+ */
+CmdJob serialJob(serialInput);
+
+#else
+
+CmdJob serialJob(serialRpc);
+
+#endif
+
 /**
  * @brief The global telnet server instance.
  */
@@ -89,51 +252,80 @@ TelnetServer telnetServer;
 led_mode_t ledMode = LED_BLINK;
 
 /**
- * @brief To blink the led .. wohoo
+ * @brief The longest main loop iteration in micro seconds since the last 
+ * "telnet begin", to see if anything blocks the loop.
+ */
+uint32_t loopMaxUs = 0;
+
+#if SCHEDULER_STATS
+
+/**
+ * @brief Set by "tasks reset", the statistics are written by loop() only and
+ * so cleared there.
+ */
+std::atomic<bool> tasksReset(false);
+
+#endif
+
+/**
+ * @brief The maximum number of periodic jobs.
+ */
+#ifndef SCHEDULER_JOBS
+#define SCHEDULER_JOBS          8
+#endif
+
+/**
+ * @brief Runs the periodic jobs of the demo.
  */
-Task ledTask(250);
-Task serialTask(10);
+Scheduler<SCHEDULER_JOBS> scheduler;
 
 /**
  * @brief Used to print version information.
  */
 CLI_COMMAND(ver) {
-    ioStream.printf("\n%s %s, Copyright (C) 2025 Julian Friedrich\n",
+    FMT_PRINT(ioStream, "\n%s %s, Copyright (C) 2025 Julian Friedrich\n",
             VERSION_PROJECT, VERSION_GIT_SHORT);
-    ioStream.printf("Build:           %s, %s\n", __DATE__, __TIME__);
-    ioStream.printf("Git Repo:        %s\n", VERSION_GIT_REMOTE_ORIGIN);
-    ioStream.printf("Revision:        %s\n", VERSION_GIT_LONG);
-    ioStream.printf("libCli Version:  %s\n", CLI_VERSION);
-    ioStream.printf("\n");
-    ioStream.printf("This program comes with ABSOLUTELY NO WARRANTY. This is free software, \n");
-    ioStream.printf("and you are welcome to redistribute it under certain conditions.\n");
-    ioStream.printf("See GPL v3 licence at https://www.gnu.org/licenses/ for details.\n\n");
+    FMT_PRINT(ioStream, "Build:           %s, %s\n", __DATE__, __TIME__);
+    FMT_PRINT(ioStream, "Git Repo:        %s\n", VERSION_GIT_REMOTE_ORIGIN);
+    FMT_PRINT(ioStream, "Revision:        %s\n", VERSION_GIT_LONG);
+    FMT_PRINT(ioStream, "libCli Version:  %s\n", CLI_VERSION);
+    FMT_PRINT(ioStream, "\n");
+    FMT_PRINT(ioStream, "This program comes with ABSOLUTELY NO WARRANTY. This is free software, \n");
+    FMT_PRINT(ioStream, "and you are welcome to redistribute it under certain conditions.\n");
+    FMT_PRINT(ioStream, "See GPL v3 licence at https://www.gnu.org/licenses/ for details.\n\n");
 
     return 0;
 }
 
+CLI_HELP(ver, "General", "",
+    "Show version information");
+
+/**
+ * @brief The modes of the led command.
+ */
+CMDSCHEMA_ENUM(LedArg, "0", "1", "b");
+
 /**
  * @brief Used to control the on board led
  * @arg   mode  0|1|b
  */
-CLI_COMMAND(led) {
-	if (argc != 1) {
-		return -1;
-	}
-
-	if (*argv[0] == '0') {
-		ledMode = LED_STATIC;
-		digitalWrite(LED_BUILTIN, 0);
-	} else if (*argv[0] == '1') {
-		ledMode = LED_STATIC;
-		digitalWrite(LED_BUILTIN, 1);
-	} else if (*argv[0] == 'b') {
-		ledMode = LED_BLINK;
-	}
+CLI_COMMAND_ARGS(led, LedArg)(Stream &ioStream, uint8_t mode) {
+    if (mode == CMDSCHEMA_OF(LedArg, "b")) {
+        ledMode = LED_BLINK;
+    } else {
+        ledMode = LED_STATIC;
+        digitalWrite(LED_BUILTIN, mode == CMDSCHEMA_OF(LedArg, "1"));
+    }
 
-	return 0;
+    return 0;
 }
 
+CLI_HELP(led, "LED Control", "0|1|b",
+    "Control the LED\n"
+    "  0  turns the LED off\n"
+    "  1  turns the LED on\n"
+    "  b  lets it blink");
+
 /**
  * @brief Turns the LED on.
  * Does the same as "led 1", but is used to test command completion and command 
@@ -145,6 +337,9 @@ CLI_COMMAND(led_on){
     return 0;
 }
 
+CLI_HELP(led_on, "LED Control", "",
+    "Turn the LED on, same as led 1");
+
 /**
  * @brief Turns the LED off.
  * Does the same as "led 0", but is used to test command completion and command
@@ -156,6 +351,9 @@ CLI_COMMAND(led_off){
     return 0;
 }
 
+CLI_HELP(led_off, "LED Control", "",
+    "Turn the LED off, same as led 0");
+
 /**
  * @brief Makes the LED blink.
  * Does the same as "led b", but is used to test command completion and command
@@ -166,26 +364,53 @@ CLI_COMMAND(led_blink){
     return 0;
 }
 
+CLI_HELP(led_blink, "LED Control", "",
+    "Let the LED blink, same as led b");
+
 /**
  * @brief Used to list all registered commands.
  * This command is used to test the command listing functionality and to check 
  * if all commands are properly registered. Can also be used to check completion
- * as it shares the leading l with the led command and its friends.
+ * as it shares the leading l with the led command and its friends. The names 
+ * are printed in as many columns as the terminal width allows.
  */
 CLI_COMMAND(list) {
-    cliCmd_t *pCmdTab = CliCommand::getTable();
-    size_t cmdCnt = CliCommand::getCmdCnt();
+    size_t cmdCnt = CmdIndex::getCnt();
+    size_t colWidth = 0;
+    size_t cols = 0;
 
-    ioStream.printf("Registered Command's:\n");
+    for(size_t i = 0; i < cmdCnt; i++){
+        size_t len = strlen(CmdIndex::at(i)->name) + 2;
+        colWidth = len > colWidth ? len : colWidth;
+    }
+    cols = colWidth > 0 ? (telnetServer.getWidth(ioStream) - 2) / colWidth : 1;
+    cols = cols > 0 ? cols : 1;
+
+    FMT_PRINT(ioStream, "Registered Command's:\n");
 
     for(size_t i = 0; i < cmdCnt; i++){
-        ioStream.printf("  %s\n", pCmdTab[i].name);
+        const char *name = CmdIndex::at(i)->name;
+
+        if (i % cols == 0) {
+            ioStream.print("  ");
+        }
+        ioStream.print(name);
+        if (i % cols == cols - 1 || i == cmdCnt - 1) {
+            ioStream.print("\n");
+        } else {
+            for (size_t n = strlen(name); n < colWidth; n++) {
+                ioStream.write(' ');
+            }
+        }
     }
     ioStream.print("\n");
 
     return 0;
 }
 
+CLI_HELP(list, "General", "",
+    "List all registered commands");
+
 /**
  * @brief Prints infos on lib cli
  */
@@ -194,96 +419,117 @@ CLI_COMMAND(info) {
     telnetServer.info(ioStream);
     #endif
 
-    ioStream.printf("\nLib Cli Infos:\n");
-    ioStream.printf("  libcli Version:              %s\n", CLI_VERSION);
-    ioStream.printf("  CLI_COMMANDSIZ:              %d\n", CLI_COMMANDSIZ);
-    ioStream.printf("  CLI_HISTORYSIZ:              %d\n", CLI_HISTORYSIZ);
-    ioStream.printf("  CLI_ARGVSIZ:                 %d\n", CLI_ARGVSIZ);
-    ioStream.printf("  CLI_PROMPT:                  %s\n", CLI_PROMPT);
-    ioStream.printf("  CLI_BUFFEREDIO:              %d\n", CLI_BUFFEREDIO);
-    ioStream.printf("  CLI_TAB_COMPLETION:          %d\n", CLI_TAB_COMPLETION);
-    ioStream.printf("  CLI_TERMINAL_WIDTH:          %d\n", CLI_TERMINAL_WIDTH);
-    ioStream.printf("  CLI_CMDTAB_SORTING_DEFAULT:  %d\n", CLI_CMDTAB_SORTING_DEFAULT);
-    ioStream.printf("  SERIAL_RX_BUFFER_SIZE:       %d\n", SERIAL_RX_BUFFER_SIZE);
-    ioStream.printf("  Supported commands:          %d\n", CLI_COMMANDS_MAX);
-    ioStream.printf("  Registered commands:         %zu\n", CliCommand::getCmdCnt());
-    ioStream.printf("  Dropped commands:            %zu\n", CliCommand::getDropCnt());
-    ioStream.printf("\n");
-
-    CliCommand::exec(ioStream, "list", nullptr, 0);
+    FMT_PRINT(ioStream, "\nLib Cli Infos:\n");
+    FMT_PRINT(ioStream, "  libcli Version:              %s\n", CLI_VERSION);
+    FMT_PRINT(ioStream, "  CLI_COMMANDSIZ:              %d\n", CLI_COMMANDSIZ);
+    FMT_PRINT(ioStream, "  CLI_HISTORYSIZ:              %d\n", CLI_HISTORYSIZ);
+    FMT_PRINT(ioStream, "  CLI_ARGVSIZ:                 %d\n", CLI_ARGVSIZ);
+    FMT_PRINT(ioStream, "  CLI_PROMPT:                  %s\n", CLI_PROMPT);
+    FMT_PRINT(ioStream, "  CLI_BUFFEREDIO:              %d\n", CLI_BUFFEREDIO);
+    FMT_PRINT(ioStream, "  TXBUFFER_SIZ:                %d\n", TXBUFFER_SIZ);
+    FMT_PRINT(ioStream, "  CLI_CORE:                    %d\n", CLI_CORE);
+    FMT_PRINT(ioStream, "  HISTORY_PERSIST:             %d\n", HISTORY_PERSIST);
+    FMT_PRINT(ioStream, "  HISTORY_COMPACT:             %d\n", HISTORY_COMPACT);
+    FMT_PRINT(ioStream, "  CLI_TAB_COMPLETION:          %d\n", CLI_TAB_COMPLETION);
+    FMT_PRINT(ioStream, "  CLI_TERMINAL_WIDTH:          %d\n", CLI_TERMINAL_WIDTH);
+    FMT_PRINT(ioStream, "  CLI_CMDTAB_SORTING_DEFAULT:  %d\n", CLI_CMDTAB_SORTING_DEFAULT);
+    FMT_PRINT(ioStream, "  SERIAL_RX_BUFFER_SIZE:       %u\n", 
+        (unsigned int) SERIAL_RX_BUFFER_SIZE);
+    FMT_PRINT(ioStream, "  Supported commands:          %d\n", CLI_COMMANDS_MAX);
+    FMT_PRINT(ioStream, "  Registered commands:         %zu\n", CliCommand::getCmdCnt());
+    FMT_PRINT(ioStream, "  Dropped commands:            %zu\n", CliCommand::getDropCnt());
+    FMT_PRINT(ioStream, "\n");
+
+    CmdIndex::exec(ioStream, "list", nullptr, 0);
 
     return 0;
 }
 
+CLI_HELP(info, "General", "",
+    "Show libCli configuration");
+
 /**
  * @brief Used to test errors in a command.
  * @arg   ret return value of the command
  */
-CLI_COMMAND(err) {
-    int16_t val = -1;
-
-    if (argc > 0) {
-        val = strtol(argv[0],0 ,0);
-        ioStream.printf("Got value %d\n", val);
-    }
+CLI_COMMAND_ARGS(err, ArgInt<INT8_MIN, INT8_MAX>)(Stream &ioStream, long val) {
+    FMT_PRINT(ioStream, "Got value %ld\n", val);
 
     return (int8_t) val;
 }
 
+CLI_HELP(err, "Testing/Debug", "<n>",
+    "Test error return codes\n"
+    "Prints n and returns it, n is -128 to 127.");
+
 /**
  * @brief Prints all provided arguments.
  * @arg   [args] Optional list of arguments.
  */
 CLI_COMMAND(args) {
-    ioStream.printf("Recognized arguments:\n");
+    FMT_PRINT(ioStream, "Recognized arguments:\n");
     for(size_t i = 0; i < argc; i++) {
-        ioStream.printf("  argv[%zu]: \"%s\"\n", i, argv[i]);
+        FMT_PRINT(ioStream, "  argv[%zu]: \"%s\"\n", i, argv[i]);
     }
 
     return 0;
 }
 
+CLI_HELP(args, "Testing/Debug", "[...]",
+    "Show argument parsing");
+
+/**
+ * @brief The arguments of the echo command.
+ */
+CMDSCHEMA_ENUM(OnOffArg, "on", "off");
+
 /**
  * @brief Used to change the echo mode of libcli
  * @arg   mode on|off
  */
-CLI_COMMAND(echo) {
-    bool state = true;
-
-    if(argc != 1) {
-        return -1;
-    }
-
-    if(strcmp(argv[0],"on") == 0) {
-        state = true;
-    } else if(strcmp(argv[0],"off") == 0) {
-        state = false;
-    } else{
-        return -2;
-    }
-
-    cli.setEcho(state);
-    ioStream.printf("Echo is now %s\n", argv[0]);
+CLI_COMMAND_ARGS(echo, OnOffArg)(Stream &ioStream, uint8_t mode) {
+    cli.setEcho(mode == CMDSCHEMA_OF(OnOffArg, "on"));
+    FMT_PRINT(ioStream, "Echo is now %s\n", OnOffArg::names[mode]);
 
     return 0;
 }
 
+CLI_HELP(echo, "System", "on|off",
+    "Toggle command echo");
+
 /**
  * @brief Rings the bell in the host terminal.
  */
 CLI_COMMAND(bell) {
     cli.sendBell();
-    ioStream.printf("Sent a bell cmd\n");
+    FMT_PRINT(ioStream, "Sent a bell cmd\n");
 
     return 0;
 }
 
+CLI_HELP(bell, "Testing/Debug", "",
+    "Ring terminal bell");
+
 /**
- * @brief Trigger a CPU reset.
+ * @brief The steps of the reset command, waits 100 ms for the output to get 
+ * out without blocking the main loop.
  */
-CLI_COMMAND(reset) {
-    ioStream.printf("Resetting the CPU ...\n");
-    delay(100);
+int8_t resetJob(Stream &ioStream, uint32_t step, void *pArg) {
+    static uint32_t start = 0;
+
+    if (step == CMDJOB_CANCEL) {
+        return 0;
+    }
+
+    if (step == 0) {
+        FMT_PRINT(ioStream, "Resetting the CPU ...\n");
+        ioStream.flush();
+        start = millis();
+    }
+
+    if (millis() - start < 100) {
+        return CMDJOB_MORE;
+    }
 
     #ifdef ARDUINO_ARCH_STM32
 
@@ -299,56 +545,430 @@ CLI_COMMAND(reset) {
 
     #else
 
-    ioStream.printf("ERROR: reset is not implemented for this platform.\n");
+    FMT_PRINT(ioStream, "ERROR: reset is not implemented for this platform.\n");
 
     #endif
 
     return 0;
 }
 
-CLI_COMMAND(telnet) {
-    if (argc == 3 && strcmp(argv[0], "begin") == 0) {
-        telnetServer.wifiSetup((char*) argv[1], (char*) argv[2]);
-        telnetServer.begin();
+/**
+ * @brief Trigger a CPU reset.
+ */
+CLI_COMMAND(reset) {
+    return CmdJob::start(ioStream, resetJob);
+}
+
+CLI_HELP(reset, "System", "",
+    "Reset CPU");
+
+/**
+ * @brief The sub commands of the telnet command.
+ */
+CMDSCHEMA_ENUM(TelnetArg, "begin", "info");
+
+/**
+ * @brief Used to control the telnet server.
+ * @arg   begin ssid pass  Connects to the WiFi and starts the server.
+ * @arg   info             Prints the state of the server.
+ */
+CLI_COMMAND_ARGS(telnet, TelnetArg, ArgOpt<ArgStr>, ArgOpt<ArgStr>)(
+    Stream &ioStream, uint8_t cmd, const char *pSsid, const char *pPass) {
+
+    if (cmd == CMDSCHEMA_OF(TelnetArg, "begin") && pPass != nullptr) {
+        telnetServer.wifiSetup((char*) pSsid, (char*) pPass);
+        loopMaxUs = 0;
+        telnetServer.begin(ioStream);
         return 0;
     }
 
-    if(argc == 1 && strcmp(argv[0], "info") == 0) {
+    if (cmd == CMDSCHEMA_OF(TelnetArg, "info") && pSsid == nullptr) {
         telnetServer.info(ioStream);
-        ioStream.printf("\n");
+        FMT_PRINT(ioStream, "  Longest loop:  %lu us\n", 
+            (unsigned long) loopMaxUs);
+        FMT_PRINT(ioStream, "\n");
+        return 0;
+    }
+
+    FMT_PRINT(ioStream, "Usage: telnet begin <ssid> <pass> | telnet info\n");
+    return CMDSCHEMA_ERROR;
+}
+
+CLI_HELP(telnet, "Network", "begin <ssid> <pass>|info",
+    "Control the telnet server on supported platforms\n"
+    "  begin  connects to the WiFi and starts the server\n"
+    "  info   shows the server and its sessions");
+
+/**
+ * @brief The time a step of the source command may run lines for, before it
+ * lets the main loop continue.
+ */
+#ifndef SOURCE_STEP_US
+#define SOURCE_STEP_US          5000
+#endif
+
+/**
+ * @brief The script of "source demo".
+ */
+static const char sourceDemo[] =
+    "# Batch demo, runs without echo, prompt and history\n"
+    "led 0\n"
+    "led_blink\n"
+    "args provisioned by source\n"
+    "err 0\n"
+    "dummy\n";
+
+/**
+ * @brief The state of the running "source" command, there is only one at a 
+ * time.
+ */
+static struct {
+    bool active;
+    bool paste;
+    bool keepGoing;
+    CmdBatch batch;
+
+    /**
+     * @brief The text not fed yet, the built-in script or a chunk of the 
+     * file read into buf.
+     */
+    const char *pData;
+    size_t len;
+    char buf[64];
+#ifdef ARDUINO_ARCH_NATIVE
+    FILE *pFile;
+#elif HAS_LITTLEFS_SUPPORT
+    File file;
+#endif
+} source;
+
+/**
+ * @brief Opens the script file.
+ */
+static bool sourceOpen(const char *path) {
+#ifdef ARDUINO_ARCH_NATIVE
+    source.pFile = fopen(path, "rb");
+    return source.pFile != nullptr;
+#elif HAS_LITTLEFS_SUPPORT
+    if (LittleFS.begin()) {
+        source.file = LittleFS.open(path, "r");
+    }
+    return (bool) source.file;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Reads the next chunk of the script file into source.buf.
+ */
+static void sourceRead(void) {
+    size_t n = 0;
+
+#ifdef ARDUINO_ARCH_NATIVE
+    if (source.pFile != nullptr) {
+        n = fread(source.buf, 1, sizeof(source.buf), source.pFile);
+    }
+#elif HAS_LITTLEFS_SUPPORT
+    if (source.file) {
+        n = source.file.read((uint8_t*) source.buf, sizeof(source.buf));
+    }
+#endif
+
+    source.pData = source.buf;
+    source.len = n;
+}
+
+/**
+ * @brief Closes the script file, if any.
+ */
+static void sourceClose(void) {
+#ifdef ARDUINO_ARCH_NATIVE
+    if (source.pFile != nullptr) {
+        fclose(source.pFile);
+        source.pFile = nullptr;
+    }
+#elif HAS_LITTLEFS_SUPPORT
+    source.file.close();
+#endif
+}
+
+/**
+ * @brief Feeds the next piece of the script to the batch.
+ * @return false if no input is available right now.
+ */
+static bool sourceFeed(Stream &ioStream) {
+    if (source.paste) {
+        int c = ioStream.read();
+        char ch = (char) c;
+
+        if (c < 0) {
+            return false;
+        }
+        source.batch.feed(&ch, 1);
+        return true;
+    }
+
+    if (source.len == 0 && source.pData == source.buf) {
+        sourceRead();
+    }
+
+    if (source.len == 0) {
+        source.batch.end();
+    } else {
+        size_t n = source.batch.feed(source.pData, source.len);
+
+        source.pData += n;
+        source.len -= n;
+    }
+
+    return true;
+}
+
+/**
+ * @brief The steps of the source command, runs lines of the script for up to
+ * SOURCE_STEP_US per step.
+ */
+int8_t sourceJob(Stream &ioStream, uint32_t step, void *pArg) {
+    uint32_t start = micros();
+
+    if (step == 0) {
+        source.batch.begin(ioStream, source.keepGoing, 
+            source.paste ? "." : nullptr);
+    }
+
+    if (step == CMDJOB_CANCEL) {
+        source.batch.end();
+    }
+
+    while (!source.batch.isDone() && micros() - start < SOURCE_STEP_US && 
+        sourceFeed(ioStream));
+
+    if (!source.batch.isDone()) {
+        return CMDJOB_MORE;
+    }
+
+    sourceClose();
+    source.batch.summary(ioStream);
+    source.active = false;
+
+    return source.batch.getResult();
+}
+
+/**
+ * @brief Runs a script without echo, prompt and history.
+ * @arg   [-k] Keep going after a failed command.
+ * @arg   src  "paste" to read the script from the console up to a line ".",
+ *             "demo" for the built-in script, else a file name.
+ */
+CLI_COMMAND(source) {
+    bool keepGoing = argc > 0 && strcmp(argv[0], "-k") == 0;
+    const char *pSrc = argc > 0 ? argv[argc - 1] : nullptr;
+
+    if (argc != (keepGoing ? 2u : 1u)) {
+        return -1;
+    }
+
+    if (source.active) {
+        FMT_PRINT(ioStream, "source: busy\n");
+        return -2;
+    }
+
+    source.paste = strcmp(pSrc, "paste") == 0;
+    source.pData = source.buf;
+    source.len = 0;
+
+    if (source.paste && !CmdJob::isConsole(ioStream)) {
+        FMT_PRINT(ioStream, "source: paste needs a console\n");
+        return -4;
+    }
+
+    if (source.paste) {
+        FMT_PRINT(ioStream, "Paste the script, end it by a line \".\"\n");
+    } else if (strcmp(pSrc, "demo") == 0) {
+        source.pData = sourceDemo;
+        source.len = sizeof(sourceDemo) - 1;
+    } else if (!sourceOpen(pSrc)) {
+        FMT_PRINT(ioStream, "Cannot open %s\n", pSrc);
+        return -3;
+    }
+
+    source.active = true;
+    source.keepGoing = keepGoing;
+
+    return CmdJob::start(ioStream, sourceJob, nullptr, source.paste);
+}
+
+CLI_HELP(source, "System", "[-k] paste|demo|<file>",
+    "Run a script from paste, demo or a file\n"
+    "Runs without echo, prompt and history and stops at the first failed\n"
+    "command unless -k is given. A pasted script ends with a line \".\".");
+
+/**
+ * @brief Switches the console into the binary machine mode of CmdRpc, a 
+ * CMDRPC_EXIT request switches back.
+ */
+CLI_COMMAND(rpc) {
+    Stream *pIo = &ioStream;
+
+#if CMDSTATS
+    pIo = &CmdStats::stream(ioStream);
+#endif
+
+    if (argc != 0) {
+        return -1;
+    }
+
+    /* Telnet turns CR NUL into CR, frames only pass the serial console. */
+    if (pIo != &serialJob) {
+        FMT_PRINT(ioStream, "rpc: only on the serial console\n");
+        return -2;
+    }
+
+    serialRpc.begin();
+    return 0;
+}
+
+CLI_HELP(rpc, "System", "",
+    "Switch the serial console to binary mode\n"
+    "See lib/cmdrpc/cmdrpc.hpp for the frame format.");
+
+#if SCHEDULER_STATS
+
+/**
+ * @brief Prints the runtime statistics of the periodic jobs.
+ * @arg   [reset] Clears the statistics.
+ */
+CLI_COMMAND(tasks) {
+    if (argc == 1 && strcmp(argv[0], "reset") == 0) {
+        tasksReset.store(true, std::memory_order_release);
+        return 0;
+    }
+
+    if (argc != 0) {
+        return -1;
+    }
+
+    FMT_PRINT(ioStream, "Next deadline in %lu ms\n", 
+        (unsigned long) scheduler.getNext(millis()));
+    FMT_PRINT(ioStream, "Longest loop %lu us\n\n", (unsigned long) loopMaxUs);
+    FMT_PRINT(ioStream, "  %-8s %6s %8s %7s %7s %7s %5s %8s\n", "Job", 
+        "Period", "Runs", "Last us", "Avg us", "Max us", "Late", "Max late");
+
+    for (size_t i = 0; i < scheduler.getCount(); i++) {
+        const schedStats_t &stats = scheduler.getStats(i);
+        const char *name = scheduler.getName(i);
+
+        FMT_PRINT(ioStream, "  %-8s %6lu %8lu %7lu %7lu %7lu %5lu %8lu\n",
+            name != nullptr ? name : "-", 
+            (unsigned long) scheduler.getPeriod(i), 
+            (unsigned long) stats.runs, (unsigned long) stats.lastUs, 
+            (unsigned long) (stats.runs ? stats.totalUs / stats.runs : 0),
+            (unsigned long) stats.maxUs, (unsigned long) stats.lateMs, 
+            (unsigned long) stats.maxLateMs);
+    }
+
+    FMT_PRINT(ioStream, "\n  %-8s %8s %8s %8s %8s %8s\n", "Job", "<10us", 
+        "<100us", "<1ms", "<10ms", ">=10ms");
+
+    for (size_t i = 0; i < scheduler.getCount(); i++) {
+        const uint32_t *hist = scheduler.getStats(i).hist;
+        const char *name = scheduler.getName(i);
+
+        FMT_PRINT(ioStream, "  %-8s %8lu %8lu %8lu %8lu %8lu\n",
+            name != nullptr ? name : "-", (unsigned long) hist[0], 
+            (unsigned long) hist[1], (unsigned long) hist[2], 
+            (unsigned long) hist[3], (unsigned long) hist[4]);
+    }
+    ioStream.print("\n");
+
+    return 0;
+}
+
+CLI_HELP(tasks, "System", "[reset]",
+    "Show periodic job statistics");
+
+#endif
+
+#if CMDSTATS
+
+/**
+ * @brief Prints the profile of all commands, the most expensive one first.
+ * @arg   [reset] Clears the profile.
+ */
+CLI_COMMAND(cmdstats) {
+    cmdidx_t order[CLI_COMMANDS_MAX];
+    size_t cnt = CmdStats::getCnt();
+
+    if (argc == 1 && strcmp(argv[0], "reset") == 0) {
+        CmdStats::reset();
         return 0;
     }
 
-    return -1;
+    if (argc != 0) {
+        return -1;
+    }
+
+    /* Insertion sort by total cost, descending. */
+    for (size_t i = 0; i < cnt; i++) {
+        size_t j = i;
+
+        while (j > 0 && CmdStats::get(order[j - 1])->total <
+            CmdStats::get(i)->total) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = (cmdidx_t) i;
+    }
+
+    FMT_PRINT(ioStream, "Cost in " CMDSTATS_UNIT "\n\n");
+    FMT_PRINT(ioStream, "  %-14s %6s %11s %9s %9s %8s\n", "Command", "Calls",
+        "Total", "Avg", "Max", "Bytes");
+
+    for (size_t i = 0; i < cnt; i++) {
+        const cmdStats_t *pStats = CmdStats::get(order[i]);
+
+        if (pStats->calls == 0) {
+            continue;
+        }
+
+        FMT_PRINT(ioStream, "  %-14s %6lu %11lu %9lu %9lu %8lu\n", 
+            pStats->name, (unsigned long) pStats->calls, 
+            (unsigned long) pStats->total, 
+            (unsigned long) (pStats->total / pStats->calls),
+            (unsigned long) pStats->max, (unsigned long) pStats->bytes);
+    }
+    ioStream.print("\n");
+
+    return 0;
 }
 
+CLI_HELP(cmdstats, "System", "[reset]",
+    "Show command profile");
+
+#endif
+
 /**
- * @brief Print's the help text.
+ * @brief Prints the help generated from the CLI_HELP() entries, which are kept
+ * in flash next to their commands.
+ * @arg   [cmd] Prints the usage and the full description of a command.
  */
-CLI_COMMAND(help) {
-    ioStream.printf("Available commands:\n");
-    ioStream.printf("  help                         Show this help\n");
-    ioStream.printf("  ver                          Show version information\n");
-    ioStream.printf("  info                         Show libCli configuration\n");
-    ioStream.printf("  list                         List all registered commands\n");
-    ioStream.printf("\nLED Control:\n");
-    ioStream.printf("  led <0|1|b>                  Control LED (0=off, 1=on, b=blink)\n");
-    ioStream.printf("\nNetwork:\n");
-    ioStream.printf("  telnet begin <ssid> <pass>   Start telnet server on supported platforms\n");
-    ioStream.printf("  telnet info                  Show telnet status on supported platforms\n");
-    ioStream.printf("\nSystem:\n");
-    ioStream.printf("  echo <on|off>                Toggle command echo\n");
-    ioStream.printf("  reset                        Reset CPU\n");
-    ioStream.printf("\nTesting/Debug:\n");
-    ioStream.printf("  test <name|all>              Run unit tests\n");
-    ioStream.printf("  args [...]                   Show argument parsing\n");
-    ioStream.printf("  err <n>                      Test error return codes\n");
-    ioStream.printf("  bell                         Ring terminal bell\n");
-    ioStream.printf("\n");
+CLI_COMMAND_ARGS(help, ArgOpt<ArgStr>)(Stream &ioStream, const char *pCmd) {
+    if (pCmd != nullptr) {
+        return CmdHelp::print(ioStream, pCmd);
+    }
+
+    ioStream.print(F("Available commands:\n"));
+    CmdHelp::printAll(ioStream);
+    ioStream.print(F("\nUse 'help <cmd>' for details, filter the output of any command by\n"
+        "'<cmd> | grep [-v] [-i] <text>', '| head [n]', '| tail [n]' or '| count'.\n\n"));
 
     return 0;
 }
 
+CLI_HELP(help, "General", "[cmd]",
+    "Show this help or the details of a command");
+
 /**
  * @brief Dummy commands to check the command listing and command completion 
  * functionality.
@@ -383,6 +1003,16 @@ DUMMY_CMD(dummy_extra_3);
 
 #endif
 
+/**
+ * @brief Attaches the Cli to the serial console.
+ */
+void beginSerialCli(void) {
+#if HAS_REVERSE_SEARCH
+    serialInput.setJob(serialJob);
+#endif
+    cli.begin(&serialJob);
+}
+
 /**
  * @brief Platform-dependent serial initialization handler
  * 
@@ -432,29 +1062,154 @@ void handleSerial(uint32_t now) {
         cmd_ver(Serial, 0, 0);
         Serial.printf(
             "Use the 'help' command to get a list of available commands.\n\n");
-        cli.begin();
+#if CLI_CORE
+        serialBegins.store(serialBegins.load(std::memory_order_relaxed) + 1,
+            std::memory_order_release);
+#else
+        beginSerialCli();
+#endif
         serial_state = initialized;
     }
 
     if (serial_state == initialized) {
+#if CLI_CORE
+        serialLink.pump(Serial);
+#else
         cli.loop();
+#endif
+    }
+}
+
+/**
+ * @brief Reports the end of the WiFi bring-up started by "telnet begin".
+ */
+void telnetReady(bool connected, uint32_t ms) {
+    FMT_PRINT(serialRpc, "Telnet: %s after %lu ms, longest loop %lu us\n",
+        connected ? "ready" : "failed", (unsigned long) ms, 
+        (unsigned long) loopMaxUs);
+}
+
+/**
+ * @brief To blink the led .. wohoo
+ */
+void handleLed(uint32_t now) {
+    if (ledMode == LED_BLINK) {
+        digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    }
+}
+
+#if CLI_CORE
+
+/**
+ * @brief One iteration of the Cli core: the serial console, once it has been
+ * connected, and the telnet server.
+ */
+void cliLoop(void) {
+    static uint32_t begins = 0;
+    uint32_t n = serialBegins.load(std::memory_order_acquire);
+
+    if (n != begins) {
+        begins = n;
+        beginSerialCli();
+    }
+
+    if (begins == 0) {
+        return;
+    }
+
+    cli.loop();
+    telnetServer.loop();
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+/**
+ * @brief The Cli task, waits a tick per iteration so that the idle task of 
+ * its core can feed the watchdog.
+ */
+void cliTask(void *pArg) {
+    for (;;) {
+        cliLoop();
+        vTaskDelay(1);
+    }
+}
+
+#elif defined(ARDUINO_ARCH_RP2040)
+
+/**
+ * @brief Defining setup1() and loop1() starts core1.
+ */
+void setup1() {
+}
+
+void loop1() {
+    cliLoop();
+}
+
+#endif
+
+#endif
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+/**
+ * @brief Keeps the host build running until a resumable command is done and
+ * its output has left the transmit buffer.
+ */
+bool hostBusy(void) {
+#if TXBUFFER_SIZ > 0
+    if (serialOut.pending() > 0) {
+        return true;
     }
+#endif
+    return CmdJob::isAnyBusy();
 }
 
+#endif
+
 void setup() {
+    uint32_t now = millis();
+
     pinMode(LED_BUILTIN, OUTPUT);
-    serialTask.setTaskFunction(handleSerial);
+    CmdPipe::attach();
+#if CMDSTATS
+    CmdStats::attach();
+#endif
+    scheduler.add(handleLed, 250, now, "led");
+    scheduler.add(handleSerial, 10, now, "serial");
+    telnetServer.onReady(telnetReady);
+    telnetServer.setLog(serialRpc);
+#if HAS_REVERSE_SEARCH && HISTORY_PERSIST
+#if HAS_LITTLEFS_SUPPORT
+    LittleFS.begin();
+#endif
+    serialHistory.begin(&historyStore);
+#endif
+#if CLI_CORE && defined(ARDUINO_ARCH_ESP32)
+    xTaskCreatePinnedToCore(cliTask, "cli", CLI_CORE_STACK, nullptr, 1, 
+        nullptr, CLI_CORE_ID);
+#endif
 }
 
 void loop() {
+    uint32_t start = micros();
     uint32_t now = millis();
+    uint32_t us = 0;
 
-    if(ledTask.isScheduled(now)) {
-        if (ledMode == LED_BLINK) {
-            digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
-        }
+#if SCHEDULER_STATS
+    if (tasksReset.exchange(false, std::memory_order_acquire)) {
+        scheduler.resetStats();
+        loopMaxUs = 0;
     }
+#endif
 
-    serialTask.loop(now);
+    scheduler.loop(now);
+#if !CLI_CORE
     telnetServer.loop();
+#endif
+
+    us = micros() - start;
+    if (us > loopMaxUs) {
+        loopMaxUs = us;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,145 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdbatch.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Feeds a whole script in pieces of the given size.
+ */
+static void feedAll(CmdBatch &batch, const char *script, size_t piece) {
+     size_t len = strlen(script);
+
+     while (len > 0 && !batch.isDone()) {
+          size_t n = batch.feed(script, len < piece ? len : piece);
+
+          script += n;
+          len -= n;
+     }
+     batch.end();
+}
+
+/**
+ * @brief Tests the batch execution of scripts.
+ */
+UNITTEST_DECL(cmdbatch) {
+     TestStream io;
+     bool ok = true;
+
+     FMT_PRINT(ioStream, "\n[1] Lines, comments and line ends\n");
+     {
+          CmdBatch batch(io);
+
+          feedAll(batch, "err 0\r\n\n# comment\n  \nargs a  b\rerr 0", 100);
+          TEST_ASSERT_TRUE(batch.isDone());
+          TEST_ASSERT_EQUAL_INT(6, batch.getLines());
+          TEST_ASSERT_EQUAL_INT(3, batch.getCommands());
+          TEST_ASSERT_EQUAL_INT(0, batch.getFailed());
+          TEST_ASSERT_EQUAL_INT(0, batch.getResult());
+          TEST_ASSERT_EQUAL_STRING("Got value 0\nRecognized arguments:\n"
+               "  argv[0]: \"a\"\n  argv[1]: \"b\"\nGot value 0\n", 
+               io.output());
+     }
+
+     FMT_PRINT(ioStream, "[2] Any piece size gives the same result\n");
+     for (size_t piece = 1; piece < 8; piece++) {
+          CmdBatch batch(io);
+
+          io.clearOutput();
+          feedAll(batch, "err 0\r\n\n# comment\n  \nargs a  b\rerr 0", piece);
+          ok &= batch.getLines() == 6 && batch.getCommands() == 3;
+     }
+     TEST_ASSERT("pieces of 1..7 bytes", ok);
+
+     FMT_PRINT(ioStream, "[3] feed() stops after a line\n");
+     {
+          CmdBatch batch(io);
+
+          TEST_ASSERT_EQUAL_INT(6, batch.feed("err 0\nerr 0\n", 12));
+          TEST_ASSERT_EQUAL_INT(1, batch.getLines());
+     }
+
+     FMT_PRINT(ioStream, "[4] Stop on the first error\n");
+     {
+          CmdBatch batch(io);
+
+          io.clearOutput();
+          feedAll(batch, "err 0\nerr 3\nerr 0\n", 100);
+          TEST_ASSERT_EQUAL_INT(2, batch.getLines());
+          TEST_ASSERT_EQUAL_INT(1, batch.getFailed());
+          TEST_ASSERT_EQUAL_INT(3, batch.getResult());
+          TEST_ASSERT_EQUAL_STRING("Got value 0\nGot value 3\n"
+               "Line 2: Error: 3\n", io.output());
+     }
+
+     FMT_PRINT(ioStream, "[5] Keep going\n");
+     {
+          CmdBatch batch(io, true);
+
+          feedAll(batch, "err 0\nerr 3\nnosuchcmd\nerr 0\n", 100);
+          TEST_ASSERT_EQUAL_INT(4, batch.getLines());
+          TEST_ASSERT_EQUAL_INT(4, batch.getCommands());
+          TEST_ASSERT_EQUAL_INT(2, batch.getFailed());
+          TEST_ASSERT_EQUAL_INT(3, batch.getResult());
+     }
+
+     FMT_PRINT(ioStream, "[6] End mark, lines after an error are skipped\n");
+     {
+          CmdBatch batch(io, false, ".");
+
+          io.clearOutput();
+          TEST_ASSERT_EQUAL_INT(6, batch.feed("err 3\n", 6));
+          TEST_ASSERT_FALSE(batch.isDone());
+          batch.feed("err 4\n", 6);
+          TEST_ASSERT_FALSE(batch.isDone());
+          batch.feed(".\n", 2);
+          TEST_ASSERT_TRUE(batch.isDone());
+          TEST_ASSERT_EQUAL_INT(0, batch.feed("err 5\n", 6));
+          TEST_ASSERT_EQUAL_INT(2, batch.getLines());
+          TEST_ASSERT_EQUAL_INT(1, batch.getCommands());
+          TEST_ASSERT_EQUAL_STRING("Got value 3\nLine 1: Error: 3\n", 
+               io.output());
+     }
+
+     FMT_PRINT(ioStream, "[7] Bad lines\n");
+     {
+          CmdBatch batch(io);
+          char longLine[CLI_COMMANDSIZ + 8];
+
+          memset(longLine, 'x', sizeof(longLine) - 2);
+          longLine[sizeof(longLine) - 2] = '\n';
+          longLine[sizeof(longLine) - 1] = '\0';
+          feedAll(batch, longLine, 100);
+          TEST_ASSERT_EQUAL_INT(0, batch.getCommands());
+          TEST_ASSERT_EQUAL_INT(1, batch.getFailed());
+     }
+     {
+          CmdBatch batch(io);
+
+          feedAll(batch, "args 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16\n", 100);
+          TEST_ASSERT_EQUAL_INT(0, batch.getCommands());
+          TEST_ASSERT_EQUAL_INT(1, batch.getFailed());
+     }
+}
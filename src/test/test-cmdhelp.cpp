@@ -0,0 +1,121 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdhelp.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Help for a command which is not registered, it must not be listed.
+ */
+CLI_HELP(nohelp_unregistered, "Unregistered", "",
+    "Never listed");
+
+/**
+ * @brief A Print which keeps the end of the output only, the overview is 
+ * longer than the buffer of TestStream.
+ */
+class TailPrint : public Print {
+    public:
+        TailPrint() : len(0), lines(0) {
+            tail[0] = '\0';
+        }
+
+        size_t write(uint8_t c) override {
+            if (len + 1 >= sizeof(tail)) {
+                memmove(tail, tail + 1, --len);
+            }
+            tail[len++] = (char) c;
+            tail[len] = '\0';
+            lines += c == '\n';
+            return 1;
+        }
+
+        using Print::write;
+
+        char tail[64];
+        size_t len;
+        uint32_t lines;
+};
+
+/**
+ * @brief Tests the help generated from the CLI_HELP() entries.
+ */
+UNITTEST_DECL(cmdhelp) {
+     TestStream io;
+     TailPrint tail;
+     int8_t ret = 0;
+
+     FMT_PRINT(ioStream, "\n[1] Lookup\n");
+     TEST_ASSERT_NOT_NULL(CmdHelp::find("led"));
+     TEST_ASSERT_NOT_NULL(CmdHelp::find("help"));
+     TEST_ASSERT_NULL(CmdHelp::find("le"));
+     TEST_ASSERT_NULL(CmdHelp::find("dummy"));
+
+     FMT_PRINT(ioStream, "\n[2] Details\n");
+     ret = CmdHelp::print(io, "led");
+     TEST_ASSERT_EQUAL_INT(0, ret);
+     TEST_ASSERT_EQUAL_STRING("Usage: led 0|1|b\nControl the LED\n"
+          "  0  turns the LED off\n  1  turns the LED on\n"
+          "  b  lets it blink\n", io.output());
+     io.clearOutput();
+     ret = CmdHelp::print(io, "reset");
+     TEST_ASSERT_EQUAL_INT(0, ret);
+     TEST_ASSERT_EQUAL_STRING("Usage: reset\nReset CPU\n", io.output());
+
+     FMT_PRINT(ioStream, "\n[3] Errors\n");
+     io.clearOutput();
+     ret = CmdHelp::print(io, "nope");
+     TEST_ASSERT_EQUAL_INT(-1, ret);
+     TEST_ASSERT_EQUAL_STRING("help: unknown command nope\n", io.output());
+     io.clearOutput();
+     ret = CmdHelp::print(io, "dummy");
+     TEST_ASSERT_EQUAL_INT(-2, ret);
+     TEST_ASSERT_EQUAL_STRING("help: no help for dummy\n", io.output());
+     io.clearOutput();
+     ret = CmdHelp::print(io, "nohelp_unregistered");
+     TEST_ASSERT_EQUAL_INT(-1, ret);
+
+     FMT_PRINT(ioStream, "\n[4] Overview\n");
+     io.clearOutput();
+     CmdHelp::printAll(io);
+     TEST_ASSERT("Starts with a group", 
+          strncmp(io.output(), "\nGeneral:\n  help ", 17) == 0);
+     TEST_ASSERT("First line of the text only", 
+          strstr(io.output(), "  led 0|1|b                    Control the LED\n"
+               "  led_blink ") != nullptr);
+     TEST_ASSERT("Groups sorted by name",
+          strstr(io.output(), "\nLED Control:\n") != nullptr &&
+          strstr(io.output(), "\nGeneral:\n") < 
+               strstr(io.output(), "\nLED Control:\n"));
+     CmdHelp::printAll(tail);
+     TEST_ASSERT("Unregistered help not listed", 
+          strstr(io.output(), "Unregistered") == nullptr &&
+          strstr(tail.tail, "Unregistered") == nullptr);
+     TEST_ASSERT("Counts commands without help",
+          strstr(tail.tail, "more commands without help, see 'list'.\n") 
+               != nullptr);
+     TEST_ASSERT("One line per command", 
+          tail.lines > 10 && tail.lines < CliCommand::getCmdCnt() + 20);
+}
@@ -0,0 +1,123 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdindex.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Tests the sorted command index used for dispatch.
+ */
+UNITTEST_DECL(cmdindex) {
+     cliCmd_t *pTab = CliCommand::getTable();
+     size_t cmdCnt = CliCommand::getCmdCnt();
+     bool ok = true;
+
+     FMT_PRINT(ioStream, "\n[1] Index covers the command table\n");
+     TEST_ASSERT("getCnt() == CliCommand::getCmdCnt()",
+          CmdIndex::getCnt() == cmdCnt);
+     for (size_t i = 1; i < CmdIndex::getCnt(); i++) {
+          ok &= strcmp(CmdIndex::at(i - 1)->name, CmdIndex::at(i)->name) < 0;
+     }
+     TEST_ASSERT("at() returns names in ascending order", ok);
+     TEST_ASSERT("at(getCnt()) -> nullptr",
+          CmdIndex::at(CmdIndex::getCnt()) == nullptr);
+
+     FMT_PRINT(ioStream, "[2] find() every registered command\n");
+     ok = true;
+     for (size_t i = 0; i < cmdCnt; i++) {
+          ok &= CmdIndex::find(pTab[i].name) == &pTab[i];
+     }
+     TEST_ASSERT("find(name) returns its own table entry", ok);
+     TEST_ASSERT("find(\"led\") -> led",
+          CmdIndex::find("led") != nullptr && 
+          strcmp(CmdIndex::find("led")->name, "led") == 0);
+     TEST_ASSERT("find(\"led_on\") -> led_on",
+          CmdIndex::find("led_on") != nullptr && 
+          strcmp(CmdIndex::find("led_on")->name, "led_on") == 0);
+
+     FMT_PRINT(ioStream, "[3] find() unknown commands\n");
+     TEST_ASSERT_NULL(CmdIndex::find("nosuchcmd"));
+     TEST_ASSERT_NULL(CmdIndex::find("led_o"));
+     TEST_ASSERT_NULL(CmdIndex::find("led_blinkx"));
+     TEST_ASSERT_NULL(CmdIndex::find(""));
+     TEST_ASSERT_NULL(CmdIndex::find(nullptr));
+     TEST_ASSERT_NULL(CmdIndex::find("LED"));
+
+     FMT_PRINT(ioStream, "[4] exec() passes arguments and return value\n");
+     const char *args[] = {"7"};
+     TEST_ASSERT("exec(\"err\", {\"7\"}) -> 7",
+          CmdIndex::exec(ioStream, "err", args, 1) == 7);
+     TEST_ASSERT("exec(\"nosuchcmd\") -> -1",
+          CmdIndex::exec(ioStream, "nosuchcmd", nullptr, 0) == -1);
+
+     FMT_PRINT(ioStream, "[5] prefixRange() matches a linear scan\n");
+     ok = true;
+     for (size_t i = 0; i < cmdCnt; i++) {
+          const char *name = pTab[i].name;
+
+          for (size_t len = 0; len <= strlen(name); len++) {
+               size_t first = 0;
+               size_t linear = 0;
+               size_t n = CmdIndex::prefixRange(name, len, &first);
+
+               for (size_t j = 0; j < cmdCnt; j++) {
+                    linear += strncmp(pTab[j].name, name, len) == 0;
+               }
+               ok &= n == linear;
+               ok &= strncmp(CmdIndex::at(first)->name, name, len) == 0;
+               ok &= strncmp(CmdIndex::at(first + n - 1)->name, name, len) == 0;
+          }
+     }
+     TEST_ASSERT("all prefixes of all commands", ok);
+     TEST_ASSERT("prefixRange(\"\") -> all commands",
+          CmdIndex::prefixRange("", 0, nullptr) == cmdCnt);
+     TEST_ASSERT("prefixRange(nullptr) -> all commands",
+          CmdIndex::prefixRange(nullptr, 5, nullptr) == cmdCnt);
+     TEST_ASSERT("prefixRange(\"led\") -> 4",
+          CmdIndex::prefixRange("led", 3, nullptr) == 4);
+     TEST_ASSERT("prefixRange(\"led_\") -> 3",
+          CmdIndex::prefixRange("led_", 4, nullptr) == 3);
+     TEST_ASSERT("prefixRange(\"dummy_long_\") -> 4",
+          CmdIndex::prefixRange("dummy_long_", 11, nullptr) == 4);
+     TEST_ASSERT("prefixRange(\"zz\") -> 0",
+          CmdIndex::prefixRange("zz", 2, nullptr) == 0);
+     TEST_ASSERT("prefixRange(\"ledx\", 3) only uses len chars -> 4",
+          CmdIndex::prefixRange("ledx", 3, nullptr) == 4);
+
+     FMT_PRINT(ioStream, "[6] commonPrefix() for tab completion\n");
+     size_t cnt = 0;
+     TEST_ASSERT("commonPrefix(\"le\") -> 3 (\"led\"), 4 candidates",
+          CmdIndex::commonPrefix("le", 2, &cnt) == 3 && cnt == 4);
+     TEST_ASSERT("commonPrefix(\"led_\") -> 4, 3 candidates",
+          CmdIndex::commonPrefix("led_", 4, &cnt) == 4 && cnt == 3);
+     TEST_ASSERT("commonPrefix(\"led_b\") -> 9 (\"led_blink\"), 1 candidate",
+          CmdIndex::commonPrefix("led_b", 5, &cnt) == 9 && cnt == 1);
+     TEST_ASSERT("commonPrefix(\"dummy_l\") -> 11 (\"dummy_long_\")",
+          CmdIndex::commonPrefix("dummy_l", 7, &cnt) == 11 && cnt == 4);
+     TEST_ASSERT("commonPrefix(\"ver\") -> 3, complete already",
+          CmdIndex::commonPrefix("ver", 3, &cnt) == 3 && cnt == 1);
+     TEST_ASSERT("commonPrefix(\"zz\") -> 0, no candidate",
+          CmdIndex::commonPrefix("zz", 2, &cnt) == 0 && cnt == 0);
+}
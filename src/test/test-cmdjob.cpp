@@ -0,0 +1,279 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdjob.hpp"
+#include "scheduler.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief State of the test job.
+ */
+typedef struct {
+     uint32_t steps;
+     uint32_t cancels;
+     int8_t result;
+
+     /**
+      * @brief The simulated clock and the time each step takes.
+      */
+     uint32_t now;
+     uint32_t stepMs;
+} testJob_t;
+
+/**
+ * @brief Prints its step number, done after the configured number of steps.
+ */
+static int8_t testJob(Stream &ioStream, uint32_t step, void *pArg) {
+     testJob_t *pJob = (testJob_t*) pArg;
+
+     if (step == CMDJOB_CANCEL) {
+          pJob->cancels++;
+          return 0;
+     }
+
+     pJob->now += pJob->stepMs;
+     ioStream.print((char) ('0' + step % 10));
+
+     return step + 1 < pJob->steps ? CMDJOB_MORE : pJob->result;
+}
+
+/**
+ * @brief State of the test job reading its input.
+ */
+typedef struct {
+     char text[16];
+     size_t len;
+     uint32_t cancels;
+} testReader_t;
+
+/**
+ * @brief Reads a key per step, done after a '.'.
+ */
+static int8_t testReader(Stream &ioStream, uint32_t step, void *pArg) {
+     testReader_t *pReader = (testReader_t*) pArg;
+     int c = -1;
+
+     if (step == CMDJOB_CANCEL) {
+          pReader->cancels++;
+          return 0;
+     }
+
+     c = ioStream.read();
+     if (c >= 0 && pReader->len + 1 < sizeof(pReader->text)) {
+          pReader->text[pReader->len++] = (char) c;
+          pReader->text[pReader->len] = '\0';
+     }
+
+     return c == '.' ? 0 : CMDJOB_MORE;
+}
+
+/**
+ * @brief Counts the runs of the periodic job.
+ */
+static uint32_t ledRuns = 0;
+
+static void testLed(uint32_t now) {
+     ledRuns++;
+}
+
+/**
+ * @brief Tests resumable commands.
+ */
+UNITTEST_DECL(cmdjob) {
+     testJob_t job = {5, 0, 0, 0, 0};
+     TestStream io;
+     CmdJob cmdJob(io);
+     int n = 0;
+
+     FMT_PRINT(ioStream, "\n[1] Without a CmdJob the job runs to completion\n");
+     job.result = 7;
+     TEST_ASSERT_EQUAL_INT(7, CmdJob::start(io, testJob, &job));
+     TEST_ASSERT_EQUAL_STRING("01234", io.output());
+     TEST_ASSERT_FALSE(CmdJob::isConsole(io));
+     TEST_ASSERT_TRUE(CmdJob::isConsole(cmdJob));
+
+     FMT_PRINT(ioStream, "[2] One step per available()\n");
+     io.setScript("x");
+     job.result = 0;
+     TEST_ASSERT_EQUAL_INT(0, CmdJob::start(cmdJob, testJob, &job));
+     TEST_ASSERT_TRUE(cmdJob.isBusy());
+     TEST_ASSERT_TRUE(CmdJob::isAnyBusy());
+     TEST_ASSERT_EQUAL_STRING("0", io.output());
+     TEST_ASSERT_EQUAL_INT(-1, cmdJob.read());
+     TEST_ASSERT_EQUAL_INT(-1, cmdJob.peek());
+     cmdJob.print("$ ");
+     TEST_ASSERT_EQUAL_INT(0, cmdJob.available());
+     TEST_ASSERT_EQUAL_STRING("01", io.output());
+     while (cmdJob.isBusy() && n++ < 10) {
+          cmdJob.available();
+     }
+     TEST_ASSERT_EQUAL_STRING("01234$ ", io.output());
+     TEST_ASSERT_FALSE(cmdJob.isBusy());
+     TEST_ASSERT_EQUAL_INT('x', cmdJob.read());
+
+     FMT_PRINT(ioStream, "[3] A failing job reports its result\n");
+     io.setScript("");
+     job.result = 3;
+     CmdJob::start(cmdJob, testJob, &job);
+     while (cmdJob.isBusy() && n++ < 20) {
+          cmdJob.available();
+     }
+     TEST_ASSERT_EQUAL_STRING("01234Error: 3\n", io.output());
+
+     FMT_PRINT(ioStream, "[4] Ctrl-C cancels\n");
+     io.setScript("\x03y");
+     job.result = 0;
+     CmdJob::start(cmdJob, testJob, &job);
+     cmdJob.print("$ ");
+     TEST_ASSERT_EQUAL_INT(1, cmdJob.available());
+     TEST_ASSERT_EQUAL_STRING("0^C\n$ ", io.output());
+     TEST_ASSERT_EQUAL_INT(1, job.cancels);
+     TEST_ASSERT_FALSE(cmdJob.isBusy());
+     TEST_ASSERT_EQUAL_INT('y', cmdJob.read());
+
+     FMT_PRINT(ioStream, "[5] Ctrl-C after other keys cancels\n");
+     io.setScript("x\x03");
+     CmdJob::start(cmdJob, testJob, &job);
+     TEST_ASSERT_EQUAL_INT(0, cmdJob.available());
+     TEST_ASSERT_EQUAL_INT(2, job.cancels);
+     TEST_ASSERT_FALSE(cmdJob.isBusy());
+     TEST_ASSERT_EQUAL_STRING("0^C\n", io.output());
+     TEST_ASSERT_EQUAL_INT(-1, cmdJob.read());
+
+     FMT_PRINT(ioStream, "[6] Keys typed during a job are kept\n");
+     io.setScript("ab");
+     job.steps = 3;
+     CmdJob::start(cmdJob, testJob, &job);
+     TEST_ASSERT_EQUAL_INT(0, cmdJob.available());
+     TEST_ASSERT_TRUE(cmdJob.isBusy());
+     TEST_ASSERT_EQUAL_INT(2, cmdJob.available());
+     TEST_ASSERT_FALSE(cmdJob.isBusy());
+     TEST_ASSERT_EQUAL_INT('a', cmdJob.peek());
+     TEST_ASSERT_EQUAL_INT('a', cmdJob.read());
+     TEST_ASSERT_EQUAL_INT('b', cmdJob.read());
+     TEST_ASSERT_EQUAL_INT(-1, cmdJob.read());
+
+     FMT_PRINT(ioStream, "[7] Input beyond the buffer is not lost\n");
+     static const char longInput[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+     char got[sizeof(longInput)];
+     size_t len = 0;
+     io.setScript(longInput);
+     CmdJob::start(cmdJob, testJob, &job);
+     while (cmdJob.isBusy() && n++ < 100) {
+          cmdJob.available();
+     }
+     while (cmdJob.available() > 0 && len + 1 < sizeof(got)) {
+          got[len++] = (char) cmdJob.read();
+     }
+     got[len] = '\0';
+     TEST_ASSERT_EQUAL_STRING(longInput, got);
+     job.steps = 5;
+
+     FMT_PRINT(ioStream, "[8] setStream() cancels\n");
+     CmdJob::start(cmdJob, testJob, &job);
+     cmdJob.setStream(io);
+     TEST_ASSERT_EQUAL_INT(3, job.cancels);
+     TEST_ASSERT_FALSE(cmdJob.isBusy());
+
+     FMT_PRINT(ioStream, "[9] A job reading its input gets all of it\n");
+     testReader_t reader = {"", 0, 0};
+     io.setScript("ab.x");
+     CmdJob::start(cmdJob, testReader, &reader, true);
+     cmdJob.print("$ ");
+     TEST_ASSERT_EQUAL_INT(0, cmdJob.available());
+     TEST_ASSERT_TRUE(cmdJob.isBusy());
+     TEST_ASSERT_EQUAL_STRING("", io.output());
+     TEST_ASSERT_EQUAL_INT(1, cmdJob.available());
+     TEST_ASSERT_FALSE(cmdJob.isBusy());
+     TEST_ASSERT_EQUAL_STRING("ab.", reader.text);
+     TEST_ASSERT_EQUAL_STRING("$ ", io.output());
+     TEST_ASSERT_EQUAL_INT('x', cmdJob.read());
+
+     FMT_PRINT(ioStream, "[10] Ctrl-C cancels a job reading its input\n");
+     reader.len = 0;
+     reader.text[0] = '\0';
+     io.setScript("a\x03y.");
+     CmdJob::start(cmdJob, testReader, &reader, true);
+     n = 0;
+     while (cmdJob.isBusy() && n++ < 10) {
+          cmdJob.available();
+     }
+     TEST_ASSERT_EQUAL_STRING("a", reader.text);
+     TEST_ASSERT_EQUAL_INT(1, reader.cancels);
+     TEST_ASSERT_EQUAL_STRING("^C\n", io.output());
+     TEST_ASSERT_EQUAL_INT('y', cmdJob.read());
+
+     FMT_PRINT(ioStream, "[11] A job reading its input needs a CmdJob\n");
+     io.setScript("ab.");
+     TEST_ASSERT_EQUAL_INT(CMDJOB_NOCONSOLE, 
+          CmdJob::start(io, testReader, &reader, true));
+     TEST_ASSERT_EQUAL_INT(3, io.available());
+
+     FMT_PRINT(ioStream, "[12] A periodic job keeps its period\n");
+     Scheduler<1> scheduler;
+     Scheduler<1> oneShot;
+     job.steps = 40;
+     job.stepMs = 3;
+     job.now = 0;
+     ledRuns = 0;
+     scheduler.add(testLed, 10, job.now);
+     CmdJob::start(cmdJob, testJob, &job);
+     while (cmdJob.isBusy()) {
+          scheduler.loop(job.now);
+          cmdJob.available();
+     }
+     scheduler.loop(job.now);
+#if SCHEDULER_STATS
+     TEST_ASSERT("resumable: late by one step at most",
+          scheduler.getStats(0).maxLateMs <= job.stepMs);
+#endif
+     TEST_ASSERT_EQUAL_INT(job.now / 10, ledRuns);
+
+     job.now = 0;
+     ledRuns = 0;
+     oneShot.add(testLed, 10, job.now);
+     oneShot.loop(job.now);
+     CmdJob::start(io, testJob, &job);
+     oneShot.loop(job.now);
+#if SCHEDULER_STATS
+     TEST_ASSERT("one-shot: late by the whole job",
+          oneShot.getStats(0).maxLateMs >= job.now - 10 - job.stepMs);
+#endif
+     TEST_ASSERT_EQUAL_INT(1, ledRuns);
+
+     FMT_PRINT(ioStream, "[13] abort() drops the held output and keys\n");
+     io.setScript("ab");
+     job.steps = 5;
+     job.stepMs = 0;
+     job.cancels = 0;
+     CmdJob::start(cmdJob, testJob, &job);
+     cmdJob.print("$ ");
+     TEST_ASSERT_EQUAL_INT(0, cmdJob.available());
+     cmdJob.abort();
+     TEST_ASSERT_EQUAL_INT(1, job.cancels);
+     TEST_ASSERT_FALSE(cmdJob.isBusy());
+     TEST_ASSERT_EQUAL_STRING("01", io.output());
+     TEST_ASSERT_EQUAL_INT(-1, cmdJob.read());
+}
@@ -0,0 +1,160 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdindex.hpp"
+#include "cmdpipe.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Output of a command as used by the filter tests.
+ */
+static const char pipeText[] = 
+     "alpha one\n"
+     "Beta two\n"
+     "gamma three\n"
+     "delta four\n"
+     "epsilon";
+
+/**
+ * @brief Runs pipeText through a single filter and returns the result.
+ */
+static const char* filterText(TestStream &io, const char *text, 
+     size_t argc, const char *argv[], bool *pOk = nullptr) {
+
+     CmdFilter filter;
+     bool ok = filter.begin(io, argc, argv);
+
+     io.clearOutput();
+     if (pOk != nullptr) {
+          *pOk = ok;
+     }
+     if (ok) {
+          filter.print(text);
+          filter.end();
+     }
+
+     return io.output();
+}
+
+/**
+ * @brief Tests the output filters and the pipe operator.
+ */
+UNITTEST_DECL(cmdpipe) {
+     TestStream io;
+     char text[400];
+     bool ok = true;
+
+     FMT_PRINT(ioStream, "\n[1] grep\n");
+     const char *grepA[] = {"grep", "a two"};
+     TEST_ASSERT_EQUAL_STRING("Beta two\n", 
+          filterText(io, pipeText, 2, grepA));
+     const char *grepV[] = {"grep", "-v", "t"};
+     TEST_ASSERT_EQUAL_STRING("alpha one\nepsilon\n", 
+          filterText(io, pipeText, 3, grepV));
+     const char *grepI[] = {"grep", "-i", "BETA"};
+     TEST_ASSERT_EQUAL_STRING("Beta two\n", 
+          filterText(io, pipeText, 3, grepI));
+     const char *grepCase[] = {"grep", "BETA"};
+     TEST_ASSERT_EQUAL_STRING("", filterText(io, pipeText, 2, grepCase));
+     const char *grepLast[] = {"grep", "eps"};
+     TEST_ASSERT_EQUAL_STRING("epsilon\n", 
+          filterText(io, pipeText, 2, grepLast));
+
+     FMT_PRINT(ioStream, "[2] head, tail and count\n");
+     const char *head2[] = {"head", "2"};
+     TEST_ASSERT_EQUAL_STRING("alpha one\nBeta two\n", 
+          filterText(io, pipeText, 2, head2));
+     const char *head[] = {"head"};
+     TEST_ASSERT_EQUAL_INT(sizeof(pipeText), 
+          strlen(filterText(io, pipeText, 1, head)));
+     const char *tail2[] = {"tail", "2"};
+     TEST_ASSERT_EQUAL_STRING("delta four\nepsilon\n", 
+          filterText(io, pipeText, 2, tail2));
+     const char *count[] = {"count"};
+     TEST_ASSERT_EQUAL_STRING("5\n", filterText(io, pipeText, 1, count));
+     TEST_ASSERT_EQUAL_STRING("0\n", filterText(io, "", 1, count));
+
+     FMT_PRINT(ioStream, "[3] Bad filters\n");
+     const char *bad1[] = {"wc"};
+     const char *bad2[] = {"grep"};
+     const char *bad3[] = {"grep", "-x", "a"};
+     const char *bad4[] = {"head", "0"};
+     const char *bad5[] = {"tail", "3x"};
+     const char *bad6[] = {"count", "1"};
+     filterText(io, pipeText, 1, bad1, &ok);
+     TEST_ASSERT("wc", !ok);
+     filterText(io, pipeText, 1, bad2, &ok);
+     TEST_ASSERT("grep without pattern", !ok);
+     filterText(io, pipeText, 3, bad3, &ok);
+     TEST_ASSERT("grep -x", !ok);
+     filterText(io, pipeText, 2, bad4, &ok);
+     TEST_ASSERT("head 0", !ok);
+     filterText(io, pipeText, 2, bad5, &ok);
+     TEST_ASSERT("tail 3x", !ok);
+     filterText(io, pipeText, 2, bad6, &ok);
+     TEST_ASSERT("count 1", !ok);
+
+     FMT_PRINT(ioStream, "[4] Long lines and a full tail ring\n");
+     memset(text, 'x', 2 * CMDPIPE_LINESIZ);
+     strcpy(&text[2 * CMDPIPE_LINESIZ], "match\nshort\n");
+     const char *grepX[] = {"grep", "xx"};
+     TEST_ASSERT_EQUAL_INT(2 * CMDPIPE_LINESIZ + 6, 
+          strlen(filterText(io, text, 2, grepX)));
+     const char *grepM[] = {"grep", "match"};
+     TEST_ASSERT_EQUAL_STRING("", filterText(io, text, 2, grepM));
+     const char *tail1[] = {"tail", "1"};
+     TEST_ASSERT_EQUAL_STRING("short\n", filterText(io, text, 2, tail1));
+     
+     text[0] = '\0';
+     for (int i = 0; i < 40; i++) {
+          snprintf(&text[strlen(text)], 10, "line %02d\n", i);
+     }
+     const char *tail40[] = {"tail", "40"};
+     filterText(io, text, 2, tail40);
+     TEST_ASSERT("tail keeps the last lines which fit", 
+          io.outputLength() <= CMDPIPE_TAILSIZ && 
+          strcmp(io.output() + io.outputLength() - 8, "line 39\n") == 0 &&
+          strncmp(io.output(), "line ", 5) == 0);
+
+     FMT_PRINT(ioStream, "[5] The pipe operator\n");
+     const char *args1[] = {"3", "|", "count"};
+     io.clearOutput();
+     TEST_ASSERT_EQUAL_INT(3, CmdIndex::exec(io, "err", args1, 3));
+     TEST_ASSERT_EQUAL_STRING("1\n", io.output());
+     const char *args2[] = {"a", "b", "|", "grep", "argv", "|", "count"};
+     io.clearOutput();
+     TEST_ASSERT_EQUAL_INT(0, CmdIndex::exec(io, "args", args2, 7));
+     TEST_ASSERT_EQUAL_STRING("2\n", io.output());
+     const char *args3[] = {"a", "|", "head", "1"};
+     io.clearOutput();
+     CmdIndex::exec(io, "args", args3, 4);
+     TEST_ASSERT_EQUAL_STRING("Recognized arguments:\n", io.output());
+     const char *args4[] = {"a", "|", "nosuch"};
+     TEST_ASSERT_EQUAL_INT(-1, CmdIndex::exec(io, "args", args4, 3));
+     const char *args5[] = {"|", "count", "|", "count", "|", "count"};
+     TEST_ASSERT("more than CMDPIPE_STAGES filters", 
+          CmdIndex::exec(io, "args", args5, 6) == -1 || 
+          CMDPIPE_STAGES >= 3);
+}
@@ -0,0 +1,322 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdindex.hpp"
+#include "cmdrpc.hpp"
+#include "cmdtoken.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief The host side of the tests, a Stream which feeds requests to its 
+ * reader, decodes the frames written to it and keeps the output and the 
+ * result of the last request.
+ */
+class RpcHost : public Stream {
+    public:
+        RpcHost() : pReq(nullptr), reqLen(0), reqPos(0) {
+            clear();
+        }
+
+        /**
+         * @brief Sets the requests to send and clears the results.
+         */
+        void send(const uint8_t *req, size_t len) {
+            pReq = req;
+            reqLen = len;
+            reqPos = 0;
+            clear();
+        }
+
+        void clear() {
+            rxLen = 0;
+            textLen = 0;
+            text[0] = '\0';
+            outputFrames = 0;
+            badFrames = 0;
+            lastType = 0;
+            lastSeq = 0;
+            lastValue = 0;
+            delimiters = 0;
+        }
+
+        int available() override { 
+            return (int)(reqLen - reqPos); 
+        }
+
+        int read() override { 
+            return reqPos < reqLen ? pReq[reqPos++] : -1; 
+        }
+
+        int peek() override { 
+            return reqPos < reqLen ? pReq[reqPos] : -1; 
+        }
+
+        size_t write(uint8_t c) override {
+            if (c != 0) {
+                if (rxLen < sizeof(rx)) {
+                    rx[rxLen++] = c;
+                }
+                return 1;
+            }
+
+            delimiters++;
+            if (rxLen > 0) {
+                frame();
+            }
+            rxLen = 0;
+            return 1;
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) override {
+            for (size_t i = 0; i < size; i++) {
+                write(buffer[i]);
+            }
+            return size;
+        }
+
+        using Print::write;
+
+        char text[512];
+        size_t textLen;
+        uint32_t outputFrames;
+        uint32_t badFrames;
+        uint32_t delimiters;
+        uint8_t lastType;
+        uint8_t lastSeq;
+        uint8_t lastValue;
+
+    private:
+        void frame() {
+            size_t len = CmdRpc::unpack(rx, rxLen);
+
+            if (len < 2) {
+                badFrames++;
+                return;
+            }
+
+            lastType = rx[0];
+            lastSeq = rx[1];
+            if (lastType == CMDRPC_OUTPUT) {
+                outputFrames++;
+                for (size_t i = 2; i < len && textLen + 1 < sizeof(text); i++) {
+                    text[textLen++] = (char) rx[i];
+                }
+                text[textLen] = '\0';
+            } else if (len > 2) {
+                lastValue = rx[2];
+            }
+        }
+
+        const uint8_t *pReq;
+        size_t reqLen;
+        size_t reqPos;
+        uint8_t rx[CMDRPC_TXSIZ];
+        size_t rxLen;
+};
+
+/**
+ * @brief Builds a CMDRPC_CALL request.
+ * @return The length of the encoded request.
+ */
+static size_t rpcCall(uint8_t *dst, uint8_t seq, const char *name, 
+     size_t argc, const char *argv[]) {
+
+     uint8_t frame[CMDRPC_RXSIZ];
+     size_t idx = CmdIndex::find(name) - CliCommand::getTable();
+     size_t len = 5;
+
+     frame[0] = CMDRPC_CALL;
+     frame[1] = seq;
+     frame[2] = (uint8_t) idx;
+     frame[3] = (uint8_t) (idx >> 8);
+     frame[4] = (uint8_t) argc;
+     for (size_t i = 0; i < argc; i++) {
+          size_t n = strlen(argv[i]) + 1;
+
+          memcpy(&frame[len], argv[i], n);
+          len += n;
+     }
+
+     return CmdRpc::pack(frame, len, dst);
+}
+
+/**
+ * @brief Builds a request without payload.
+ */
+static size_t rpcRequest(uint8_t *dst, uint8_t type, uint8_t seq) {
+     uint8_t frame[4] = {type, seq};
+
+     return CmdRpc::pack(frame, 2, dst);
+}
+
+/**
+ * @brief Sends requests and runs them like Cli::loop() does.
+ */
+static void rpcRun(CmdRpc &rpc, RpcHost &host, const uint8_t *req, 
+     size_t len) {
+
+     host.send(req, len);
+     while (host.available() > 0 && rpc.isActive()) {
+          rpc.available();
+     }
+}
+
+/**
+ * @brief Tests the framing, the machine mode and the requests of CmdRpc.
+ */
+UNITTEST_DECL(cmdrpc) {
+     TestStream io;
+     RpcHost host;
+     CmdRpc rpc(io);
+     uint8_t req[CMDRPC_RXSIZ + 8];
+     uint8_t enc[32];
+     size_t len = 0;
+
+     FMT_PRINT(ioStream, "\n[1] CRC and COBS\n");
+     TEST_ASSERT_EQUAL_INT(0x29B1, 
+          CmdRpc::crc16((const uint8_t *) "123456789", 9));
+     uint8_t frame[8] = {'C', 0, 0, 7, 0, 0};
+     len = CmdRpc::pack(frame, 6, enc);
+     TEST_ASSERT_EQUAL_INT(10, len);
+     TEST_ASSERT("Only the last byte is 0", 
+          memchr(enc, 0, len - 1) == nullptr && enc[len - 1] == 0);
+     TEST_ASSERT_EQUAL_INT(6, CmdRpc::unpack(enc, len - 1));
+     TEST_ASSERT("Decoded in place", enc[0] == 'C' && enc[1] == 0 && 
+          enc[3] == 7 && enc[5] == 0);
+     len = CmdRpc::pack(frame, 6, enc);
+     enc[4] ^= 0x10;
+     TEST_ASSERT_EQUAL_INT(0, CmdRpc::unpack(enc, len - 1));
+     TEST_ASSERT_EQUAL_INT(0, CmdRpc::unpack(enc, 0));
+
+     FMT_PRINT(ioStream, "[2] Text mode\n");
+     io.setScript("err 1\r");
+     TEST_ASSERT_FALSE(rpc.isActive());
+     TEST_ASSERT_EQUAL_INT(6, rpc.available());
+     TEST_ASSERT_EQUAL_INT('e', rpc.read());
+     rpc.print("text");
+     TEST_ASSERT_EQUAL_STRING("text", io.output());
+
+     FMT_PRINT(ioStream, "[3] Machine mode\n");
+     io.clearOutput();
+     rpc.begin();
+     TEST_ASSERT_TRUE(rpc.isActive());
+     TEST_ASSERT("begin() sends a delimiter", 
+          io.outputLength() == 1 && io.output()[0] == 0);
+     io.clearOutput();
+     TEST_ASSERT_EQUAL_INT(0, rpc.available());
+     TEST_ASSERT_EQUAL_INT(-1, rpc.read());
+     rpc.print("#> ");
+     TEST_ASSERT_EQUAL_INT(0, io.outputLength());
+     TEST_ASSERT_EQUAL_INT(0, rpc.getFrames());
+     rpc.setStream(io);
+     TEST_ASSERT_FALSE(rpc.isActive());
+
+     FMT_PRINT(ioStream, "[4] Calls\n");
+     rpc.setStream(host);
+     rpc.begin();
+     const char *argv5[] = {"5"};
+     len = rpcCall(req, 7, "err", 1, argv5);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_STRING("Got value 5\n", host.text);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_RESULT, host.lastType);
+     TEST_ASSERT_EQUAL_INT(7, host.lastSeq);
+     TEST_ASSERT_EQUAL_INT(5, host.lastValue);
+     TEST_ASSERT_EQUAL_INT(2, host.delimiters);
+     const char *argvNeg[] = {"-3"};
+     len = rpcCall(req, 8, "err", 1, argvNeg);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(-3, (int8_t) host.lastValue);
+     TEST_ASSERT_EQUAL_INT(8, host.lastSeq);
+
+     FMT_PRINT(ioStream, "[5] Output in chunks\n");
+     const char *argvLong[] = {"first-argument-xxxxxxxxxx", 
+          "second-argument-xxxxxxxxx", "third-argument-xxxxxxxxxx"};
+     len = rpcCall(req, 9, "args", 3, argvLong);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(2, host.outputFrames);
+     TEST_ASSERT_EQUAL_INT(0, host.badFrames);
+     TEST_ASSERT("Output complete", host.textLen > CMDRPC_CHUNK &&
+          strstr(host.text, "argv[2]: \"third-argument-xxxxxxxxxx\"\n") != 
+          nullptr);
+     TEST_ASSERT_EQUAL_INT(0, host.lastValue);
+
+     FMT_PRINT(ioStream, "[6] One request per call\n");
+     len = rpcCall(req, 10, "err", 1, argv5);
+     len += rpcCall(&req[len], 11, "err", 1, argvNeg);
+     host.send(req, len);
+     TEST_ASSERT_EQUAL_INT(0, rpc.available());
+     TEST_ASSERT_EQUAL_INT(10, host.lastSeq);
+     TEST_ASSERT("Second one is left", host.available() > 0);
+     rpc.available();
+     TEST_ASSERT_EQUAL_INT(11, host.lastSeq);
+     TEST_ASSERT_EQUAL_INT(2, host.outputFrames);
+
+     FMT_PRINT(ioStream, "[7] Errors\n");
+     len = rpcCall(req, 12, "err", 1, argv5);
+     req[3] ^= 0x01;
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_ERROR, host.lastType);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_EFRAME, host.lastValue);
+     len = rpcRequest(req, 'Q', 13);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_ETYPE, host.lastValue);
+     TEST_ASSERT_EQUAL_INT(13, host.lastSeq);
+     uint8_t badIdx[8] = {CMDRPC_CALL, 14, 0xFF, 0xFF, 0};
+     len = CmdRpc::pack(badIdx, 5, req);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_EINDEX, host.lastValue);
+     uint8_t badArgs[8] = {CMDRPC_CALL, 15, 0, 0, 1, 'x'};
+     len = CmdRpc::pack(badArgs, 6, req);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_EARGS, host.lastValue);
+     uint8_t manyArgs[8] = {CMDRPC_CALL, 16, 0, 0, CMDTOKEN_ARGVSIZ + 1};
+     len = CmdRpc::pack(manyArgs, 5, req);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_EARGS, host.lastValue);
+     memset(req, 'x', sizeof(req));
+     req[sizeof(req) - 1] = 0;
+     rpcRun(rpc, host, req, sizeof(req));
+     TEST_ASSERT_EQUAL_INT(CMDRPC_EFRAME, host.lastValue);
+     TEST_ASSERT_EQUAL_INT(6, rpc.getErrors());
+     TEST_ASSERT_EQUAL_INT(11, rpc.getFrames());
+
+     FMT_PRINT(ioStream, "[8] List\n");
+     len = rpcRequest(req, CMDRPC_LIST, 17);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_RESULT, host.lastType);
+     TEST_ASSERT_EQUAL_INT(0, host.badFrames);
+     TEST_ASSERT("Starts with the first command", strncmp(host.text, 
+          CliCommand::getTable()[0].name, 
+          strlen(CliCommand::getTable()[0].name)) == 0);
+
+     FMT_PRINT(ioStream, "[9] Exit\n");
+     len = rpcRequest(req, CMDRPC_EXIT, 18);
+     rpcRun(rpc, host, req, len);
+     TEST_ASSERT_EQUAL_INT(CMDRPC_RESULT, host.lastType);
+     TEST_ASSERT_EQUAL_INT(18, host.lastSeq);
+     TEST_ASSERT_FALSE(rpc.isActive());
+     host.send((const uint8_t *) "help\r", 5);
+     TEST_ASSERT_EQUAL_INT(5, rpc.available());
+}
@@ -0,0 +1,150 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdschema.hpp"
+#include "cmdindex.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+CMDSCHEMA_ENUM(TestColor, "red", "green", "blue");
+
+static_assert(TestColor::of("green") == 1, "of() is a constant expression");
+static_assert(TestColor::cnt() == 3, "cnt() is a constant expression");
+
+/**
+ * @brief The values the handlers have been called with.
+ */
+static struct {
+     uint32_t calls;
+     uint8_t color;
+     long num;
+     const char *pText;
+} schemaSeen;
+
+static int8_t schemaHandler(Stream &ioStream, uint8_t color, long num, 
+     const char *pText) {
+
+     schemaSeen.calls++;
+     schemaSeen.color = color;
+     schemaSeen.num = num;
+     schemaSeen.pText = pText;
+     return 5;
+}
+
+static int8_t schemaOptHandler(Stream &ioStream, const char *pText, 
+     uint8_t color) {
+
+     schemaSeen.calls++;
+     schemaSeen.pText = pText;
+     schemaSeen.color = color;
+     return 0;
+}
+
+typedef CmdSchema<TestColor, ArgInt<-10, 100>, ArgStr> TestSchema;
+typedef CmdSchema<ArgStr, ArgOpt<TestColor>> TestOptSchema;
+
+/**
+ * @brief Tests the typed argument schemas.
+ */
+UNITTEST_DECL(cmdschema) {
+     TestStream io;
+     int8_t ret = 0;
+
+     FMT_PRINT(ioStream, "\n[1] Conversion\n");
+     const char *args[] = {"blue", "0x20", "hello"};
+     memset(&schemaSeen, 0, sizeof(schemaSeen));
+     ret = TestSchema::run(io, "t", 3, args, schemaHandler);
+     TEST_ASSERT_EQUAL_INT(5, ret);
+     TEST_ASSERT_EQUAL_INT(1, schemaSeen.calls);
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_OF(TestColor, "blue"), schemaSeen.color);
+     TEST_ASSERT_EQUAL_INT(32, schemaSeen.num);
+     TEST_ASSERT("String passed without copy", schemaSeen.pText == args[2]);
+     TEST_ASSERT_EQUAL_INT(0, io.outputLength());
+     const char *argsNeg[] = {"red", "-10", ""};
+     TEST_ASSERT_EQUAL_INT(5, TestSchema::run(io, "t", 3, argsNeg, 
+          schemaHandler));
+     TEST_ASSERT_EQUAL_INT(-10, schemaSeen.num);
+
+     FMT_PRINT(ioStream, "[2] Invalid input\n");
+     schemaSeen.calls = 0;
+     const char *badEnum[] = {"gren", "1", "x"};
+     io.clearOutput();
+     ret = TestSchema::run(io, "t", 3, badEnum, schemaHandler);
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, ret);
+     TEST_ASSERT_EQUAL_STRING(
+          "t: invalid argument 1 \"gren\", expected red|green|blue\n", 
+          io.output());
+     const char *badPrefix[] = {"re", "1", "x"};
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          TestSchema::run(io, "t", 3, badPrefix, schemaHandler));
+     const char *badRange[] = {"red", "101", "x"};
+     io.clearOutput();
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          TestSchema::run(io, "t", 3, badRange, schemaHandler));
+     TEST_ASSERT_EQUAL_STRING(
+          "t: invalid argument 2 \"101\", expected -10..100\n", io.output());
+     const char *badNum[] = {"red", "12x", "x"};
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          TestSchema::run(io, "t", 3, badNum, schemaHandler));
+     const char *emptyNum[] = {"red", "", "x"};
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          TestSchema::run(io, "t", 3, emptyNum, schemaHandler));
+     io.clearOutput();
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          TestSchema::run(io, "t", 2, args, schemaHandler));
+     TEST_ASSERT_EQUAL_STRING("Usage: t red|green|blue -10..100 text\n", 
+          io.output());
+     const char *tooMany[] = {"red", "1", "x", "y"};
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          TestSchema::run(io, "t", 4, tooMany, schemaHandler));
+     TEST_ASSERT_EQUAL_INT(0, schemaSeen.calls);
+
+     FMT_PRINT(ioStream, "[3] Optional arguments\n");
+     const char *opt[] = {"a", "green"};
+     TEST_ASSERT_EQUAL_INT(0, TestOptSchema::run(io, "o", 2, opt, 
+          schemaOptHandler));
+     TEST_ASSERT_EQUAL_INT(1, schemaSeen.color);
+     TEST_ASSERT_EQUAL_INT(0, TestOptSchema::run(io, "o", 1, opt, 
+          schemaOptHandler));
+     TEST_ASSERT_EQUAL_INT(TestColor::cnt(), schemaSeen.color);
+     TEST_ASSERT_EQUAL_INT(2, schemaSeen.calls);
+     io.clearOutput();
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          TestOptSchema::run(io, "o", 0, opt, schemaOptHandler));
+     TEST_ASSERT_EQUAL_STRING("Usage: o text [red|green|blue]\n", 
+          io.output());
+
+     FMT_PRINT(ioStream, "[4] Commands\n");
+     const char *ledX[] = {"x"};
+     io.clearOutput();
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          CmdIndex::exec(io, "led", ledX, 1));
+     TEST_ASSERT_EQUAL_STRING(
+          "led: invalid argument 1 \"x\", expected 0|1|b\n", io.output());
+     const char *errBig[] = {"128"};
+     TEST_ASSERT_EQUAL_INT(CMDSCHEMA_ERROR, 
+          CmdIndex::exec(io, "err", errBig, 1));
+     const char *errMin[] = {"-128"};
+     TEST_ASSERT_EQUAL_INT(-128, CmdIndex::exec(io, "err", errMin, 1));
+}
@@ -0,0 +1,142 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdindex.hpp"
+#include "cmdstats.hpp"
+#include "cmdjob.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+#if CMDSTATS
+
+/**
+ * @brief Returns the profile of the given command or nullptr.
+ */
+static const cmdStats_t* findStats(const char *name) {
+     for (size_t i = 0; i < CmdStats::getCnt(); i++) {
+          if (strcmp(CmdStats::get(i)->name, name) == 0) {
+               return CmdStats::get(i);
+          }
+     }
+     return nullptr;
+}
+
+/**
+ * @brief Prints two bytes per step, done after three steps.
+ */
+static int8_t statsJob(Stream &ioStream, uint32_t step, void *pArg) {
+     if (step == CMDJOB_CANCEL) {
+          return 0;
+     }
+
+     ioStream.print("ab");
+     return step < 2 ? CMDJOB_MORE : 0;
+}
+
+/**
+ * @brief Stands in for a command starting statsJob, notes the slot it runs
+ * in.
+ */
+static int8_t statsStart(Stream &ioStream, void *pArg) {
+     *(size_t*) pArg = CmdStats::current();
+     return CmdJob::start(ioStream, statsJob);
+}
+
+/**
+ * @brief Tests the per command profiler.
+ */
+UNITTEST_DECL(cmdstats) {
+     const char *args[] = {"3"};
+     const cmdStats_t *pErr = findStats("err");
+     TestStream io;
+     uint32_t calls;
+     uint32_t bytes;
+     size_t slot = SIZE_MAX;
+     size_t current = SIZE_MAX;
+     bool ok = true;
+
+     FMT_PRINT(ioStream, "\n[1] Every command is profiled\n");
+     TEST_ASSERT("getCnt() == CliCommand::getCmdCnt()",
+          CmdStats::getCnt() == CliCommand::getCmdCnt());
+     for (size_t i = 0; i < CliCommand::getCmdCnt(); i++) {
+          ok &= findStats(CliCommand::getTable()[i].name) != nullptr;
+     }
+     TEST_ASSERT("each table entry has a profile", ok);
+     TEST_ASSERT_NOT_NULL(pErr);
+     TEST_ASSERT_NULL(findStats("nosuchcmd"));
+     if (pErr == nullptr) {
+          return;
+     }
+
+     FMT_PRINT(ioStream, "[2] exec() is counted\n");
+     calls = pErr->calls;
+     bytes = pErr->bytes;
+     TEST_ASSERT("exec(\"err\", {\"3\"}) -> 3",
+          CmdIndex::exec(io, "err", args, 1) == 3);
+     TEST_ASSERT("calls + 1", pErr->calls == calls + 1);
+     TEST_ASSERT("bytes + output", 
+          pErr->bytes == bytes + io.outputLength());
+     TEST_ASSERT("output reaches the stream", io.outputLength() > 0);
+     TEST_ASSERT("max <= total", pErr->max <= pErr->total);
+
+     FMT_PRINT(ioStream, "[3] stream() returns the stream of the caller\n");
+     TEST_ASSERT("stream(io) == io", &CmdStats::stream(io) == &io);
+
+     FMT_PRINT(ioStream, "[4] reset() clears the counters\n");
+     CmdStats::reset();
+     TEST_ASSERT_EQUAL_INT(0, pErr->calls);
+     TEST_ASSERT_EQUAL_INT(0, pErr->bytes);
+     TEST_ASSERT_EQUAL_INT(0, pErr->max);
+     TEST_ASSERT("total == 0", pErr->total == 0);
+     TEST_ASSERT_EQUAL_STRING("err", pErr->name);
+     CmdIndex::exec(io, "err", args, 1);
+     TEST_ASSERT_EQUAL_INT(1, pErr->calls);
+
+     FMT_PRINT(ioStream, "[5] Resumed job steps are added to their command\n");
+     {
+          TestStream jobIo;
+          CmdJob cmdJob(jobIo);
+          int n = 0;
+
+          for (size_t i = 0; i < CmdStats::getCnt(); i++) {
+               slot = CmdStats::get(i) == pErr ? i : slot;
+          }
+          CmdStats::reset();
+          TEST_ASSERT_EQUAL_INT(0, 
+               CmdStats::resume(slot, cmdJob, statsStart, &current));
+          TEST_ASSERT("current() is the slot", current == slot);
+          TEST_ASSERT_TRUE(cmdJob.isBusy());
+          TEST_ASSERT_EQUAL_INT(2, pErr->bytes);
+          while (cmdJob.isBusy() && n++ < 10) {
+               cmdJob.available();
+          }
+          TEST_ASSERT_FALSE(cmdJob.isBusy());
+          TEST_ASSERT_EQUAL_STRING("ababab", jobIo.output());
+          TEST_ASSERT_EQUAL_INT(6, pErr->bytes);
+          TEST_ASSERT_EQUAL_INT(0, pErr->calls);
+          TEST_ASSERT("max <= total", pErr->max <= pErr->total);
+     }
+}
+
+#endif /* CMDSTATS */
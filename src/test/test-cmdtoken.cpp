@@ -0,0 +1,133 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "cmdtoken.hpp"
+#include "cmdbatch.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Splits a line and joins the tokens with '|' for easy comparison.
+ */
+static const char* tokenJoin(const char *line, int8_t *pRet = nullptr) {
+     static char buf[CLI_COMMANDSIZ];
+     static char out[CLI_COMMANDSIZ * 2];
+     CmdTokens tokens;
+     const char *pTok = nullptr;
+     size_t len = 0;
+     int8_t ret = 0;
+
+     strncpy(buf, line, sizeof(buf) - 1);
+     buf[sizeof(buf) - 1] = '\0';
+     out[0] = '\0';
+     ret = tokens.split(buf);
+     if (pRet != nullptr) {
+          *pRet = ret;
+     }
+
+     pTok = tokens.first();
+     for (size_t i = 0; i < tokens.getCnt(); i++) {
+          len += snprintf(&out[len], sizeof(out) - len, "%s%s", 
+               i > 0 ? "|" : "", pTok);
+          if (i + 1 < tokens.getCnt()) {
+               pTok = CmdTokens::next(pTok);
+          }
+     }
+
+     return out;
+}
+
+/**
+ * @brief Tests the in place tokenizer.
+ */
+UNITTEST_DECL(cmdtoken) {
+     CmdTokens tokens;
+     const char *argv[CMDTOKEN_ARGVSIZ];
+     char line[CLI_COMMANDSIZ];
+     int8_t ret = 0;
+
+     FMT_PRINT(ioStream, "\n[1] Blanks\n");
+     TEST_ASSERT_EQUAL_STRING("led|0", tokenJoin("led 0"));
+     TEST_ASSERT_EQUAL_STRING("args|a|b", tokenJoin("  args \t a   b\t "));
+     TEST_ASSERT_EQUAL_STRING("", tokenJoin(" \t "));
+     tokens.split(strcpy(line, "   "));
+     TEST_ASSERT_EQUAL_INT(0, tokens.getCnt());
+     TEST_ASSERT_NULL(tokens.first());
+
+     FMT_PRINT(ioStream, "[2] Quotes and escapes\n");
+     TEST_ASSERT_EQUAL_STRING("telnet|begin|My Net|pass", 
+          tokenJoin("telnet begin \"My Net\" pass"));
+     TEST_ASSERT_EQUAL_STRING("a|b \"c\"", tokenJoin("a 'b \"c\"'"));
+     TEST_ASSERT_EQUAL_STRING("a|b c d", tokenJoin("a b\" c \"d"));
+     TEST_ASSERT_EQUAL_STRING("a||b", tokenJoin("a \"\" b"));
+     TEST_ASSERT_EQUAL_STRING("a|b c|\"|\\", tokenJoin("a b\\ c \\\" \\\\"));
+     TEST_ASSERT_EQUAL_STRING("a|\\n", tokenJoin("a '\\n'"));
+     TEST_ASSERT_EQUAL_STRING("a|x\"y", tokenJoin("a \"x\\\"y\""));
+     TEST_ASSERT_EQUAL_STRING("a|\\", tokenJoin("a \\"));
+     tokenJoin("a \"b c", &ret);
+     TEST_ASSERT_EQUAL_INT(CMDTOKEN_EQUOTE, ret);
+     tokens.split(strcpy(line, "a 'b"));
+     TEST_ASSERT_EQUAL_INT(0, tokens.getCnt());
+
+     FMT_PRINT(ioStream, "[3] In place\n");
+     tokens.split(strcpy(line, "cmd \"x y\" z"));
+     TEST_ASSERT("Tokens start in the line", tokens.first() == line);
+     TEST_ASSERT("Tokens follow each other", 
+          memcmp(line, "cmd\0x y\0z\0", 10) == 0);
+
+     FMT_PRINT(ioStream, "[4] argv\n");
+     tokens.split(strcpy(line, "cmd a b c"));
+     TEST_ASSERT_EQUAL_INT(3, tokens.toArgv(argv, CMDTOKEN_ARGVSIZ));
+     TEST_ASSERT_EQUAL_STRING("c", argv[2]);
+     TEST_ASSERT("argv points into the line", argv[0] == &line[4]);
+     TEST_ASSERT_EQUAL_INT(3, tokens.toArgv(argv, 1));
+     tokens.split(strcpy(line, "cmd"));
+     TEST_ASSERT_EQUAL_INT(0, tokens.toArgv(argv, CMDTOKEN_ARGVSIZ));
+
+     FMT_PRINT(ioStream, "[5] Batch\n");
+     {
+          TestStream io;
+          CmdBatch batch(io);
+
+          batch.feed("args \"My Net\" 'a b' c\n", 22);
+          TEST_ASSERT_EQUAL_INT(0, batch.getResult());
+          TEST_ASSERT("Quoted argument", 
+               strstr(io.output(), "argv[0]: \"My Net\"") != nullptr &&
+               strstr(io.output(), "argv[2]: \"c\"") != nullptr);
+
+          io.clearOutput();
+          batch.feed("args 1 2 3 4 5 6\n", 17);
+          TEST_ASSERT_EQUAL_INT(0, batch.getResult());
+          TEST_ASSERT("More than CLI_ARGVSIZ arguments", 
+               strstr(io.output(), "argv[5]: \"6\"") != nullptr);
+
+          io.clearOutput();
+          batch.feed("# don't split comments\n", 23);
+          TEST_ASSERT_EQUAL_INT(0, batch.getFailed());
+          batch.feed("args \"open\n", 11);
+          TEST_ASSERT_EQUAL_INT(-1, batch.getResult());
+          TEST_ASSERT("Unterminated quote reported", 
+               strstr(io.output(), "unterminated quote") != nullptr);
+     }
+}
@@ -0,0 +1,104 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "corelink.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Tests the SPSC queue and the CoreLink stream on a single core.
+ */
+UNITTEST_DECL(corelink) {
+     SpscQueue<16> queue;
+     CoreLink<16> link;
+     TestStream io;
+     uint8_t in[32];
+     uint8_t out[32];
+     uint8_t next = 0;
+     uint8_t expect = 0;
+     bool ok = true;
+
+     for (size_t i = 0; i < sizeof(in); i++) {
+          in[i] = (uint8_t) ('a' + i);
+     }
+
+     FMT_PRINT(ioStream, "\n[1] Empty and full queue\n");
+     TEST_ASSERT_EQUAL_INT(0, queue.available());
+     TEST_ASSERT_EQUAL_INT(16, queue.space());
+     TEST_ASSERT_EQUAL_INT(-1, queue.peek());
+     TEST_ASSERT_EQUAL_INT(0, queue.pop(out, sizeof(out)));
+     TEST_ASSERT_EQUAL_INT(10, queue.push(in, 10));
+     TEST_ASSERT_EQUAL_INT(6, queue.push(in + 10, 10));
+     TEST_ASSERT_EQUAL_INT(0, queue.push(in, 1));
+     TEST_ASSERT_EQUAL_INT(16, queue.available());
+     TEST_ASSERT_EQUAL_INT(0, queue.space());
+     TEST_ASSERT_EQUAL_INT('a', queue.peek());
+     TEST_ASSERT_EQUAL_INT(16, queue.pop(out, sizeof(out)));
+     TEST_ASSERT("bytes come out in order", memcmp(in, out, 16) == 0);
+
+     FMT_PRINT(ioStream, "[2] Wrap around\n");
+     for (size_t i = 0; i < 200; i++) {
+          uint8_t buf[16];
+          size_t n = queue.push(&in[next], (i % 7) + 1 < sizeof(in) - next ?
+               (i % 7) + 1 : sizeof(in) - next);
+
+          next = (uint8_t) ((next + n) % sizeof(in));
+          n = queue.pop(buf, (i % 5) + 1);
+          for (size_t k = 0; k < n; k++) {
+               ok &= buf[k] == in[expect];
+               expect = (uint8_t) ((expect + 1) % sizeof(in));
+          }
+          ok &= queue.available() + queue.space() == 16;
+     }
+     TEST_ASSERT("200 mixed push/pop keep the order", ok);
+
+     FMT_PRINT(ioStream, "[3] pump() passes input to the link\n");
+     io.setScript("help\r");
+     link.pump(io);
+     TEST_ASSERT_EQUAL_INT(5, link.available());
+     TEST_ASSERT_EQUAL_INT('h', link.peek());
+     TEST_ASSERT_EQUAL_INT('h', link.read());
+     TEST_ASSERT_EQUAL_INT('e', link.read());
+     while (link.read() >= 0);
+     TEST_ASSERT_EQUAL_INT(0, link.available());
+
+     FMT_PRINT(ioStream, "[4] pump() passes output to the stream\n");
+     TEST_ASSERT_EQUAL_INT(6, link.print("hello\n"));
+     TEST_ASSERT_EQUAL_INT(6, link.pending());
+     TEST_ASSERT_EQUAL_INT(0, io.outputLength());
+     link.pump(io);
+     TEST_ASSERT_EQUAL_STRING("hello\n", io.output());
+     TEST_ASSERT_EQUAL_INT(1, io.getWriteCalls());
+     TEST_ASSERT_EQUAL_INT(0, link.pending());
+
+     FMT_PRINT(ioStream, "[5] Output is dropped once the queue stays full\n");
+     io.clearOutput();
+     uint32_t start = millis();
+     TEST_ASSERT_EQUAL_INT(16, link.write(in, 20));
+     TEST_ASSERT("waited CORELINK_TIMEOUT", 
+          millis() - start >= CORELINK_TIMEOUT);
+     link.pump(io);
+     TEST_ASSERT_EQUAL_INT(16, io.outputLength());
+     TEST_ASSERT("queued part arrives", memcmp(io.output(), in, 16) == 0);
+}
@@ -0,0 +1,91 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "format.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Formats the arguments with FMT_PRINT() and snprintf() and compares
+ * the results.
+ */
+#define FORMAT_CMP(_fmt, ...)                                               \
+    do {                                                                    \
+        char exp[128];                                                      \
+        sink.clearOutput();                                                 \
+        FMT_PRINT(sink, _fmt, ##__VA_ARGS__);                               \
+        snprintf(exp, sizeof(exp), _fmt, ##__VA_ARGS__);                    \
+        TEST_ASSERT("\"" _fmt "\"", strcmp(sink.output(), exp) == 0);       \
+    } while (0)
+
+/**
+ * @brief Tests the compile time checked formatter against snprintf().
+ */
+UNITTEST_DECL(format) {
+     TestStream sink;
+     const char *str = "text";
+     char buf[] = "buffer";
+     size_t siz = 1234;
+     int16_t i16 = -300;
+     uint8_t u8 = 250;
+     unsigned long ul = 4000000000UL;
+     long long ll = -1234567890123LL;
+
+     FMT_PRINT(ioStream, "\n[1] Text and escaped percent\n");
+     FORMAT_CMP("plain text\n");
+     FORMAT_CMP("100%% done %%\n");
+
+     FMT_PRINT(ioStream, "[2] Signed integers\n");
+     FORMAT_CMP("%d %d %d", 0, -1, 2147483647);
+     FORMAT_CMP("%d", (int) -2147483647 - 1);
+     FORMAT_CMP("%i %d", i16, u8);
+     FORMAT_CMP("%ld %lld", -70000L, ll);
+
+     FMT_PRINT(ioStream, "[3] Unsigned and hex\n");
+     FORMAT_CMP("%u %lu %zu", 4000000000U, ul, siz);
+     FORMAT_CMP("%x %X %lx", 0xbeefU, 0xBEEFU, ul);
+     FORMAT_CMP("%x", -1);
+
+     FMT_PRINT(ioStream, "[4] Width and flags\n");
+     FORMAT_CMP("[%5d] [%-5d] [%05d] [%05d]", 42, 42, 42, -42);
+     FORMAT_CMP("[%02d:%02d] [%03d]", 7, 5, 123456);
+     FORMAT_CMP("[%-8s] [%8s] [%2s]", str, buf, str);
+
+     FMT_PRINT(ioStream, "[5] Strings and characters\n");
+     FORMAT_CMP("%s %s %s", str, buf, "literal");
+     FORMAT_CMP("%c%c%c", 'a', 'b', 'c');
+
+     FMT_PRINT(ioStream, "[6] Write calls\n");
+     sink.clearOutput();
+     FMT_PRINT(sink, "argv[%zu]: \"%s\"\n", siz, str);
+     TEST_ASSERT("one write per call", 
+          sink.getWriteCalls() == 1);
+
+     FMT_PRINT(ioStream, "[7] Output longer than the buffer\n");
+     FORMAT_CMP("%s %s %s %s %s %s %s %s %s %s %s %s", str, str, str, str, 
+          str, str, str, str, str, str, str, str);
+     FORMAT_CMP("%-70s|%5d", str, 42);
+     FORMAT_CMP("%s%s", "0123456789012345678901234567890123456789"
+          "0123456789012345678901234567890123456789", str);
+}
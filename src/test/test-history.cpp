@@ -21,27 +21,24 @@
 #include <cli/cli.hpp>
 
 #include "unit-test.hpp"
+#include "history.hpp"
 
 #include <stdio.h>
 #include <stdint.h>
 
 /**
- * @brief Tests the CliHistory ring-buffer implementation.
+ * @brief The ring-buffer tests, shared by CliHistory and HistoryRing as both 
+ * use the same interface and storage format.
  */
-UNITTEST_DECL(history) {
-#if defined(RESOURCE_USAGE_TEST) || CLI_HISTORYSIZ == 0
-     ioStream.printf("\n[SKIPPED] History unit tests disabled\n");
-     return;
-#else
-     CliHistory history;
-
+template<class H>
+static void historyTests(Stream& ioStream, TestRun& testRun, H& history) {
      char buf[CLI_COMMANDSIZ];
      /* needed for entries > CLI_COMMANDSIZ */
      char lbuf[CLI_HISTORYSIZ];       
      /* Two 97-char strings fill 196 of 200 bytes — used for eviction tests. */
      char big[98];
 
-     ioStream.printf("\n[1] Initial state\n");
+     FMT_PRINT(ioStream, "\n[1] Initial state\n");
      TEST_ASSERT("get_free_space == CLI_HISTORYSIZ",
           history.get_free_space() == CLI_HISTORYSIZ);
      TEST_ASSERT("is_used == false",
@@ -53,7 +50,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read -> 0",
           history.read(buf, sizeof(buf)) == 0);
 
-     ioStream.printf("[2] Invalid append arguments\n");
+     FMT_PRINT(ioStream, "[2] Invalid append arguments\n");
      TEST_ASSERT("append(nullptr, 5) -> false",
           history.append(nullptr, 5) == false);
      TEST_ASSERT("append(str, 0) -> false",
@@ -68,7 +65,7 @@ UNITTEST_DECL(history) {
           history.get_free_space() == CLI_HISTORYSIZ &&
           history.read(buf, sizeof(buf)) == 0);
 
-     ioStream.printf("[3] Single entry\n");
+     FMT_PRINT(ioStream, "[3] Single entry\n");
      TEST_ASSERT("append \"hello\" -> true",
           history.append("hello", 5) == true);
      TEST_ASSERT("get_free_space == size - 6",
@@ -80,7 +77,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("seek_forward  at only entry -> false",
           history.seek_forward()  == false);
 
-     ioStream.printf("[4] read() edge cases\n");
+     FMT_PRINT(ioStream, "[4] read() edge cases\n");
      /* "hello" is 5 chars; need buffer >= 6 (5 + NUL) */
      TEST_ASSERT("read(buf, 5) -> 0  (buffer too small)", 
           history.read(buf, 5) == 0);
@@ -91,7 +88,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read(buf, 0) -> 0",               
           history.read(buf, 0) == 0);
 
-     ioStream.printf("[5] Two entries — navigation\n");
+     FMT_PRINT(ioStream, "[5] Two entries — navigation\n");
      history.clear();
      history.append("first",  5); /* older  */
      history.append("second", 6); /* newer, pRead here after append */
@@ -112,7 +109,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("seek_forward at newest -> false",
           history.seek_forward() == false);
 
-     ioStream.printf("[6] Three entries — full navigation cycle\n");
+     FMT_PRINT(ioStream, "[6] Three entries — full navigation cycle\n");
      history.clear();
      history.append("alpha", 5); /* oldest */
      history.append("beta",  4);
@@ -140,7 +137,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("fwd at newest -> false",
           history.seek_forward()  == false);
 
-     ioStream.printf("[7] New append always resets pRead to newest entry\n");
+     FMT_PRINT(ioStream, "[7] New append always resets pRead to newest entry\n");
      history.seek_backward();  /* move pRead off the newest entry */
      history.append("delta", 5);
      TEST_ASSERT("read after append -> \"delta\"",
@@ -148,7 +145,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("seek_forward at newest -> false",
           history.seek_forward() == false);
 
-     ioStream.printf("[8] clear() resets to initial state\n");
+     FMT_PRINT(ioStream, "[8] clear() resets to initial state\n");
      history.clear();
      TEST_ASSERT("get_free_space == CLI_HISTORYSIZ",
           history.get_free_space() == CLI_HISTORYSIZ);
@@ -159,7 +156,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read          -> 0",
           history.read(buf, sizeof(buf)) == 0);
 
-     ioStream.printf("[9] Eviction — oldest entry removed if space needed\n");
+     FMT_PRINT(ioStream, "[9] Eviction — oldest entry removed if space needed\n");
      /* CLI_HISTORYSIZ = 200.
      * A(97) uses 98 bytes -> pHead = 98.
      * B(97) uses 98 bytes -> pHead = 196, free = (200-196) + 0 = 4.
@@ -182,7 +179,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("bwd -> A-string evicted, no older entry", 
           history.seek_backward() == false);
 
-     ioStream.printf("[10] Wrap-around — entry spanning buffer boundary\n");
+     FMT_PRINT(ioStream, "[10] Wrap-around — entry spanning buffer boundary\n");
      /* After test [9]: pHead=2, pTail=98.
      * "evict" was written at 196..199 ('e','v','i','c') then 0..1 ('t','\0').
      * Verify read() correctly assembles the string across the wrap. */
@@ -191,7 +188,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read wrapped entry -> \"evict\"",
           history.read(buf, sizeof(buf)) == 5 && strcmp(buf, "evict") == 0);
 
-     ioStream.printf("[11] is_used flag\n");
+     FMT_PRINT(ioStream, "[11] is_used flag\n");
      history.is_used = true;
      TEST_ASSERT("is_used can be set true",  
           history.is_used == true);
@@ -199,7 +196,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("is_used can be set false", 
           history.is_used == false);
 
-     ioStream.printf("[12] Single-character entry (minimum valid length)\n");
+     FMT_PRINT(ioStream, "[12] Single-character entry (minimum valid length)\n");
      history.clear();
      TEST_ASSERT("append \"x\" (len=1)           -> true",
           history.append("x", 1) == true);
@@ -208,7 +205,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read -> \"x\", returns 1",
           history.read(buf, sizeof(buf)) == 1 && strcmp(buf, "x") == 0);
 
-     ioStream.printf("[13] Maximum-length entry (CLI_HISTORYSIZ-1 chars) + full-buffer state\n");
+     FMT_PRINT(ioStream, "[13] Maximum-length entry (CLI_HISTORYSIZ-1 chars) + full-buffer state\n");
      /* A single entry of CLI_HISTORYSIZ-1 chars occupies all CLI_HISTORYSIZ bytes
      * (chars + NUL), leaving get_free_space() == 0. This exercises the
      * pHead==pTail branch of get_free_space() and the evict-all / clear()
@@ -233,7 +230,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("no older entry after evict-all: seek_backward -> false",
           history.seek_backward() == false);
 
-     ioStream.printf("[14] Two evictions needed for one append\n");
+     FMT_PRINT(ioStream, "[14] Two evictions needed for one append\n");
      /* Three 9-char entries (10 bytes each) = 30 bytes, free = 170.
      * A 180-char entry needs 181 bytes: oldest two entries (20 bytes) must be
      * evicted before there is enough space; the third entry survives. */
@@ -256,7 +253,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("bwd -> entries 1+2 are gone, no further entry",
           history.seek_backward() == false);
 
-     ioStream.printf("[15] Complete eviction — clear() path inside append()\n");
+     FMT_PRINT(ioStream, "[15] Complete eviction — clear() path inside append()\n");
      /* Three 2-char entries (3 bytes each) = 9 bytes total, free = 191.
      * A 198-char entry needs 199 bytes: all three entries must be evicted;
      * on the third eviction pTail reaches pHead -> clear() is triggered
@@ -279,7 +276,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("no newer entry (only 1 entry remains)",
           history.seek_forward()  == false);
 
-     ioStream.printf("[16] seek scan crossing physical buffer boundary\n");
+     FMT_PRINT(ioStream, "[16] seek scan crossing physical buffer boundary\n");
      /* Tests [1]-[15] never have the *internal scan loop* of seek_forward or
      * seek_backward cross the buffer end. [10] only verifies that read()
      * assembles a wrapped entry, but seek_forward in [10] scans through the
@@ -354,7 +351,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("fwd at newest -> false",
           history.seek_forward() == false);
 
-     ioStream.printf("[17] Duplicate prevention — identical consecutive entries\n");
+     FMT_PRINT(ioStream, "[17] Duplicate prevention — identical consecutive entries\n");
      /* When appending a string identical to the last entry (pLast), append()
       * should return true but not write anything. */
      history.clear();
@@ -381,7 +378,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read -> \"test\"",
           history.read(buf, sizeof(buf)) == 4 && strcmp(buf, "test") == 0);
 
-     ioStream.printf("[18] Duplicate after navigation — pRead reset\n");
+     FMT_PRINT(ioStream, "[18] Duplicate after navigation — pRead reset\n");
      /* User navigates in history (pRead != pLast), then enters the same
       * command as the newest entry. The duplicate should not be written,
       * but pRead must be reset to pLast. */
@@ -407,7 +404,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("at newest entry: seek_forward -> false",
           history.seek_forward() == false);
 
-     ioStream.printf("[19] is_used flag reset after append\n");
+     FMT_PRINT(ioStream, "[19] is_used flag reset after append\n");
      /* After any append() — whether writing a new entry or detecting a
       * duplicate — is_used should be set to false and pRead should point
       * to the newest entry. */
@@ -435,7 +432,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("pRead at newest: read -> \"gamma\"",
           history.read(buf, sizeof(buf)) == 5 && strcmp(buf, "gamma") == 0);
 
-     ioStream.printf("[20] Duplicate detection with wrapped entry\n");
+     FMT_PRINT(ioStream, "[20] Duplicate detection with wrapped entry\n");
      /* Verify duplicate detection works when the pLast entry is wrapped
       * across the buffer boundary. */
      history.clear();
@@ -453,7 +450,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read -> \"wrap\"",
           history.read(buf, sizeof(buf)) == 4 && strcmp(buf, "wrap") == 0);
 
-     ioStream.printf("[21] Duplicate detection — case sensitivity\n");
+     FMT_PRINT(ioStream, "[21] Duplicate detection — case sensitivity\n");
      /* Strings differing only in case should NOT be treated as duplicates */
      history.clear();
      history.append("Test", 4);
@@ -469,7 +466,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read -> \"Test\"",
           history.read(buf, sizeof(buf)) == 4 && strcmp(buf, "Test") == 0);
 
-     ioStream.printf("[22] Duplicate detection — empty history\n");
+     FMT_PRINT(ioStream, "[22] Duplicate detection — empty history\n");
      /* Calling append() on an empty history (pLast==0) should always write */
      history.clear();
      TEST_ASSERT("append \"first\" on empty history -> true",
@@ -479,7 +476,7 @@ UNITTEST_DECL(history) {
      TEST_ASSERT("read -> \"first\"",
           history.read(buf, sizeof(buf)) == 5 && strcmp(buf, "first") == 0);
 
-     ioStream.printf("[23] Multiple different entries then duplicate\n");
+     FMT_PRINT(ioStream, "[23] Multiple different entries then duplicate\n");
      /* Build up several entries, then try to duplicate the most recent */
      history.clear();
      history.append("cmd1", 4);
@@ -507,5 +504,113 @@ UNITTEST_DECL(history) {
           history.read(buf, sizeof(buf)) == 4 && strcmp(buf, "cmd1") == 0);
      TEST_ASSERT("no older entry",
           history.seek_backward() == false);
+}
+
+/**
+ * @brief Tests the CliHistory ring-buffer implementation.
+ */
+UNITTEST_DECL(history) {
+#if defined(RESOURCE_USAGE_TEST) || CLI_HISTORYSIZ == 0
+     FMT_PRINT(ioStream, "\n[SKIPPED] History unit tests disabled\n");
+     return;
+#else
+     CliHistory history;
+
+     historyTests(ioStream, testRun, history);
+#endif
+}
+
+/**
+ * @brief Gives the test access to the ring buffer of a HistoryRing.
+ */
+template<size_t SIZ>
+class SeekProbe : public HistoryRing<SIZ> {
+     public:
+          /**
+           * @brief Exchanges the ring buffer with the given one of SIZ bytes.
+           */
+          void swapBuffer(char *other) {
+               for (size_t i = 0; i < SIZ; i++) {
+                    char c = this->buffer[i];
+                    this->buffer[i] = other[i];
+                    other[i] = c;
+               }
+          }
+};
+
+/**
+ * @brief Walks from the newest entry to the oldest one and back with the ring
+ * buffer zeroed. Seeks reading the buffer would see empty entries there.
+ * @return The number of seeks, 2 * (entries - 1) if they only use the index.
+ */
+template<size_t SIZ>
+static uint32_t blindSeeks(SeekProbe<SIZ>& history) {
+     char zero[SIZ];
+     uint32_t seeks = 0;
+
+     memset(zero, 0, sizeof(zero));
+     history.swapBuffer(zero);
+     while (history.seek_backward()) {
+          seeks++;
+     }
+     while (history.seek_forward()) {
+          seeks++;
+     }
+     history.swapBuffer(zero);
+
+     return seeks;
+}
+
+/**
+ * @brief Tests the indexed HistoryRing with the CliHistory tests and checks 
+ * that seeking does not depend on the entry length.
+ */
+UNITTEST_DECL(historyidx) {
+#if defined(RESOURCE_USAGE_TEST) || CLI_HISTORYSIZ == 0
+     FMT_PRINT(ioStream, "\n[SKIPPED] History unit tests disabled\n");
+     return;
+#else
+     SeekProbe<CLI_HISTORYSIZ> history;
+     char buf[CLI_HISTORYSIZ];
+
+     historyTests(ioStream, testRun, history);
+
+     FMT_PRINT(ioStream, "[24] Index limits the number of entries\n");
+     HistoryRing<CLI_HISTORYSIZ, 3> small;
+     small.append("one", 3);
+     small.append("two", 3);
+     small.append("three", 5);
+     small.append("four", 4);
+     TEST_ASSERT("get_count == 3 after 4 appends",
+          small.get_count() == 3);
+     TEST_ASSERT("oldest entry \"one\" evicted, \"two\" is oldest",
+          small.seek_backward() && small.seek_backward() && 
+          !small.seek_backward() && 
+          small.read(buf, sizeof(buf)) == 3 && strcmp(buf, "two") == 0);
+     TEST_ASSERT("free space only counts the remaining entries",
+          small.get_free_space() == CLI_HISTORYSIZ - 4 - 6 - 5);
+
+     FMT_PRINT(ioStream, "[25] Seeking over long entries\n");
+     /* CliHistory walks over the characters of an entry per seek, the index
+      * does not touch the ring buffer at all. */
+     history.clear();
+     history.append("a", 1);
+     history.append("b", 1);
+     history.append("c", 1);
+     TEST_ASSERT_EQUAL_INT(4, blindSeeks(history));
+     TEST_ASSERT_EQUAL_INT(2, history.get_position());
+     history.clear();
+     memset(buf, 'L', 98); buf[98] = '\0';
+     history.append(buf, 98);
+     buf[0] = 'K';
+     history.append(buf, 98);
+     TEST_ASSERT_EQUAL_INT(2, blindSeeks(history));
+     TEST_ASSERT_EQUAL_INT(1, history.get_position());
+     TEST_ASSERT("newest long entry intact after the seeks",
+          history.read(buf, sizeof(buf)) == 98 && buf[0] == 'K' && 
+          buf[97] == 'L');
+     TEST_ASSERT("oldest long entry intact after the seeks",
+          history.seek_backward() && history.read(buf, sizeof(buf)) == 98 && 
+          buf[0] == 'L' && !history.seek_backward());
 #endif
 }
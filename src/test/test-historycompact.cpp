@@ -0,0 +1,134 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "compacthistory.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Tests the prefix compressed history.
+ */
+UNITTEST_DECL(historycompact) {
+     CompactHistory<200, 32, 4> history;
+     char buf[64];
+     char exp[16];
+     bool ok = true;
+
+     FMT_PRINT(ioStream, "\n[1] Invalid append arguments\n");
+     TEST_ASSERT("append(nullptr, 5) -> false",
+          history.append(nullptr, 5) == false);
+     TEST_ASSERT("append(str, 0) -> false",
+          history.append("hi", 0) == false);
+     TEST_ASSERT("append with len not at NUL-term -> false",
+          history.append("hello", 4) == false);
+     TEST_ASSERT("append len == 199 -> false (prefix byte needed)",
+          history.append("x", 199) == false);
+     TEST_ASSERT("read -> 0",
+          history.read(buf, sizeof(buf)) == 0);
+
+     FMT_PRINT(ioStream, "[2] Entries share the prefix with their predecessor\n");
+     history.append("dummy_long_1", 12);
+     TEST_ASSERT("full entry: 1 + 12 + 1 bytes",
+          history.get_free_space() == 200 - 14);
+     history.append("dummy_long_2", 12);
+     TEST_ASSERT("relative entry: 1 + 1 + 1 bytes",
+          history.get_free_space() == 200 - 14 - 3);
+     TEST_ASSERT("read newest -> \"dummy_long_2\"",
+          history.read(buf, sizeof(buf)) == 12 && 
+          strcmp(buf, "dummy_long_2") == 0);
+     TEST_ASSERT("bwd, read -> \"dummy_long_1\"",
+          history.seek_backward() && history.read(buf, sizeof(buf)) == 12 && 
+          strcmp(buf, "dummy_long_1") == 0);
+
+     FMT_PRINT(ioStream, "[3] Shorter entry and no shared prefix\n");
+     history.append("dummy", 5);
+     history.append("led 1", 5);
+     TEST_ASSERT("read -> \"led 1\"",
+          history.read(buf, sizeof(buf)) == 5 && strcmp(buf, "led 1") == 0);
+     TEST_ASSERT("bwd, read -> \"dummy\"",
+          history.seek_backward() && history.read(buf, sizeof(buf)) == 5 && 
+          strcmp(buf, "dummy") == 0);
+
+     FMT_PRINT(ioStream, "[4] Duplicate of the newest entry is skipped\n");
+     size_t free_before = history.get_free_space();
+     TEST_ASSERT("append \"led 1\" again -> true",
+          history.append("led 1", 5) == true);
+     TEST_ASSERT("free space unchanged",
+          history.get_free_space() == free_before);
+     TEST_ASSERT("read position reset to newest",
+          history.seek_forward() == false);
+
+     FMT_PRINT(ioStream, "[5] Full entry at least every RESTART entries\n");
+     history.clear();
+     for (int i = 0; i < 9; i++) {
+          snprintf(exp, sizeof(exp), "led_%d", i);
+          history.append(exp, 5);
+     }
+     /* restarts at entry 0, 4 and 8: 3 * 7 bytes + 6 * 3 bytes */
+     TEST_ASSERT("free space == 200 - 3*7 - 6*3",
+          history.get_free_space() == 200 - 3 * 7 - 6 * 3);
+     for (int i = 8; i >= 0; i--) {
+          snprintf(exp, sizeof(exp), "led_%d", i);
+          ok &= history.read(buf, sizeof(buf)) == 5 && strcmp(buf, exp) == 0;
+          ok &= history.seek_backward() == (i > 0);
+     }
+     TEST_ASSERT("all entries decode correctly", ok);
+
+     FMT_PRINT(ioStream, "[6] Eviction drops whole groups\n");
+     CompactHistory<40, 16, 4> small;
+     int oldest = 0;
+     ok = true;
+     for (int i = 0; i < 40; i++) {
+          snprintf(exp, sizeof(exp), "cmd_%02d", i);
+          ok &= small.append(exp, 6);
+     }
+     TEST_ASSERT("all appends -> true", ok);
+     ok = small.get_count() > 0;
+     for (int i = 39; ok; i--) {
+          snprintf(exp, sizeof(exp), "cmd_%02d", i);
+          ok &= small.read(buf, sizeof(buf)) == 6 && strcmp(buf, exp) == 0;
+          oldest = i;
+          if (!small.seek_backward()) {
+               break;
+          }
+     }
+     TEST_ASSERT("remaining entries are the newest ones, in order", ok);
+     TEST_ASSERT("oldest entry is 39 - count + 1",
+          oldest == 39 - (int) small.get_count() + 1);
+
+     FMT_PRINT(ioStream, "[7] Search matches across the shared prefix\n");
+     TestStream out;
+     history.clear();
+     history.append("telnet begin net1", 17);
+     history.append("telnet info", 11);
+     history.append("telnet end", 10);
+     TEST_ASSERT_EQUAL_INT(1, history.find_backward("et i", 4, 2));
+     TEST_ASSERT_EQUAL_INT(0, history.find_backward("begin", 5, 2));
+     TEST_ASSERT_EQUAL_INT(-1, history.find_backward("led", 3, 2));
+     TEST_ASSERT_EQUAL_INT(11, history.write_entry(1, out));
+     TEST_ASSERT_EQUAL_STRING("telnet info", out.output());
+     TEST_ASSERT("set_position(0), read -> \"telnet begin net1\"",
+          history.set_position(0) && history.read(buf, sizeof(buf)) == 17 &&
+          strcmp(buf, "telnet begin net1") == 0);
+}
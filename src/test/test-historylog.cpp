@@ -0,0 +1,182 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "historylog.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Walks from the newest to the oldest entry and compares each with 
+ * the expected strings, newest first.
+ */
+template<class H>
+static bool entriesAre(H& history, const char *exp[], size_t cnt) {
+     char buf[64];
+
+     for (size_t i = 0; i < cnt; i++) {
+          if (i > 0 && !history.seek_backward()) {
+               return false;
+          }
+          if (history.read(buf, sizeof(buf)) == 0 || strcmp(buf, exp[i]) != 0) {
+               return false;
+          }
+     }
+
+     return !history.seek_backward();
+}
+
+/**
+ * @brief A store whose new log cannot be written, like a reset during 
+ * compaction.
+ */
+class FailingRewriteStore : public HistoryMemStore {
+    public:
+        FailingRewriteStore(char *pMem, size_t siz, char *pSpare) : 
+            HistoryMemStore(pMem, siz, pSpare) {}
+
+        bool appendRewrite(const char *buf, size_t len) override {
+            return false;
+        }
+};
+
+/**
+ * @brief Tests the append-only history log and the restore from it.
+ */
+UNITTEST_DECL(historylog) {
+     static char mem[128];
+     static char spare[128];
+     HistoryMemStore store(mem, sizeof(mem), spare);
+     PersistentHistory<64, 8> history;
+     PersistentHistory<64, 8> restored;
+     char buf[64];
+
+     FMT_PRINT(ioStream, "\n[1] Entries are appended to the log\n");
+     TEST_ASSERT("begin(nullptr) -> false",
+          history.begin(nullptr) == false);
+     TEST_ASSERT("begin(store) -> true",
+          history.begin(&store) == true);
+     history.clear();
+     TEST_ASSERT("clear() erases the log",
+          store.size() == 0);
+     history.append("one", 3);
+     history.append("two", 3);
+     TEST_ASSERT("log holds \"one\\0two\\0\"",
+          store.size() == 8 && memcmp(mem, "one\0two\0", 8) == 0);
+
+     FMT_PRINT(ioStream, "[2] Duplicates of the newest entry are not logged\n");
+     history.append("two", 3);
+     TEST_ASSERT("log size unchanged",
+          store.size() == 8);
+     history.append("one", 3);
+     TEST_ASSERT("non consecutive duplicate is logged",
+          store.size() == 12);
+
+     FMT_PRINT(ioStream, "[3] Restore in one sequential pass\n");
+     TEST_ASSERT("begin(store) -> true",
+          restored.begin(&store) == true);
+     const char *exp3[] = {"one", "two", "one"};
+     TEST_ASSERT("restored entries: one, two, one",
+          entriesAre(restored, exp3, 3));
+     TEST_ASSERT("read position at newest entry after restore",
+          restored.seek_forward() == true && restored.seek_forward() == true &&
+          restored.seek_forward() == false);
+
+     FMT_PRINT(ioStream, "[4] Compaction when the log is full\n");
+     /* 128 bytes of log, 10 bytes per entry: compaction after 12 entries,
+      * the ring holds 6 entries (8 index slots, 64 bytes). */
+     history.clear();
+     for (int i = 0; i < 30; i++) {
+          snprintf(buf, sizeof(buf), "entry_%03d", i);
+          history.append(buf, 9);
+     }
+     TEST_ASSERT("log has been compacted",
+          history.get_compactions() > 0);
+     TEST_ASSERT("log size <= capacity",
+          store.size() <= store.capacity());
+     restored.begin(&store);
+     const char *exp4[] = {"entry_029", "entry_028", "entry_027", 
+          "entry_026", "entry_025", "entry_024"};
+     TEST_ASSERT("restored ring equals live ring",
+          entriesAre(restored, exp4, 6) && entriesAre(history, exp4, 6));
+
+     FMT_PRINT(ioStream, "[5] Record cut by a reset is dropped\n");
+     history.clear();
+     history.append("good", 4);
+     store.append("cut", 3);
+     restored.begin(&store);
+     const char *exp5[] = {"good"};
+     TEST_ASSERT("only \"good\" restored",
+          entriesAre(restored, exp5, 1));
+     TEST_ASSERT("fragment removed from the log",
+          store.size() == 5);
+     restored.append("next", 4);
+     restored.begin(&store);
+     const char *exp5b[] = {"next", "good"};
+     TEST_ASSERT("entry after the fragment restored intact",
+          entriesAre(restored, exp5b, 2));
+
+     FMT_PRINT(ioStream, "[6] Failed compaction keeps the log\n");
+     static char failMem[40];
+     static char failSpare[40];
+     FailingRewriteStore failing(failMem, sizeof(failMem), failSpare);
+     history.begin(&failing);
+     for (int i = 0; i < 6; i++) {
+          snprintf(buf, sizeof(buf), "cmd_%d", i);
+          history.append(buf, 5);
+     }
+     TEST_ASSERT("log full",
+          failing.size() == 36);
+     TEST_ASSERT("compaction fails",
+          history.append("cmd_6", 5) == false);
+     restored.begin(&failing);
+     const char *exp6[] = {"cmd_5", "cmd_4", "cmd_3", "cmd_2", "cmd_1", 
+          "cmd_0"};
+     TEST_ASSERT("old log restored",
+          entriesAre(restored, exp6, 6));
+
+#ifdef ARDUINO_ARCH_NATIVE
+     FMT_PRINT(ioStream, "[7] Plain file as backing store\n");
+     const char *path = "/tmp/clidemo-historylog-test.log";
+     remove(path);
+     HistoryFileStore file(path, 256);
+     TEST_ASSERT("begin(file) -> true",
+          history.begin(&file) == true);
+     history.append("ver", 3);
+     history.append("info", 4);
+     TEST_ASSERT("file size == 9",
+          file.size() == 9);
+     HistoryFileStore reopened(path, 256);
+     restored.begin(&reopened);
+     const char *exp7[] = {"info", "ver"};
+     TEST_ASSERT("restored from file: info, ver",
+          entriesAre(restored, exp7, 2));
+     TEST_ASSERT("compaction replaces the file",
+          history.compact() == true && file.size() == 9);
+     HistoryFileStore compacted(path, 256);
+     restored.begin(&compacted);
+     TEST_ASSERT("restored after compaction: info, ver",
+          entriesAre(restored, exp7, 2));
+     remove(path);
+#endif
+}
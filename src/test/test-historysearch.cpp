@@ -0,0 +1,170 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "historysearch.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef HistoryRing<128, 8> SearchRing;
+
+/**
+ * @brief Reads everything the Cli would get from the given stream.
+ */
+static size_t drain(Stream& in, char *buf, size_t siz) {
+     size_t n = 0;
+
+     while (in.available() > 0 && n + 1 < siz) {
+          buf[n++] = (char) in.read();
+     }
+     buf[n] = '\0';
+
+     return n;
+}
+
+/**
+ * @brief A job reading its input up to a '.', like a pasted script.
+ */
+static int8_t readJob(Stream &ioStream, uint32_t step, void *pArg) {
+     int c = 0;
+
+     while ((c = ioStream.read()) >= 0) {
+          if (c == '.') {
+               return 0;
+          }
+     }
+
+     return step == CMDJOB_CANCEL ? 0 : CMDJOB_MORE;
+}
+
+/**
+ * @brief Tests the incremental reverse search and the Ctrl-R input stream.
+ */
+UNITTEST_DECL(historysearch) {
+     SearchRing history;
+     HistorySearch<SearchRing> search(history);
+     char buf[64];
+
+     history.append("led 1", 5);        /* 0 */
+     history.append("info", 4);         /* 1 */
+     history.append("led b", 5);        /* 2 */
+     history.append("list", 4);         /* 3 */
+     history.append("telnet info", 11); /* 4 */
+
+     FMT_PRINT(ioStream, "\n[1] Empty pattern matches the newest entry\n");
+     search.begin();
+     TEST_ASSERT_EQUAL_INT(4, search.getHit());
+
+     FMT_PRINT(ioStream, "[2] Each key continues from the current hit\n");
+     TEST_ASSERT("add('l') -> \"telnet info\" (4)",
+          search.add('l') && search.getHit() == 4);
+     TEST_ASSERT("add('i') -> \"list\" (3)",
+          search.add('i') && search.getHit() == 3);
+     search.remove();
+     TEST_ASSERT("remove() -> back to \"telnet info\" (4)",
+          search.getHit() == 4);
+     TEST_ASSERT("add('e') -> \"led b\" (2)",
+          search.add('e') && search.getHit() == 2);
+     TEST_ASSERT("add('d') -> \"led b\" (2), no rescan needed",
+          search.add('d') && search.getHit() == 2);
+
+     FMT_PRINT(ioStream, "[3] Ctrl-R again finds older matches\n");
+     TEST_ASSERT("next() -> \"led 1\" (0)",
+          search.next() && search.getHit() == 0);
+     TEST_ASSERT("next() at oldest match -> false, hit kept",
+          !search.next() && search.getHit() == 0);
+
+     FMT_PRINT(ioStream, "[4] No match\n");
+     TEST_ASSERT("add('x') -> false", 
+          search.add('x') == false);
+     TEST_ASSERT_EQUAL_INT(-1, search.getHit());
+     search.remove();
+     TEST_ASSERT("remove() -> match is back",
+          search.getHit() == 0);
+
+     FMT_PRINT(ioStream, "[5] Match across the ring buffer boundary\n");
+     SearchRing wrapped;
+     memset(buf, 'a', 60); buf[60] = '\0';
+     wrapped.append(buf, 60);
+     wrapped.append(buf + 1, 59);
+     wrapped.append("xyz wrapped", 11); /* written across position 127 -> 0 */
+     TEST_ASSERT("find_backward(\"wrap\") -> 1 (after eviction)",
+          wrapped.get_count() == 2 &&
+          wrapped.find_backward("wrap", 4, wrapped.get_count() - 1) == 1);
+
+     FMT_PRINT(ioStream, "[6] SearchStream passes keys and records lines\n");
+     TestStream term;
+     SearchRing streamHistory;
+     SearchStream<SearchRing> input(term, streamHistory);
+     term.setScript("ver\r" "info\r" "led b\r");
+     drain(input, buf, sizeof(buf));
+     TEST_ASSERT_EQUAL_STRING("ver\rinfo\rled b\r", buf);
+     TEST_ASSERT_EQUAL_INT(3, streamHistory.get_count());
+
+     FMT_PRINT(ioStream, "[7] Ctrl-R, pattern and Enter executes the match\n");
+     term.setScript("\x12" "in" "\r");
+     drain(input, buf, sizeof(buf));
+     TEST_ASSERT_EQUAL_STRING("info\r", buf);
+     TEST_ASSERT("match shown while searching",
+          strstr(term.output(), "(reverse-i-search)`in': info") != nullptr);
+     TEST_ASSERT("accepted line is recorded as newest entry",
+          streamHistory.read(buf, sizeof(buf)) == 4 && strcmp(buf, "info") == 0);
+
+     FMT_PRINT(ioStream, "[8] ESC puts the match on the line, arrow key swallowed\n");
+     term.setScript("\x12" "ver" "\033[A");
+     drain(input, buf, sizeof(buf));
+     TEST_ASSERT_EQUAL_STRING("ver", buf);
+     term.setScript("\r");
+     drain(input, buf, sizeof(buf));
+
+     FMT_PRINT(ioStream, "[9] Ctrl-G cancels, failed search is shown\n");
+     term.setScript("\x12" "zz" "\x07");
+     drain(input, buf, sizeof(buf));
+     TEST_ASSERT_EQUAL_STRING("", buf);
+     TEST_ASSERT("failed search shown",
+          strstr(term.output(), "(failed reverse-i-search)`zz': ") != nullptr);
+     TEST_ASSERT_FALSE(input.isSearching());
+
+     FMT_PRINT(ioStream, "[10] Ctrl-R is passed on within a line\n");
+     term.setScript("ab\x12");
+     drain(input, buf, sizeof(buf));
+     TEST_ASSERT_EQUAL_STRING("ab\x12", buf);
+     TEST_ASSERT_FALSE(input.isSearching());
+     term.setScript("\r");
+     drain(input, buf, sizeof(buf));
+
+     FMT_PRINT(ioStream, "[11] Lines read by a job are not recorded\n");
+     CmdJob job(input);
+     size_t cnt = streamHistory.get_count();
+     input.setJob(job);
+     term.setScript("ver\r" "info\r");
+     CmdJob::start(job, readJob, nullptr, true);
+     TEST_ASSERT_TRUE(job.isBusy());
+     term.setScript("list\r" ".");
+     job.available();
+     TEST_ASSERT_FALSE(job.isBusy());
+     TEST_ASSERT_EQUAL_INT(cnt, streamHistory.get_count());
+     term.setScript("ver\r");
+     drain(job, buf, sizeof(buf));
+     TEST_ASSERT_EQUAL_INT(cnt + 1, streamHistory.get_count());
+}
@@ -0,0 +1,72 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+
+#include "unit-test.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Tests the parts of the test runner, glob patterns and the report of
+ * failed assertions.
+ */
+UNITTEST_DECL(runner) {
+     TestStream io;
+
+     FMT_PRINT(ioStream, "\n[1] Glob patterns\n");
+     TEST_ASSERT_TRUE(unittestMatch("history", "history"));
+     TEST_ASSERT_FALSE(unittestMatch("history", "historyidx"));
+     TEST_ASSERT_TRUE(unittestMatch("history*", "historyidx"));
+     TEST_ASSERT_TRUE(unittestMatch("history*", "history"));
+     TEST_ASSERT_TRUE(unittestMatch("*", "cmdjob"));
+     TEST_ASSERT_TRUE(unittestMatch("*", ""));
+     TEST_ASSERT_TRUE(unittestMatch("cmd*b", "cmdjob"));
+     TEST_ASSERT_TRUE(unittestMatch("cmd*b", "cmdbatch_b"));
+     TEST_ASSERT_FALSE(unittestMatch("cmd*b", "cmdbatch"));
+     TEST_ASSERT_TRUE(unittestMatch("*log", "historylog"));
+     TEST_ASSERT_TRUE(unittestMatch("?ormat", "format"));
+     TEST_ASSERT_FALSE(unittestMatch("?format", "format"));
+     TEST_ASSERT_TRUE(unittestMatch("*s*s*", "historysearch"));
+     TEST_ASSERT_FALSE(unittestMatch("", "format"));
+
+     FMT_PRINT(ioStream, "\n[2] Verbose report\n");
+     TestRun inner;
+     inner.do_assert(io, "good", true);
+     inner.do_assert(io, "bad", false);
+     TEST_ASSERT_EQUAL_STRING("  PASS: good\n  FAIL: bad\n", io.output());
+     TEST_ASSERT_EQUAL_INT(1, inner.getPassed());
+     TEST_ASSERT_EQUAL_INT(1, inner.getFailed());
+
+     FMT_PRINT(ioStream, "\n[3] Failures only\n");
+     TestStream report;
+     io.clearOutput();
+     inner.reset();
+     inner.setReport(&report, "# FAIL: t: ");
+     inner.do_assert(io, "good", true);
+     inner.do_assert(io, "bad", false);
+     TEST_ASSERT_EQUAL_INT(0, io.outputLength());
+     TEST_ASSERT_EQUAL_STRING("# FAIL: t: bad\n", report.output());
+     TEST_ASSERT_EQUAL_INT(1, inner.getPassed());
+     TEST_ASSERT_EQUAL_INT(1, inner.getFailed());
+     inner.setReport(nullptr, "");
+     inner.do_assert(io, "good", true);
+     TEST_ASSERT_EQUAL_STRING("  PASS: good\n", io.output());
+}
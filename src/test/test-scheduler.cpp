@@ -0,0 +1,111 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "scheduler.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Records the runs of the test jobs.
+ */
+static uint32_t schedRuns[3];
+static uint32_t schedLast[3];
+static char schedOrder[16];
+static size_t schedOrderLen;
+
+static void schedRecord(size_t i, uint32_t now) {
+    schedRuns[i]++;
+    schedLast[i] = now;
+    if (schedOrderLen + 1 < sizeof(schedOrder)) {
+        schedOrder[schedOrderLen++] = (char) ('a' + i);
+        schedOrder[schedOrderLen] = 0;
+    }
+}
+
+static void schedJobA(uint32_t now) { schedRecord(0, now); }
+static void schedJobB(uint32_t now) { schedRecord(1, now); }
+static void schedJobC(uint32_t now) { schedRecord(2, now); }
+
+/**
+ * @brief Tests the heap based scheduler with a simulated clock.
+ */
+UNITTEST_DECL(scheduler) {
+     Scheduler<3> sched;
+     uint32_t start = 0xFFFFFF00UL;
+     size_t runs = 0;
+
+     memset(schedRuns, 0, sizeof(schedRuns));
+     schedOrderLen = 0;
+     schedOrder[0] = 0;
+
+     FMT_PRINT(ioStream, "\n[1] Adding jobs\n");
+     TEST_ASSERT_EQUAL_INT(UINT32_MAX, sched.getNext(start));
+     TEST_ASSERT_EQUAL_INT(0, sched.add(schedJobA, 30, start));
+     TEST_ASSERT_EQUAL_INT(1, sched.add(schedJobB, 10, start));
+     TEST_ASSERT_EQUAL_INT(2, sched.add(schedJobC, 25, start));
+     TEST_ASSERT_EQUAL_INT(-1, sched.add(schedJobC, 5, start));
+     TEST_ASSERT_EQUAL_INT(3, sched.getCount());
+     TEST_ASSERT_EQUAL_INT(10, sched.getNext(start));
+
+     FMT_PRINT(ioStream, "[2] Only due jobs run, in deadline order\n");
+     TEST_ASSERT_EQUAL_INT(0, sched.loop(start + 9));
+     TEST_ASSERT_EQUAL_INT(1, sched.loop(start + 10));
+     TEST_ASSERT_EQUAL_INT(10, sched.getNext(start + 10));
+     for (uint32_t t = 11; t <= 60; t++) {
+          runs += sched.loop(start + t);
+     }
+     TEST_ASSERT("runs in deadline order", strncmp(schedOrder, "bbc", 3) == 0);
+     TEST_ASSERT_EQUAL_INT(9, runs);
+     TEST_ASSERT("runs match the periods across the wrap of the clock",
+          schedRuns[0] == 2 && schedRuns[1] == 6 && schedRuns[2] == 2);
+     TEST_ASSERT_EQUAL_INT(start + 60, schedLast[0]);
+
+     FMT_PRINT(ioStream, "[3] Late jobs keep their phase, missed runs are skipped\n");
+     TEST_ASSERT_EQUAL_INT(3, sched.loop(start + 95));
+     TEST_ASSERT_EQUAL_INT(5, sched.getNext(start + 95));
+     TEST_ASSERT_EQUAL_INT(1, sched.loop(start + 100));
+     TEST_ASSERT_EQUAL_INT(start + 100, schedLast[2]);
+     TEST_ASSERT_EQUAL_INT(start + 95, schedLast[1]);
+     TEST_ASSERT_EQUAL_INT(0, sched.getNext(start + 200));
+
+     FMT_PRINT(ioStream, "[4] A job exactly one period late runs once\n");
+     Scheduler<1> once;
+     once.add(schedJobA, 10, start);
+     TEST_ASSERT_EQUAL_INT(1, once.loop(start + 20));
+     TEST_ASSERT_EQUAL_INT(10, once.getNext(start + 20));
+
+#if SCHEDULER_STATS
+     FMT_PRINT(ioStream, "[5] Statistics\n");
+     const schedStats_t &stats = sched.getStats(1);
+     TEST_ASSERT_EQUAL_INT(schedRuns[1], stats.runs);
+     TEST_ASSERT_EQUAL_INT(25, stats.maxLateMs);
+     TEST_ASSERT_EQUAL_INT(25, stats.lateMs);
+     TEST_ASSERT("histogram counts every run", stats.hist[0] + stats.hist[1] 
+          + stats.hist[2] + stats.hist[3] + stats.hist[4] == stats.runs);
+     TEST_ASSERT("max covers last", stats.maxUs >= stats.lastUs);
+     sched.resetStats();
+     TEST_ASSERT_EQUAL_INT(0, sched.getStats(1).runs);
+     TEST_ASSERT_EQUAL_INT(0, sched.getStats(1).maxLateMs);
+#endif
+}
@@ -0,0 +1,124 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "telnetstream.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Reads everything the telnet stream passes on to its reader.
+ */
+static size_t readAll(TelnetStream &telnet, char *buf, size_t siz) {
+    size_t n = 0;
+
+    while (telnet.available() > 0 && n + 1 < siz) {
+        int c = telnet.read();
+        if (c >= 0) {
+            buf[n++] = (char) c;
+        }
+    }
+    buf[n] = 0;
+
+    return n;
+}
+
+/**
+ * @brief Tests the telnet option negotiation and the IAC parser.
+ */
+UNITTEST_DECL(telnet) {
+     static const char negotiation[] = 
+          "\xff\xfb\x01\xff\xfd\x03\xff\xfb\x03\xff\xfb\x1f";
+     static const char naws[] = 
+          "ab\xff\xfa\x1f\x00\x84\x00\x28\xff\xf0" "cd";
+     static const char enter[] = "x\r\0y\r\nz\r";
+     static const char escaped[] = "\xff\xff" "1\xff\xf1" "2\xff\xfa\x1f\xff";
+     TestStream client;
+     TelnetStream telnet;
+     char buf[32];
+
+     FMT_PRINT(ioStream, "\n[1] Negotiation\n");
+     client.setScript("");
+     telnet.begin(client);
+     TEST_ASSERT("asks for ECHO, SGA and NAWS", client.outputLength() == 12 &&
+          memcmp(client.output(), 
+               "\xff\xfb\x01\xff\xfb\x03\xff\xfd\x03\xff\xfd\x1f", 12) == 0);
+     TEST_ASSERT_EQUAL_INT(CLI_TERMINAL_WIDTH, telnet.getWidth());
+
+     client.setScript(negotiation, sizeof(negotiation) - 1);
+     TEST_ASSERT_EQUAL_INT(0, readAll(telnet, buf, sizeof(buf)));
+     TEST_ASSERT("refuses WILL ECHO of the client", 
+          client.outputLength() == 3 && 
+          memcmp(client.output(), "\xff\xfe\x01", 3) == 0);
+
+     FMT_PRINT(ioStream, "[2] Client refuses the server echo\n");
+     client.setScript("\xff\xfd\x01");
+     readAll(telnet, buf, sizeof(buf));
+     TEST_ASSERT("DO ECHO confirms, no answer", client.outputLength() == 0);
+     TEST_ASSERT_TRUE(telnet.getEcho());
+     TEST_ASSERT_FALSE(telnet.echoChanged());
+     client.setScript("\xff\xfe\x01");
+     readAll(telnet, buf, sizeof(buf));
+     TEST_ASSERT("DONT ECHO answered by WONT ECHO", 
+          client.outputLength() == 3 && 
+          memcmp(client.output(), "\xff\xfc\x01", 3) == 0);
+     TEST_ASSERT_FALSE(telnet.getEcho());
+     TEST_ASSERT_TRUE(telnet.echoChanged());
+     TEST_ASSERT_FALSE(telnet.echoChanged());
+     client.setScript("\xff\xfe\x01");
+     readAll(telnet, buf, sizeof(buf));
+     TEST_ASSERT("repeated DONT ECHO not answered", client.outputLength() == 0);
+     client.setScript("\xff\xfd\x01");
+     readAll(telnet, buf, sizeof(buf));
+     TEST_ASSERT("DO ECHO answered by WILL ECHO", 
+          client.outputLength() == 3 && 
+          memcmp(client.output(), "\xff\xfb\x01", 3) == 0);
+     TEST_ASSERT_TRUE(telnet.getEcho());
+     TEST_ASSERT_TRUE(telnet.echoChanged());
+
+     FMT_PRINT(ioStream, "[3] Window size\n");
+     client.setScript(naws, sizeof(naws) - 1);
+     TEST_ASSERT_EQUAL_INT(4, readAll(telnet, buf, sizeof(buf)));
+     TEST_ASSERT_EQUAL_STRING("abcd", buf);
+     TEST_ASSERT_EQUAL_INT(132, telnet.getWidth());
+     TEST_ASSERT_EQUAL_INT(40, telnet.getHeight());
+
+     FMT_PRINT(ioStream, "[4] Enter is seen once\n");
+     client.setScript(enter, sizeof(enter) - 1);
+     TEST_ASSERT_EQUAL_INT(6, readAll(telnet, buf, sizeof(buf)));
+     TEST_ASSERT_EQUAL_STRING("x\ry\rz\r", buf);
+
+     FMT_PRINT(ioStream, "[5] Escaped IAC and split sequences\n");
+     client.setScript(escaped, sizeof(escaped) - 1);
+     TEST_ASSERT_EQUAL_INT(3, readAll(telnet, buf, sizeof(buf)));
+     TEST_ASSERT_EQUAL_STRING("\xff" "12", buf);
+     client.setScript("\xf0" "3");
+     TEST_ASSERT_EQUAL_INT(1, readAll(telnet, buf, sizeof(buf)));
+     TEST_ASSERT_EQUAL_STRING("3", buf);
+
+     FMT_PRINT(ioStream, "[6] Output\n");
+     client.clearOutput();
+     telnet.print("plain");
+     telnet.write((const uint8_t*) "a\xff" "b", 3);
+     TEST_ASSERT_EQUAL_STRING("plaina\xff\xff" "b", client.output());
+}
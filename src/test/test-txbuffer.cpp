@@ -0,0 +1,112 @@
+/*
+ * clidemo, a example and test bench for my command line library libcli.
+ *
+ * Copyright (C) 2026 Julian Friedrich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+#include <cli/cli.hpp>
+
+#include "unit-test.hpp"
+#include "txbuffer.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief A sink taking at most limit bytes per write, like a WiFiClient with
+ * a full send buffer.
+ */
+class PartialSink : public TestStream {
+     public:
+          PartialSink() : limit(0) {}
+
+          size_t write(const uint8_t *buffer, size_t size) override {
+               return TestStream::write(buffer, size < limit ? size : limit);
+          }
+
+          using Print::write;
+
+          size_t limit;
+};
+
+/**
+ * @brief Tests the buffered transmit stream.
+ */
+UNITTEST_DECL(txbuffer) {
+     TestStream sink;
+     BufferedStream<16> out(sink);
+
+     sink.setScript("x");
+
+     FMT_PRINT(ioStream, "\n[1] Output is collected\n");
+     out.printf("abc");
+     out.print("def");
+     out.write('g');
+     TEST_ASSERT("nothing written to the sink yet",
+          sink.outputLength() == 0 && sink.getWriteCalls() == 0);
+     TEST_ASSERT_EQUAL_INT(7, out.pending());
+
+     FMT_PRINT(ioStream, "[2] Polling for input flushes in one write\n");
+     TEST_ASSERT_EQUAL_INT(1, out.available());
+     TEST_ASSERT_EQUAL_STRING("abcdefg", sink.output());
+     TEST_ASSERT_EQUAL_INT(1, sink.getWriteCalls());
+     TEST_ASSERT_EQUAL_INT(0, out.pending());
+
+     FMT_PRINT(ioStream, "[3] Full buffer is flushed\n");
+     sink.clearOutput();
+     out.print("0123456789");
+     out.print("ABCDEFGHIJ");
+     TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", sink.output());
+     TEST_ASSERT_EQUAL_INT(1, sink.getWriteCalls());
+     TEST_ASSERT_EQUAL_INT(4, out.pending());
+
+     FMT_PRINT(ioStream, "[4] Large block goes out right after pending data\n");
+     sink.clearOutput();
+     out.print("0123456789abcdefXYZ");
+     TEST_ASSERT_EQUAL_STRING("GHIJ0123456789abcdefXYZ", sink.output());
+     TEST_ASSERT_EQUAL_INT(2, sink.getWriteCalls());
+
+     FMT_PRINT(ioStream, "[5] read() and flush() flush as well\n");
+     sink.clearOutput();
+     out.print("r");
+     TEST_ASSERT("read() returns input and flushes",
+          out.read() == 'x' && strcmp(sink.output(), "r") == 0);
+     out.print("f");
+     out.flush();
+     TEST_ASSERT_EQUAL_STRING("rf", sink.output());
+
+     FMT_PRINT(ioStream, "[6] Output not taken by the stream is kept\n");
+     PartialSink slow;
+     BufferedStream<8> part(slow);
+     slow.limit = 3;
+     part.print("01234");
+     TEST_ASSERT_EQUAL_INT(3, part.print("567"));
+     TEST_ASSERT_EQUAL_STRING("012345", slow.output());
+     TEST_ASSERT_EQUAL_INT(2, part.pending());
+     slow.limit = 0;
+     TEST_ASSERT_EQUAL_INT(2, part.print("AB"));
+     TEST_ASSERT_EQUAL_INT(4, part.print("CDEF"));
+     TEST_ASSERT_EQUAL_INT(0, part.print("GH"));
+     TEST_ASSERT_EQUAL_INT(0, part.write('I'));
+     TEST_ASSERT_EQUAL_INT(8, part.pending());
+     slow.limit = 3;
+     part.poll();
+     TEST_ASSERT_EQUAL_STRING("01234567A", slow.output());
+     part.flush();
+     TEST_ASSERT_EQUAL_STRING("01234567ABCDEF", slow.output());
+     TEST_ASSERT_EQUAL_INT(0, part.pending());
+}
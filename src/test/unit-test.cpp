@@ -19,12 +19,37 @@
 
 #include "unit-test.hpp"
 #include <cli/cli.hpp>
+#include "cmdindex.hpp"
+#include "cmdstats.hpp"
+#include "cmdjob.hpp"
+#include "cmdhelp.hpp"
 
 /** 
  * Use UNITTEST_DECL(_name_) to declare all test functions, then add them to the 
  * unittestTab with UNITTEST(_name_).
  */
 UNITTEST_DECL(history);
+UNITTEST_DECL(historyidx);
+UNITTEST_DECL(historylog);
+UNITTEST_DECL(historysearch);
+UNITTEST_DECL(historycompact);
+UNITTEST_DECL(txbuffer);
+UNITTEST_DECL(cmdindex);
+UNITTEST_DECL(format);
+UNITTEST_DECL(telnet);
+UNITTEST_DECL(scheduler);
+UNITTEST_DECL(corelink);
+UNITTEST_DECL(cmdjob);
+UNITTEST_DECL(cmdbatch);
+UNITTEST_DECL(cmdpipe);
+UNITTEST_DECL(cmdrpc);
+UNITTEST_DECL(cmdtoken);
+UNITTEST_DECL(cmdschema);
+UNITTEST_DECL(cmdhelp);
+UNITTEST_DECL(runner);
+#if CMDSTATS
+UNITTEST_DECL(cmdstats);
+#endif
 
 /**
  * A table is used to store the test name and the corresponding function pointer 
@@ -32,51 +57,293 @@ UNITTEST_DECL(history);
  */
 unittest_t unittestTab[] = {
     UNITTEST(history),
+    UNITTEST(historyidx),
+    UNITTEST(historylog),
+    UNITTEST(historysearch),
+    UNITTEST(historycompact),
+    UNITTEST(txbuffer),
+    UNITTEST(cmdindex),
+    UNITTEST(format),
+    UNITTEST(telnet),
+    UNITTEST(scheduler),
+    UNITTEST(corelink),
+    UNITTEST(cmdjob),
+    UNITTEST(cmdbatch),
+    UNITTEST(cmdpipe),
+    UNITTEST(cmdrpc),
+    UNITTEST(cmdtoken),
+    UNITTEST(cmdschema),
+    UNITTEST(cmdhelp),
+    UNITTEST(runner),
+#if CMDSTATS
+    UNITTEST(cmdstats),
+#endif
     {0, 0}
 };
 
+/**
+ * @brief The output of a test run.
+ */
+typedef enum {
+    TEST_VERBOSE,   /**< Every assertion, the time of each test. */
+    TEST_QUIET,     /**< Failed assertions and the result only. */
+    TEST_TAP        /**< Test Anything Protocol, one line per test. */
+} testMode_t;
+
+/**
+ * @brief A Stream discarding the output of the tests in quiet and TAP mode, 
+ * so that the UART is not part of the measured time.
+ */
+class TestNullStream : public Stream {
+    public:
+        int available() override { 
+            return 0; 
+        }
+
+        int read() override { 
+            return -1; 
+        }
+
+        int peek() override { 
+            return -1; 
+        }
+
+        size_t write(uint8_t c) override { 
+            return 1; 
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) override { 
+            return size; 
+        }
+
+        using Print::write;
+};
+
+/**
+ * @brief The state of the running test command, there is only one at a time.
+ */
+static struct {
+    TestRun run;
+    TestNullStream null;
+    testMode_t mode;
+    bool active;
+    char pattern[24];
+    char lead[40];
+    size_t next;
+    uint32_t number;
+    uint32_t failedTests;
+    uint32_t us;
+    int result;
+} testState;
+
+bool unittestMatch(const char *pPattern, const char *pName) {
+    const char *pStar = nullptr;
+    const char *pResume = nullptr;
+
+    while (*pName != '\0') {
+        if (*pPattern == '*') {
+            pStar = pPattern++;
+            pResume = pName;
+        } else if (*pPattern == '?' || *pPattern == *pName) {
+            pPattern++;
+            pName++;
+        } else if (pStar != nullptr) {
+            pPattern = pStar + 1;
+            pName = ++pResume;
+        } else {
+            return false;
+        }
+    }
+
+    while (*pPattern == '*') {
+        pPattern++;
+    }
+
+    return *pPattern == '\0';
+}
+
+/**
+ * @brief Runs a single test and reports its result and time.
+ */
+static void testRunOne(Stream &ioStream, const unittest_t &test) {
+    TestRun &testRun = testState.run;
+    uint32_t passed = testRun.getPassed();
+    uint32_t failed = testRun.getFailed();
+    uint32_t start = 0;
+    uint32_t us = 0;
+
+    if (testState.mode == TEST_VERBOSE) {
+        FMT_PRINT(ioStream, "=== Running test: %s ===\n", test.name);
+    } else {
+        snprintf(testState.lead, sizeof(testState.lead), "%s%s: ", 
+            testState.mode == TEST_TAP ? "# FAIL: " : "  FAIL: ", test.name);
+        testRun.setReport(&ioStream, testState.lead);
+    }
+
+    start = micros();
+    test.pfunc(testState.mode == TEST_VERBOSE ? ioStream : testState.null, 
+        testRun);
+    us = micros() - start;
+
+    testRun.setReport(nullptr, "");
+    passed = testRun.getPassed() - passed;
+    failed = testRun.getFailed() - failed;
+    testState.us += us;
+    testState.number++;
+    testState.failedTests += failed != 0;
+
+    if (testState.mode == TEST_VERBOSE) {
+        FMT_PRINT(ioStream, "--- %s: %lu passed, %lu failed in %lu us ---\n",
+            test.name, (unsigned long) passed, (unsigned long) failed, 
+            (unsigned long) us);
+    } else if (testState.mode == TEST_TAP) {
+        FMT_PRINT(ioStream, "# %lu passed, %lu failed in %lu us\n", 
+            (unsigned long) passed, (unsigned long) failed, 
+            (unsigned long) us);
+        FMT_PRINT(ioStream, "%sok %lu - %s\n", failed != 0 ? "not " : "", 
+            (unsigned long) testState.number, test.name);
+    }
+}
+
+/**
+ * @brief The steps of a test run, one test per step so that the main loop 
+ * keeps running in between.
+ */
+static int8_t testJob(Stream &ioStream, uint32_t step, void *pArg) {
+    TestRun &testRun = testState.run;
+
+    if (step != CMDJOB_CANCEL) {
+        while (unittestTab[testState.next].name != nullptr) {
+            const unittest_t &test = unittestTab[testState.next++];
+
+            if (unittestMatch(testState.pattern, test.name)) {
+                testRunOne(ioStream, test);
+                return CMDJOB_MORE;
+            }
+        }
+    }
+
+    testState.active = false;
+    testState.result = testRun.getFailed() != 0 || step == CMDJOB_CANCEL;
+
+    if (testState.mode == TEST_TAP) {
+        if (step == CMDJOB_CANCEL) {
+            FMT_PRINT(ioStream, "Bail out! Cancelled\n");
+        }
+        FMT_PRINT(ioStream, "# Result: %lu/%lu passed, %lu/%lu tests failed "
+            "in %lu us\n", (unsigned long) testRun.getPassed(), 
+            (unsigned long) (testRun.getPassed() + testRun.getFailed()),
+            (unsigned long) testState.failedTests, 
+            (unsigned long) testState.number, (unsigned long) testState.us);
+    } else {
+        FMT_PRINT(ioStream, "\nTests: %lu run, %lu failed in %lu us\n", 
+            (unsigned long) testState.number, 
+            (unsigned long) testState.failedTests, 
+            (unsigned long) testState.us);
+        testRun.summary(ioStream);
+    }
+
+    return testState.result != 0 ? -1 : 0;
+}
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+/**
+ * @brief The exit status of the host program, 1 if the last test run failed
+ * or has been cancelled.
+ */
+int hostResult(void) {
+    return testState.result;
+}
+
+#endif
+
 /**
  * The main CLI command for running unit tests.
  * You will not need to touch this, add new tests to the table above and
  * implement them in separate files like src/test/test-history.cpp
+ * @arg   [-q|-t] Print failed assertions only, or TAP, before or after the
+ *                pattern.
+ * @arg   pattern The name of a test, a glob pattern or "all".
  */
 CLI_COMMAND(test){
-    TestRun testRun;
+    testMode_t mode = TEST_VERBOSE;
+    const char *pPattern = nullptr;
+    uint32_t count = 0;
+    size_t patterns = 0;
 
-    CliCommand::exec(ioStream, "info", nullptr, 0);
+    /* Options may come before or after the pattern. */
+    for (size_t i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "-t") == 0) {
+            testMode_t opt = argv[i][1] == 'q' ? TEST_QUIET : TEST_TAP;
 
-    ioStream.printf("Running unit tests ...\n\n");
-    if (argc != 1) {
-        ioStream.printf("Usage: test [testname]\n");
-        ioStream.printf("Available tests:\n");
-        for (size_t i = 0; unittestTab[i].name != nullptr; i++) {
-            ioStream.printf("  %s\n", unittestTab[i].name);
+            if (mode != TEST_VERBOSE && mode != opt) {
+                FMT_PRINT(ioStream, "test: use either -q or -t\n");
+                return -1;
+            }
+            mode = opt;
+        } else if (argv[i][0] == '-') {
+            FMT_PRINT(ioStream, "test: unknown option %s\n", argv[i]);
+            return -1;
+        } else {
+            pPattern = argv[i];
+            patterns++;
         }
+    }
+
+    if (patterns > 1) {
+        FMT_PRINT(ioStream, "test: only one name or pattern\n");
         return -1;
     }
 
-    if (strcmp(argv[0], "all") == 0) {
-        for (size_t i = 0; unittestTab[i].name != nullptr; i++) {
-            ioStream.printf("=== Running test: %s ===\n", unittestTab[i].name);
-            unittestTab[i].pfunc(ioStream, testRun);
+    if (pPattern != nullptr && strcmp(pPattern, "all") == 0) {
+        pPattern = "*";
+    }
+
+    for (size_t i = 0; pPattern != nullptr && unittestTab[i].name != nullptr; 
+        i++) {
+        count += unittestMatch(pPattern, unittestTab[i].name);
+    }
+
+    if (count == 0 || strlen(pPattern) >= sizeof(testState.pattern)) {
+        if (pPattern != nullptr) {
+            FMT_PRINT(ioStream, "No test matches '%s'.\n", pPattern);
         }
-    } else {
-        bool found = false;
+        FMT_PRINT(ioStream, "Usage: test [-q|-t] <name|pattern|all>\n");
+        FMT_PRINT(ioStream, "Available tests:\n");
         for (size_t i = 0; unittestTab[i].name != nullptr; i++) {
-            if (strcmp(argv[0], unittestTab[i].name) == 0) {
-                ioStream.printf("=== Running test: %s ===\n", unittestTab[i].name);
-                unittestTab[i].pfunc(ioStream, testRun);
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            ioStream.printf("Test '%s' not found. Use 'test all' to run all tests.\n", argv[0]);
-            return -1;
+            FMT_PRINT(ioStream, "  %s\n", unittestTab[i].name);
         }
+        return -1;
     }
 
-    testRun.summary(ioStream);
+    if (testState.active) {
+        FMT_PRINT(ioStream, "test: busy\n");
+        return -2;
+    }
+
+    if (mode == TEST_VERBOSE) {
+        CmdIndex::exec(ioStream, "info", nullptr, 0);
+        FMT_PRINT(ioStream, "Running unit tests ...\n\n");
+    } else if (mode == TEST_TAP) {
+        FMT_PRINT(ioStream, "TAP version 13\n1..%lu\n", (unsigned long) count);
+    }
 
-    return 0;
+    testState.run.reset();
+    testState.mode = mode;
+    testState.active = true;
+    strcpy(testState.pattern, pPattern);
+    testState.next = 0;
+    testState.number = 0;
+    testState.failedTests = 0;
+    testState.us = 0;
+
+    return CmdJob::start(ioStream, testJob);
 }
+
+CLI_HELP(test, "Testing/Debug", "[-q|-t] <name|pattern|all>",
+    "Run unit tests, Ctrl-C cancels\n"
+    "  -q       prints failed assertions and the result only\n"
+    "  -t       prints TAP, one line per test\n"
+    "  pattern  selects tests by name, * and ? as wildcards\n"
+    "Without a name the available tests are listed.");
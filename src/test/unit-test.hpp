@@ -24,6 +24,8 @@
 #include <string.h>
 #include <stddef.h>
 
+#include "format.hpp"
+
 /**
  * @brief Use UNITTEST_DECL(_name_) to declare test functions, then add them to 
  * the test suite by adding them to the test tablr using UNITTEST(_name_).
@@ -41,7 +43,7 @@
  */
 class TestRun {
     public:
-        TestRun() : passed(0), failed(0) {}
+        TestRun() : passed(0), failed(0), pReport(nullptr), pLead("") {}
 
         void pass() { 
             passed++; 
@@ -56,12 +58,28 @@ class TestRun {
             failed = 0; 
         }
 
+        /**
+         * @brief Reports failed assertions only, to the given stream and led 
+         * by the given text, instead of all assertions to the stream of the 
+         * test. nullptr reports all assertions again.
+         */
+        void setReport(Print *pReport, const char *pLead) {
+            this->pReport = pReport;
+            this->pLead = pLead;
+        }
+
         void do_assert(Stream& ioStream,const char* name, bool condition) {
             if (condition) {
-                ioStream.printf("  PASS: %s\n", name);
+                if (pReport == nullptr) {
+                    FMT_PRINT(ioStream, "  PASS: %s\n", name);
+                }
                 pass();
             } else {
-                ioStream.printf("  FAIL: %s\n", name);
+                if (pReport == nullptr) {
+                    FMT_PRINT(ioStream, "  FAIL: %s\n", name);
+                } else {
+                    FMT_PRINT(*pReport, "%s%s\n", pLead, name);
+                }
                 fail();
             }
         }
@@ -76,13 +94,112 @@ class TestRun {
 
         void summary(Stream& ioStream) const {
             uint32_t total = passed + failed;
-            ioStream.printf("\nResult: %d/%d passed%s\n\n", passed, total,
+            FMT_PRINT(ioStream, "\nResult: %lu/%lu passed%s\n\n",
+                (unsigned long) passed, (unsigned long) total,
                 failed == 0 ? " -- all good!" : " -- FAILURES detected!");
         }
 
     private:
         uint32_t passed;
         uint32_t failed;
+        Print *pReport;
+        const char *pLead;
+};
+
+/**
+ * @brief A Stream for tests which feeds a script to its reader and captures
+ * everything written to it in a fixed buffer.
+ */
+class TestStream : public Stream {
+    public:
+        TestStream() : pScript(nullptr), len(0), pos(0), outLen(0),
+            writeCalls(0) {
+            out[0] = '\0';
+        }
+
+        /**
+         * @brief Sets the input of the stream and clears the output.
+         */
+        void setScript(const char *script, size_t len) {
+            pScript = script;
+            this->len = len;
+            pos = 0;
+            clearOutput();
+        }
+
+        void setScript(const char *script) {
+            setScript(script, strlen(script));
+        }
+
+        void clearOutput() {
+            outLen = 0;
+            out[0] = '\0';
+            writeCalls = 0;
+        }
+
+        int available() override { 
+            return (int)(len - pos); 
+        }
+
+        int read() override { 
+            return pos < len ? (uint8_t) pScript[pos++] : -1; 
+        }
+
+        int peek() override { 
+            return pos < len ? (uint8_t) pScript[pos] : -1; 
+        }
+
+        size_t write(uint8_t c) override {
+            writeCalls++;
+            return put(c);
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) override {
+            size_t n = 0;
+
+            writeCalls++;
+            while (n < size && put(buffer[n])) {
+                n++;
+            }
+            return n;
+        }
+
+        using Print::write;
+
+        /**
+         * @brief Returns the captured output as NUL terminated string.
+         */
+        const char *output() const { 
+            return out; 
+        }
+
+        size_t outputLength() const { 
+            return outLen; 
+        }
+
+        /**
+         * @brief Returns the number of write calls since clearOutput().
+         */
+        uint32_t getWriteCalls() const { 
+            return writeCalls; 
+        }
+
+    private:
+        size_t put(uint8_t c) {
+            if (outLen + 1 >= sizeof(out)) {
+                return 0;
+            }
+            out[outLen++] = (char) c;
+            out[outLen] = '\0';
+            return 1;
+        }
+
+        const char *pScript;
+        size_t len;
+        size_t pos;
+        char out[512];
+        size_t outLen;
+        uint32_t writeCalls;
 };
 
 /**
@@ -103,6 +220,12 @@ typedef struct {
 
 } unittest_t;
 
+/**
+ * @brief Matches a test name against a glob pattern, '*' matches any number 
+ * of characters, '?' exactly one.
+ */
+bool unittestMatch(const char *pPattern, const char *pName);
+
 // ---------------------------------------------------------------------------
 // Test macros
 // ---------------------------------------------------------------------------
@@ -110,7 +233,7 @@ typedef struct {
 /**
  * @brief Print a section header to visually group related assertions.
  */
-#define TEST_SECTION(name)  ioStream.printf("\n[" name "]\n")
+#define TEST_SECTION(name)  FMT_PRINT(ioStream, "\n[" name "]\n")
 
 // ---------------------------------------------------------------------------
 // Core — named free-form assertion